@@ -0,0 +1,458 @@
+// THIS FILE IS PART OF MJava-Compiler PROJECT
+// compilerbench.cpp - throughput of every phase over generated MJava sources
+
+// Created by Li Taiji 2026-10-17
+// Copyright (c) 2026 Li Taiji All rights reserved
+
+#include "astvisitor.h"
+#include "jsonwriter.h"
+#include "parser.h"
+#include "scanner.h"
+#include "statistics.h"
+#include "tokenbuffer.h"
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <streambuf>
+#include <string>
+#include <vector>
+
+#if !defined(_WIN32)
+    #include <sys/resource.h>
+#endif
+
+namespace
+{
+    // the shape of a generated program. a program is the main class and as
+    // many classes like this as it takes to reach the size asked for.
+    struct Shape
+    {
+        const char*     name;
+        int             methods;
+        int             statements;
+        // nesting of the parentheses in every assignment.
+        int             depth;
+        // comment lines before every statement.
+        int             comments;
+        // characters of the string literals.
+        int             literalLength;
+    };
+
+    const Shape SHAPES[] =
+    {
+        {"mixed",       4,      8,      3,      1,      16},
+        {"classes",     1,      2,      1,      0,      8},
+        {"deep",        2,      4,      40,     0,      8},
+        {"long",        1,      400,    2,      0,      8},
+        {"comments",    2,      8,      2,      6,      8},
+        {"literals",    2,      8,      1,      0,      400},
+    };
+
+    void appendExpression(std::string& out, int depth, int index)
+    {
+        if (depth == 0)
+        {
+            const char* leaves[] = {"p", "x", "y", "17"};
+            out += leaves[index % 4];
+            return;
+        }
+
+        const char* operators[] = {" + ", " - ", " * "};
+        out += '(';
+        appendExpression(out, depth - 1, index + 1);
+        out += operators[index % 3];
+        out += std::to_string(index % 97);
+        out += ')';
+    }
+
+    void appendStatement(std::string& out, const Shape& shape, int method, int index)
+    {
+        for (int i = 0; i < shape.comments; i++)
+        {
+            out += i % 3 == 2 ? "        /* block comment " + std::to_string(i) + " of statement " + std::to_string(index) + " */\n"
+                              : "        // comment " + std::to_string(i) + " of statement " + std::to_string(index) + "\n";
+        }
+
+        switch (index % 6)
+        {
+            case 0:
+                out += "        y = ";
+                appendExpression(out, shape.depth, index);
+                out += ";\n";
+                break;
+
+            case 1:
+                out += "        s = \"";
+                for (int i = 0; i < shape.literalLength; i++)
+                {
+                    out += static_cast<char>('a' + (i + index) % 26);
+                }
+                out += "\";\n";
+                break;
+
+            case 2:
+                out += "        if (y < " + std::to_string(index) + " && !q) y = y + 1; else y = y - 0x1F;\n";
+                break;
+
+            case 3:
+                out += "        while (y < 100) { y = y + this.m" + std::to_string(method) + "(y, true); arr[y] = arr.length; }\n";
+                break;
+
+            case 4:
+                out += "        d = " + std::to_string(index) + ".125e3;\n";
+                break;
+
+            default:
+                out += "        System.out.println(y);\n";
+                break;
+        }
+    }
+
+    // a program of about size bytes which parses without errors.
+    std::string generate(const Shape& shape, std::size_t size)
+    {
+        std::string out = "class Main { public static void main(String[] a) { System.out.println(1); } }\n";
+
+        for (int index = 0; out.size() < size; index++)
+        {
+            out += "\nclass C" + std::to_string(index);
+            out += index > 0 ? " extends C" + std::to_string(index - 1) + " {\n" : std::string(" {\n");
+            out += "    int x;\n    int[] arr;\n\n";
+
+            for (int method = 0; method < shape.methods; method++)
+            {
+                out += "    public int m" + std::to_string(method) + "(int p, boolean q) {\n";
+                out += "        int y;\n        String s;\n        double d;\n";
+
+                for (int statement = 0; statement < shape.statements; statement++)
+                {
+                    appendStatement(out, shape, method, statement);
+                }
+
+                out += "        return y;\n    }\n\n";
+            }
+
+            out += "}\n";
+        }
+
+        return out;
+    }
+
+    // a stream which only counts the bytes written to it.
+    class CountingBuffer : public std::streambuf
+    {
+      public:
+        std::size_t     getCount() const { return count_; }
+
+      protected:
+        int_type overflow(int_type c) override
+        {
+            count_ += traits_type::eq_int_type(c, traits_type::eof()) ? 0 : 1;
+            return traits_type::not_eof(c);
+        }
+
+        std::streamsize xsputn(const char*, std::streamsize count) override
+        {
+            count_ += static_cast<std::size_t>(count);
+            return count;
+        }
+
+      private:
+        std::size_t     count_ = 0;
+    };
+
+    // the peak resident set in KB since the last call, or since the start
+    // of the program where the kernel can not reset it.
+    std::uint64_t peakResidentSet()
+    {
+        std::uint64_t peak = 0;
+#if !defined(_WIN32)
+        std::ifstream status("/proc/self/status");
+        std::string line;
+
+        while (std::getline(status, line))
+        {
+            if (line.compare(0, 6, "VmHWM:") == 0)
+            {
+                peak = std::strtoull(line.c_str() + 6, nullptr, 10);
+            }
+        }
+
+        if (peak == 0)
+        {
+            rusage usage;
+            getrusage(RUSAGE_SELF, &usage);
+            peak = static_cast<std::uint64_t>(usage.ru_maxrss);
+        }
+
+        std::ofstream("/proc/self/clear_refs") << "5";
+#endif
+        return peak;
+    }
+
+    struct Result
+    {
+        std::string     phase;
+        double          seconds;
+        std::size_t     bytes;
+        std::size_t     tokens;
+        std::size_t     nodes;
+        std::uint64_t   allocations;
+        std::uint64_t   allocatedBytes;
+        std::uint64_t   peakKilobytes;
+    };
+
+    // the best time of repeat runs, the allocations and the peak of the last one.
+    Result measure(const std::string& phase, int repeat, const std::function<void()>& run)
+    {
+        Result result{phase, 0.0, 0, 0, 0, 0, 0, 0};
+
+        for (int i = 0; i < repeat; i++)
+        {
+            peakResidentSet();
+            MJava::AllocationCounters before = MJava::getAllocationCounters();
+            auto start = std::chrono::steady_clock::now();
+
+            run();
+
+            double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+            MJava::AllocationCounters after = MJava::getAllocationCounters();
+            result.seconds = i == 0 || seconds < result.seconds ? seconds : result.seconds;
+            result.allocations = after.count - before.count;
+            result.allocatedBytes = after.bytes - before.bytes;
+            result.peakKilobytes = peakResidentSet();
+        }
+
+        return result;
+    }
+
+    void printUsage()
+    {
+        std::cout << "Usage: CompilerBench [--shape <Shape>] [--size <MB>] [--repeat <N>] [--dfa] [--json] [--save <File>]\n"
+                  << "Shapes are mixed (the default), classes, deep, long, comments and literals.\n"
+                  << "--size is the size of the generated source, 8 MB by default.\n"
+                  << "--repeat runs every phase N times and keeps the best time, 5 by default.\n"
+                  << "--json prints the results as json instead of a table.\n"
+                  << "--save writes the generated source to the file." << std::endl;
+    }
+} // namespace
+
+int main(int argc, char** argv)
+{
+    const Shape* shape = &SHAPES[0];
+    double megabytes = 8.0;
+    int repeat = 5;
+    bool json = false;
+    std::string saveFile;
+    MJava::Scanner::Engine engine = MJava::Scanner::Engine::HAND_WRITTEN;
+
+    for (int i = 1; i < argc; i++)
+    {
+        std::string argument = argv[i];
+
+        if (argument == "--shape" && i + 1 < argc)
+        {
+            std::string name = argv[++i];
+            shape = nullptr;
+
+            for (const Shape& candidate : SHAPES)
+            {
+                shape = name == candidate.name ? &candidate : shape;
+            }
+
+            if (shape == nullptr)
+            {
+                std::cerr << "Unknown shape: " << name << std::endl;
+                printUsage();
+                return 1;
+            }
+        }
+        else if (argument == "--size" && i + 1 < argc)
+        {
+            megabytes = std::atof(argv[++i]);
+        }
+        else if (argument == "--repeat" && i + 1 < argc)
+        {
+            repeat = std::atoi(argv[++i]);
+        }
+        else if (argument == "--dfa")
+        {
+            engine = MJava::Scanner::Engine::TABLE_DRIVEN;
+        }
+        else if (argument == "--json")
+        {
+            json = true;
+        }
+        else if (argument == "--save" && i + 1 < argc)
+        {
+            saveFile = argv[++i];
+        }
+        else
+        {
+            printUsage();
+            return argument == "--help" ? 0 : 1;
+        }
+    }
+
+    if (megabytes <= 0.0 || repeat <= 0)
+    {
+        printUsage();
+        return 1;
+    }
+
+    std::string source = generate(*shape, static_cast<std::size_t>(megabytes * 1024 * 1024));
+
+    if (!saveFile.empty())
+    {
+        std::ofstream(saveFile, std::ios::out | std::ios::binary) << source;
+    }
+
+    MJava::Scanner scanner("<" + std::string(shape->name) + ">", source, engine);
+    MJava::TokenBuffer tokens = scanner.tokenizeAll();
+    MJava::Parser parser(tokens);
+    MJava::ProgramASTPtr program = parser.parse();
+    std::size_t nodes = MJava::countNodes(program);
+
+    if (scanner.getErrorCount() != 0 || parser.getErrorFlag())
+    {
+        std::cerr << "The generated source has errors." << std::endl;
+        return 1;
+    }
+
+    std::vector<Result> results;
+    Result result;
+
+    // the scanner the parser reads from, one token at a time.
+    result = measure("scan", repeat, [&]
+    {
+        MJava::Scanner benchScanner("<scan>", source, engine);
+
+        while (benchScanner.getNextToken().getTokenType() != MJava::TokenType::END_OF_FILE)
+        {}
+    });
+    result.tokens = tokens.size();
+    results.push_back(result);
+
+    result = measure("tokenize", repeat, [&]
+    {
+        MJava::Scanner benchScanner("<tokenize>", source, engine);
+        benchScanner.tokenizeAll();
+    });
+    result.tokens = tokens.size();
+    results.push_back(result);
+
+    result = measure("parse", repeat, [&]
+    {
+        MJava::Parser benchParser(tokens);
+        benchParser.parse();
+    });
+    result.tokens = tokens.size();
+    result.nodes = nodes;
+    results.push_back(result);
+
+    // the two writers of the tree, both into a stream which drops the bytes.
+    const char* writers[] = {"json", "json-compact", "binary"};
+
+    for (int writer = 0; writer < 3; writer++)
+    {
+        std::size_t outputBytes = 0;
+
+        result = measure(writers[writer], repeat, [&]
+        {
+            CountingBuffer buffer;
+            std::ostream out(&buffer);
+
+            if (writer == 2)
+            {
+                parser.writeBinary(out);
+            }
+            else
+            {
+                parser.writeJSON(out, writer == 0);
+            }
+
+            outputBytes = buffer.getCount();
+        });
+        result.nodes = nodes;
+        result.bytes = outputBytes;
+        results.push_back(result);
+    }
+
+    for (Result& phase : results)
+    {
+        phase.bytes = phase.bytes != 0 ? phase.bytes : source.size();
+    }
+
+    if (json)
+    {
+        MJava::JSONWriter writer(std::cout);
+        writer.beginObject();
+        writer.key("shape");
+        writer.value(shape->name);
+        writer.key("engine");
+        writer.value(engine == MJava::Scanner::Engine::TABLE_DRIVEN ? "dfa" : "hand");
+        writer.key("sourceBytes");
+        writer.value(static_cast<std::uint64_t>(source.size()));
+        writer.key("tokens");
+        writer.value(static_cast<std::uint64_t>(tokens.size()));
+        writer.key("nodes");
+        writer.value(static_cast<std::uint64_t>(nodes));
+        writer.key("phases");
+        writer.beginArray();
+
+        for (const Result& phase : results)
+        {
+            writer.beginObject();
+            writer.key("phase");
+            writer.value(phase.phase);
+            writer.key("seconds");
+            writer.value(phase.seconds);
+            writer.key("bytes");
+            writer.value(static_cast<std::uint64_t>(phase.bytes));
+            writer.key("megabytesPerSecond");
+            writer.value(static_cast<double>(phase.bytes) / (1024 * 1024) / phase.seconds);
+            writer.key("tokensPerSecond");
+            writer.value(static_cast<double>(phase.tokens) / phase.seconds);
+            writer.key("nodesPerSecond");
+            writer.value(static_cast<double>(phase.nodes) / phase.seconds);
+            writer.key("allocations");
+            writer.value(phase.allocations);
+            writer.key("allocatedBytes");
+            writer.value(phase.allocatedBytes);
+            writer.key("peakKilobytes");
+            writer.value(phase.peakKilobytes);
+            writer.endObject();
+        }
+
+        writer.endArray();
+        writer.endObject();
+        writer.flush();
+        std::cout << std::endl;
+
+        return 0;
+    }
+
+    std::cout << "shape " << shape->name << ", " << source.size() << " bytes, "
+              << tokens.size() << " tokens, " << nodes << " nodes\n\n";
+    std::printf("%-14s %10s %10s %12s %12s %12s %14s %10s\n",
+                "phase", "ms", "MB/s", "tokens/s", "nodes/s", "allocations", "alloc bytes", "peak KB");
+
+    for (const Result& phase : results)
+    {
+        std::printf("%-14s %10.2f %10.1f %12.0f %12.0f %12llu %14llu %10llu\n",
+                    phase.phase.c_str(), phase.seconds * 1000,
+                    static_cast<double>(phase.bytes) / (1024 * 1024) / phase.seconds,
+                    static_cast<double>(phase.tokens) / phase.seconds,
+                    static_cast<double>(phase.nodes) / phase.seconds,
+                    static_cast<unsigned long long>(phase.allocations),
+                    static_cast<unsigned long long>(phase.allocatedBytes),
+                    static_cast<unsigned long long>(phase.peakKilobytes));
+    }
+
+    return 0;
+}
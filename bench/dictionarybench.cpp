@@ -0,0 +1,124 @@
+// THIS FILE IS PART OF MJava-Compiler PROJECT
+// dictionarybench.cpp - perfect hash dictionary against std::map dictionary
+
+// Created by Li Taiji 2026-10-17
+// Copyright (c) 2026 Li Taiji All rights reserved
+
+#include "dictionary.h"
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <map>
+#include <string>
+#include <string_view>
+#include <tuple>
+#include <vector>
+
+namespace
+{
+    // the dictionary before the perfect hash, kept here as the baseline.
+    class MapDictionary
+    {
+      public:
+        MapDictionary()
+        {
+            for (const MJava::DictionaryEntry& entry : MJava::DICTIONARY_ENTRIES)
+            {
+                dictionary_.insert(std::make_pair(std::string(entry.name),
+                                                  std::make_tuple(entry.value, entry.type, entry.precedence)));
+            }
+        }
+
+        std::tuple<MJava::TokenType, MJava::TokenValue, int> lookup(const std::string& name) const
+        {
+            MJava::TokenValue tokenValue = MJava::TokenValue::UNRESERVED;
+            MJava::TokenType  tokenType  = MJava::TokenType::IDENTIFIER;
+            int               precedence = -1;
+            auto iter = dictionary_.find(name);
+
+            if (iter != dictionary_.end())
+            {
+                tokenValue = std::get<0>(iter->second);
+                tokenType  = std::get<1>(iter->second);
+                precedence = std::get<2>(iter->second);
+            }
+
+            return std::make_tuple(tokenType, tokenValue, precedence);
+        }
+
+      private:
+        std::map<std::string, std::tuple<MJava::TokenValue, MJava::TokenType, int>> dictionary_;
+    };
+
+    // a mix of keywords, operators and identifiers like the ones of a real program.
+    std::vector<std::string> makeWords()
+    {
+        std::vector<std::string> words;
+
+        for (const MJava::DictionaryEntry& entry : MJava::DICTIONARY_ENTRIES)
+        {
+            words.emplace_back(entry.name);
+        }
+
+        const char* identifiers[] = {"num", "num_aux", "ComputeFac", "arr", "flag", "index",
+                                     "BinarySearch", "size", "x", "y", "System", "classes",
+                                     "publicValue", "i", "j", "counter", "tmp", "result"};
+
+        for (const char* identifier : identifiers)
+        {
+            words.emplace_back(identifier);
+        }
+
+        return words;
+    }
+
+    template <typename Function>
+    double measure(const std::vector<std::string>& words, long rounds, Function lookup)
+    {
+        auto start = std::chrono::steady_clock::now();
+        long sink = 0;
+
+        for (long round = 0; round < rounds; round++)
+        {
+            for (const std::string& word : words)
+            {
+                sink += static_cast<int>(std::get<1>(lookup(word)));
+            }
+        }
+
+        auto stop = std::chrono::steady_clock::now();
+        // keep the compiler from dropping the lookups.
+        volatile long result = sink;
+        (void)result;
+
+        double nanoseconds = std::chrono::duration<double, std::nano>(stop - start).count();
+        return nanoseconds / static_cast<double>(rounds * static_cast<long>(words.size()));
+    }
+} // namespace
+
+int main(int argc, char** argv)
+{
+    long rounds = argc > 1 ? std::atol(argv[1]) : 200000;
+    std::vector<std::string> words = makeWords();
+    MapDictionary mapDictionary;
+    MJava::Dictionary dictionary;
+
+    for (const std::string& word : words)
+    {
+        if (mapDictionary.lookup(word) != dictionary.lookup(word))
+        {
+            std::cerr << "Dictionaries disagree on " << word << std::endl;
+            return 1;
+        }
+    }
+
+    double mapTime = measure(words, rounds, [&](const std::string& word) { return mapDictionary.lookup(word); });
+    double hashTime = measure(words, rounds, [&](const std::string& word) { return dictionary.lookup(word); });
+
+    std::cout << "lookups:        " << rounds * static_cast<long>(words.size()) << "\n"
+              << "std::map:       " << mapTime << " ns/lookup\n"
+              << "perfect hash:   " << hashTime << " ns/lookup\n"
+              << "speedup:        " << mapTime / hashTime << "x" << std::endl;
+
+    return 0;
+}
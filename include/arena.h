@@ -0,0 +1,169 @@
+// THIS FILE IS PART OF MJava-Compiler PROJECT
+// arena.h - bump pointer allocator for the syntax tree
+
+// Created by Li Taiji 2026-10-17
+// Copyright (c) 2026 Li Taiji All rights reserved
+
+#ifndef ARENA_H_
+#define ARENA_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <new>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace MJava
+{
+    // a read-only array which lives in an arena, like std::string_view for
+    // arrays. it does not own the elements.
+    template <typename T>
+    class ArrayRef
+    {
+      public:
+        ArrayRef() : data_(nullptr), size_(0) {}
+        ArrayRef(const T* data, std::size_t size) : data_(data), size_(size) {}
+
+        const T*        begin() const { return data_; }
+        const T*        end() const { return data_ + size_; }
+        const T*        data() const { return data_; }
+        std::size_t     size() const { return size_; }
+        bool            empty() const { return size_ == 0; }
+        const T&        operator[](std::size_t index) const { return data_[index]; }
+
+      private:
+        const T*        data_;
+        std::size_t     size_;
+    };
+
+    // Arena hands out memory from big chunks by moving a pointer, and frees
+    // all of it at once when it is destroyed or released. nothing allocated
+    // from it is ever destroyed one by one, so make() only takes types with
+    // a trivial destructor.
+    class Arena
+    {
+      public:
+        explicit            Arena(std::size_t chunkSize = DEFAULT_CHUNK_SIZE);
+                            Arena(const Arena&) = delete;
+        Arena&              operator=(const Arena&) = delete;
+                            Arena(Arena&& other) noexcept;
+        Arena&              operator=(Arena&& other) noexcept;
+
+        void*               allocate(std::size_t size, std::size_t alignment);
+
+        template <typename T, typename... Args>
+        T*                  make(Args&&... args);
+
+        template <typename T>
+        ArrayRef<T>         copyArray(const std::vector<T>& values);
+
+        std::string_view    copyString(std::string_view text);
+
+        // the point an arena can be rewound to.
+        struct Mark
+        {
+            std::size_t     chunkCount;
+            char*           current;
+            char*           end;
+            std::size_t     bytesUsed;
+        };
+
+        Mark                getMark() const;
+        // free everything allocated after the mark was taken. the parser
+        // drops the nodes of a statement it could not parse this way, so
+        // none of them may still be used.
+        void                rewind(const Mark& mark);
+
+        // free all the chunks. everything allocated before is gone.
+        void                release();
+
+        // bytes handed out, without the unused tails of the chunks.
+        std::size_t         getBytesUsed() const;
+
+      private:
+        void                grow(std::size_t size);
+
+      private:
+        static constexpr std::size_t DEFAULT_CHUNK_SIZE = 64 * 1024;
+
+        std::size_t                             chunkSize_;
+        std::vector<std::unique_ptr<char[]>>    chunks_;
+        char*                                   current_;
+        char*                                   end_;
+        std::size_t                             bytesUsed_;
+    };
+
+    inline void* Arena::allocate(std::size_t size, std::size_t alignment)
+    {
+        std::uintptr_t address = reinterpret_cast<std::uintptr_t>(current_);
+        std::size_t padding = (alignment - address % alignment) % alignment;
+
+        if (current_ == nullptr || padding + size > static_cast<std::size_t>(end_ - current_))
+        {
+            grow(size + alignment);
+            address = reinterpret_cast<std::uintptr_t>(current_);
+            padding = (alignment - address % alignment) % alignment;
+        }
+
+        char* memory = current_ + padding;
+        current_ = memory + size;
+        bytesUsed_ += size;
+
+        return memory;
+    }
+
+    template <typename T, typename... Args>
+    inline T* Arena::make(Args&&... args)
+    {
+        static_assert(std::is_trivially_destructible<T>::value,
+                      "Arena never runs destructors, so the type must not need one.");
+
+        void* memory = allocate(sizeof(T), alignof(T));
+        return new (memory) T(std::forward<Args>(args)...);
+    }
+
+    template <typename T>
+    inline ArrayRef<T> Arena::copyArray(const std::vector<T>& values)
+    {
+        static_assert(std::is_trivially_copyable<T>::value, "Arena arrays are copied with memcpy.");
+
+        if (values.empty())
+        {
+            return ArrayRef<T>();
+        }
+
+        T* memory = static_cast<T*>(allocate(sizeof(T) * values.size(), alignof(T)));
+        std::memcpy(memory, values.data(), sizeof(T) * values.size());
+
+        return ArrayRef<T>(memory, values.size());
+    }
+
+    inline std::string_view Arena::copyString(std::string_view text)
+    {
+        if (text.empty())
+        {
+            return std::string_view();
+        }
+
+        char* memory = static_cast<char*>(allocate(text.size(), 1));
+        std::memcpy(memory, text.data(), text.size());
+
+        return std::string_view(memory, text.size());
+    }
+
+    inline Arena::Mark Arena::getMark() const
+    {
+        return Mark{chunks_.size(), current_, end_, bytesUsed_};
+    }
+
+    inline std::size_t Arena::getBytesUsed() const
+    {
+        return bytesUsed_;
+    }
+} // namespace MJava
+
+#endif // arena.h
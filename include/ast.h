@@ -7,9 +7,12 @@
 #ifndef AST_H_
 #define AST_H_
 
+#include "arena.h"
 #include "token.h"
+#include <cstddef>
 #include <memory>
 #include <string>
+#include <string_view>
 #include <vector>
 
 namespace MJava
@@ -17,7 +20,9 @@ namespace MJava
     class ExprAST;
     class ProgramAST;
 
+    // the parser collects children in a vector, the tree keeps them in its arena.
     using VecExprASTPtr = std::vector<ExprAST*>;
+    using ExprASTArray = ArrayRef<ExprAST*>;
     using ExprASTPtr = ExprAST*;
     using ProgramASTPtr = ProgramAST*;
 
@@ -49,15 +54,20 @@ namespace MJava
         BOOLEAN
     };
 
+    // all the nodes are allocated from the arena of the parser and are never
+    // deleted one by one, so no node has a destructor. names and children are
+    // views into the same arena, so the getters return them by value without
+    // copying anything. operators are token values, Dictionary::spell() gives
+    // their names back.
     class ExprAST
     {
     public:
         ExprAST(const TokenLocation& loc, ASTType type);
-        virtual ~ExprAST() = default;
         TokenLocation getTokenLocation() const { return loc_; }
         ASTType getID() const { return type_; }
-        std::string getASTTypeDescription() const;
-        virtual std::string toString() const;
+        std::string_view getASTTypeDescription() const;
+        // the source before the node has been edited, see incrementalparser.h.
+        void moveBy(std::ptrdiff_t delta);
 
     private:
         TokenLocation       loc_;
@@ -67,143 +77,126 @@ namespace MJava
     class ProgramAST : public ExprAST
     {
     public:
-        ProgramAST(const TokenLocation& loc, const VecExprASTPtr& classes);
-        ~ProgramAST();
-        std::string toString() const;
+        ProgramAST(const TokenLocation& loc, ExprASTArray classes);
+        ExprASTArray getClasses() const { return classes_; }
         
     private:
-        VecExprASTPtr       classes_;
+        ExprASTArray        classes_;
     };
 
     class BlockAST : public ExprAST
     {
     public:
-        BlockAST(const TokenLocation& loc, const VecExprASTPtr& block);
-        ~BlockAST();
-        VecExprASTPtr getBlock() const { return block_; }
-        std::string toString() const override;
+        BlockAST(const TokenLocation& loc, ExprASTArray block);
+        ExprASTArray getBlock() const { return block_; }
 
     private:
-        VecExprASTPtr       block_;
+        ExprASTArray        block_;
     };
 
     class ClassDeclarationAST : public ExprAST
     {
     public:
-        ClassDeclarationAST(const TokenLocation& loc, const std::string& className, const std::string& baseClassName, const VecExprASTPtr& memberVariables, const VecExprASTPtr& memberMethods);
-        ~ClassDeclarationAST();
-        std::string getClassName() const { return className_; }
-        std::string getBaseClassName() const { return baseClassName_; }
-        VecExprASTPtr getMemberVariables() const { return memberVariables_; }
-        VecExprASTPtr getMemberMemthods() const { return memberMethods_; }
-        std::string toString() const override;
+        ClassDeclarationAST(const TokenLocation& loc, std::string_view className, std::string_view baseClassName, ExprASTArray memberVariables, ExprASTArray memberMethods);
+        std::string_view getClassName() const { return className_; }
+        std::string_view getBaseClassName() const { return baseClassName_; }
+        ExprASTArray getMemberVariables() const { return memberVariables_; }
+        ExprASTArray getMemberMemthods() const { return memberMethods_; }
 
     private:
-        std::string         className_;
-        std::string         baseClassName_;
-        VecExprASTPtr       memberVariables_;
-        VecExprASTPtr       memberMethods_;
+        std::string_view    className_;
+        std::string_view    baseClassName_;
+        ExprASTArray        memberVariables_;
+        ExprASTArray        memberMethods_;
     };
 
     class MainClassAST : public ExprAST
     {
     public:
-        MainClassAST(const TokenLocation& loc, const std::string& className, ExprASTPtr mainMethod);
-        ~MainClassAST();
-        std::string toString() const override;
+        MainClassAST(const TokenLocation& loc, std::string_view className, ExprASTPtr mainMethod);
+        std::string_view getClassName() const { return className_; }
+        ExprASTPtr getMainMethod() const { return mainMethod_; }
 
     private:
-        std::string         className_;
+        std::string_view    className_;
         ExprASTPtr          mainMethod_;
     };
 
     class MethodBodyAST : public ExprAST
     {
     public:
-        MethodBodyAST(const TokenLocation& loc, const VecExprASTPtr& localVariables, const VecExprASTPtr& methodBody, ExprASTPtr returnStatement);
-        ~MethodBodyAST();
-        VecExprASTPtr getLocalVariables() const { return localVariables_; }
-        VecExprASTPtr getMethodBody() const { return methodBody_; }
+        MethodBodyAST(const TokenLocation& loc, ExprASTArray localVariables, ExprASTArray methodBody, ExprASTPtr returnStatement);
+        ExprASTArray getLocalVariables() const { return localVariables_; }
+        ExprASTArray getMethodBody() const { return methodBody_; }
         ExprASTPtr getReturnStatement() const { return returnStatement_; }
-        std::string toString() const override;
 
     private:
-        VecExprASTPtr       localVariables_;
-        VecExprASTPtr       methodBody_;
+        ExprASTArray        localVariables_;
+        ExprASTArray        methodBody_;
         ExprASTPtr          returnStatement_;
     };
 
     class MethodDeclarationAST : public ExprAST
     {
     public:
-        MethodDeclarationAST(const TokenLocation& loc, const std::vector<std::string>& attributes, const std::string& returnType, const std::string& name, const VecExprASTPtr& parameters, ExprASTPtr body);
-        ~MethodDeclarationAST();
-        std::vector<std::string> getAttributes() const { return attributes_; }
-        std::string getReturnType() const { return returnType_; }
-        std::string getMethodName() const { return name_; }
-        VecExprASTPtr getParameters() const { return parameters_; }
+        MethodDeclarationAST(const TokenLocation& loc, ArrayRef<std::string_view> attributes, std::string_view returnType, std::string_view name, ExprASTArray parameters, ExprASTPtr body);
+        ArrayRef<std::string_view> getAttributes() const { return attributes_; }
+        std::string_view getReturnType() const { return returnType_; }
+        std::string_view getMethodName() const { return name_; }
+        ExprASTArray getParameters() const { return parameters_; }
         ExprASTPtr getBody() const { return body_; }
-        std::string toString() const override;
 
     private:
-        std::vector<std::string> attributes_;
-        std::string         returnType_;
-        std::string         name_;
-        VecExprASTPtr       parameters_;
+        ArrayRef<std::string_view> attributes_;
+        std::string_view    returnType_;
+        std::string_view    name_;
+        ExprASTArray        parameters_;
         ExprASTPtr          body_;
     };
 
     class MethodCallAST : public ExprAST
     {
     public:
-        MethodCallAST(const TokenLocation& loc, const std::string& name, const VecExprASTPtr& parameters);
-        ~MethodCallAST();
-        std::string getName() const { return name_; }
-        VecExprASTPtr getParameters() const { return parameters_; }
-        std::string toString() const override;
+        MethodCallAST(const TokenLocation& loc, std::string_view name, ExprASTArray parameters);
+        std::string_view getName() const { return name_; }
+        ExprASTArray getParameters() const { return parameters_; }
 
     private:
-        std::string         name_;
-        VecExprASTPtr       parameters_;
+        std::string_view    name_;
+        ExprASTArray        parameters_;
     };
 
     class VariableDeclarationAST : public ExprAST
     {
     public:
-        VariableDeclarationAST(const TokenLocation& loc, const std::string& type, const std::string& name);
-        ~VariableDeclarationAST() = default;
-        std::string getType() const { return type_; }
-        std::string getName() const { return name_; }
-        std::string toString() const override;
+        VariableDeclarationAST(const TokenLocation& loc, std::string_view type, std::string_view name);
+        std::string_view getType() const { return type_; }
+        std::string_view getName() const { return name_; }
 
     private:
-        std::string         type_;
-        std::string         name_;
+        std::string_view    type_;
+        std::string_view    name_;
     };
 
     class VariableAST : public ExprAST
     {
     public:
-        VariableAST(const TokenLocation& loc, const std::string& name);
-        ~VariableAST() = default;
-        std::string getName() const { return name_; }
-        std::string toString() const override;
+        VariableAST(const TokenLocation& loc, std::string_view name);
+        std::string_view getName() const { return name_; }
 
     private:
-        std::string         name_;
+        std::string_view    name_;
     };
 
     class ArrayAST : public ExprAST
     {
     public:
-        ArrayAST(const TokenLocation &loc, const std::string &name, ExprASTPtr index);
-        ~ArrayAST();
-        std::string getName() const { return name_; }
+        ArrayAST(const TokenLocation& loc, std::string_view name, ExprASTPtr index);
+        std::string_view getName() const { return name_; }
         ExprASTPtr getIndex() const { return index_; }
-        std::string toString() const override;
 
     private:
-        std::string         name_;
+        std::string_view    name_;
         ExprASTPtr          index_;
     };
 
@@ -211,11 +204,9 @@ namespace MJava
     {
     public:
         IfStatementAST(const TokenLocation& loc, ExprASTPtr condition, ExprASTPtr thenPart, ExprASTPtr elsePart);
-        ~IfStatementAST();
         ExprASTPtr getCondition() const { return condition_; }
         ExprASTPtr getThenPart() const { return thenPart_; }
         ExprASTPtr getElsePart() const { return elsePart_; }
-        std::string toString() const override;
 
     private:
         ExprASTPtr          condition_;
@@ -227,10 +218,8 @@ namespace MJava
     {
     public:
         WhileStatementAST(const TokenLocation& loc, ExprASTPtr condition, ExprASTPtr body);
-        ~WhileStatementAST();
         ExprASTPtr getCondition() const { return condition_; }
         ExprASTPtr getBody() const { return body_; }
-        std::string toString() const override;
 
     private:
         ExprASTPtr          condition_;
@@ -241,12 +230,10 @@ namespace MJava
     {
     public:
         ForStatementAST(const TokenLocation& loc, ExprASTPtr variable, ExprASTPtr condition, ExprASTPtr action, ExprASTPtr body);
-        ~ForStatementAST();
         ExprASTPtr getVariable() const { return variable_; }
         ExprASTPtr getCondition() const { return condition_; }
         ExprASTPtr getAction() const { return action_; }
         ExprASTPtr getBody() const { return body_; }
-        std::string toString() const override;
 
     private:
         ExprASTPtr          variable_;
@@ -259,9 +246,7 @@ namespace MJava
     {
     public:
         ReturnStatementAST(const TokenLocation& loc, ExprASTPtr returnStatement);
-        ~ReturnStatementAST();
         ExprASTPtr getReturnStatement() const { return returnStatement_; }
-        std::string toString() const override;
 
     private:
         ExprASTPtr          returnStatement_;
@@ -271,9 +256,7 @@ namespace MJava
     {
     public:
         PrintStatementAST(const TokenLocation& loc, ExprASTPtr printStatement);
-        ~PrintStatementAST();
         ExprASTPtr getPrintStatement() const { return printStatement_; }
-        std::string toString() const override;
         
     private:
         ExprASTPtr          printStatement_;
@@ -282,29 +265,25 @@ namespace MJava
     class NewStatementAST : public ExprAST
     {
     public:
-        NewStatementAST(const TokenLocation& loc, const std::string& type, ExprASTPtr newStatement);
-        ~NewStatementAST();
-        std::string getType() const { return type_; }
+        NewStatementAST(const TokenLocation& loc, std::string_view type, ExprASTPtr newStatement);
+        std::string_view getType() const { return type_; }
         ExprASTPtr getNewStatement() const { return newStatement_; }
-        std::string toString() const override;
         
     private:
-        std::string         type_;
+        std::string_view    type_;
         ExprASTPtr          newStatement_;
     };
 
     class BinaryOpExpressionAST : public ExprAST
     {
     public:
-        BinaryOpExpressionAST(const TokenLocation& loc, const std::string& binaryOp, ExprASTPtr lhs, ExprASTPtr rhs);
-        ~BinaryOpExpressionAST();
-        std::string getBinaryOp() const { return binaryOp_; }
+        BinaryOpExpressionAST(const TokenLocation& loc, TokenValue binaryOp, ExprASTPtr lhs, ExprASTPtr rhs);
+        TokenValue getBinaryOp() const { return binaryOp_; }
         ExprASTPtr getLhs() const { return lhs_; }
         ExprASTPtr getRhs() const { return rhs_; }
-        std::string toString() const override;
 
     private:
-        std::string         binaryOp_;
+        TokenValue          binaryOp_;
         ExprASTPtr          lhs_;
         ExprASTPtr          rhs_;
     };
@@ -312,14 +291,12 @@ namespace MJava
     class UnaryOpExpressionAST : public ExprAST
     {
     public:
-        UnaryOpExpressionAST(const TokenLocation& loc, const std::string& unaryOp, ExprASTPtr expression);
-        ~UnaryOpExpressionAST();
-        std::string getUnaryOp() const { return unaryOp_; }
+        UnaryOpExpressionAST(const TokenLocation& loc, TokenValue unaryOp, ExprASTPtr expression);
+        TokenValue getUnaryOp() const { return unaryOp_; }
         ExprASTPtr getExpression() const { return expression_; }
-        std::string toString() const override;
 
     private:
-        std::string         unaryOp_;
+        TokenValue          unaryOp_;
         ExprASTPtr          expression_;
     };
 
@@ -327,9 +304,7 @@ namespace MJava
     {
     public:
         RealAST(const TokenLocation& loc, double real);
-        ~RealAST() = default;
         double getReal() const { return real_; }
-        std::string toString() const override;
 
     private:
         double              real_;
@@ -338,9 +313,7 @@ namespace MJava
     {
     public:
         IntegerAST(const TokenLocation& loc, int integer);
-        ~IntegerAST() = default;
         int getInteger() const { return integer_; }
-        std::string toString() const override;
 
     private:
         int                 integer_;
@@ -350,9 +323,7 @@ namespace MJava
     {
     public:
         CharAST(const TokenLocation& loc, char ch);
-        ~CharAST() = default;
         char getChar() const { return ch_; }
-        std::string toString() const override;
 
     private:
         char                ch_;
@@ -361,22 +332,18 @@ namespace MJava
     class StringAST : public ExprAST
     {
     public:
-        StringAST(const TokenLocation& loc, const std::string& str);
-        ~StringAST() = default;
-        std::string getString() const { return str_; }
-        std::string toString() const override;
+        StringAST(const TokenLocation& loc, std::string_view str);
+        std::string_view getString() const { return str_; }
 
     private:
-        std::string         str_;
+        std::string_view    str_;
     };
 
     class BooleanAST : public ExprAST
     {
     public:
         BooleanAST(const TokenLocation& loc, bool boolean);
-        ~BooleanAST() = default;
         bool getBoolean() const { return boolean_; }
-        std::string toString() const override;
 
     private:
         bool                boolean_;
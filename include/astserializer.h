@@ -0,0 +1,79 @@
+// THIS FILE IS PART OF MJava-Compiler PROJECT
+// astserializer.h - write the abstract syntax tree as json
+
+// Created by Li Taiji 2026-10-17
+// Copyright (c) 2026 Li Taiji All rights reserved
+
+#ifndef ASTSERIALIZER_H_
+#define ASTSERIALIZER_H_
+
+#include "ast.h"
+#include "astvisitor.h"
+#include "jsonwriter.h"
+#include <vector>
+
+namespace MJava
+{
+    // ASTSerializer walks the tree once and sends every node straight to a
+    // JSONWriter. it is a static visitor, so there is no virtual call per
+    // node. the member names are those of the .ast files the parser has
+    // always written.
+    class ASTSerializer : public ASTStaticVisitor<ASTSerializer>
+    {
+    public:
+        explicit                ASTSerializer(JSONWriter& writer);
+
+        // a null node is written as an empty object.
+        void                    write(const ExprAST* ast);
+
+    private:
+        friend class ASTStaticVisitor<ASTSerializer>;
+
+        void                    visitNull();
+        void                    visitBase(const ExprAST* ast);
+        void                    visitProgram(const ProgramAST* ast);
+        void                    visitBlock(const BlockAST* ast);
+        void                    visitClassDeclaration(const ClassDeclarationAST* ast);
+        void                    visitMainClass(const MainClassAST* ast);
+        void                    visitMethodBody(const MethodBodyAST* ast);
+        void                    visitMethodDeclaration(const MethodDeclarationAST* ast);
+        void                    visitMethodCall(const MethodCallAST* ast);
+        void                    visitVariableDeclaration(const VariableDeclarationAST* ast);
+        void                    visitVariable(const VariableAST* ast);
+        void                    visitArray(const ArrayAST* ast);
+        void                    visitIfStatement(const IfStatementAST* ast);
+        void                    visitWhileStatement(const WhileStatementAST* ast);
+        void                    visitForStatement(const ForStatementAST* ast);
+        void                    visitReturnStatement(const ReturnStatementAST* ast);
+        void                    visitPrintStatement(const PrintStatementAST* ast);
+        void                    visitNewStatement(const NewStatementAST* ast);
+        void                    visitBinaryOpExpression(const BinaryOpExpressionAST* ast);
+        void                    visitUnaryOpExpression(const UnaryOpExpressionAST* ast);
+        void                    visitReal(const RealAST* ast);
+        void                    visitInteger(const IntegerAST* ast);
+        void                    visitChar(const CharAST* ast);
+        void                    visitString(const StringAST* ast);
+        void                    visitBoolean(const BooleanAST* ast);
+
+        // the elements of a statement list. a block adds its own statements
+        // to the list instead of being an element.
+        void                    writeStatements(const ExprAST* ast);
+        void                    writeStatementArray(const ExprAST* ast);
+        void                    writeArray(ExprASTArray asts);
+        void                    writeHeader(const ExprAST* ast);
+
+    private:
+        // an operator whose operands are being written, and the next one of them.
+        struct Operator
+        {
+            const BinaryOpExpressionAST*    ast;
+            int                             operand;
+        };
+
+        JSONWriter&             writer_;
+        // the operators of all the expressions being written, innermost last.
+        std::vector<Operator>   operators_;
+    };
+} // namespace MJava
+
+#endif // astserializer.h
@@ -0,0 +1,370 @@
+// THIS FILE IS PART OF MJava-Compiler PROJECT
+// astvisitor.h - visitors of the abstract syntax tree
+
+// Created by Li Taiji 2026-10-17
+// Copyright (c) 2026 Li Taiji All rights reserved
+
+#ifndef ASTVISITOR_H_
+#define ASTVISITOR_H_
+
+#include "ast.h"
+#include <cstddef>
+#include <vector>
+
+namespace MJava
+{
+    // ASTVisitor calls the virtual visit function of the real type of a node.
+    // a pass overrides the functions of the nodes it cares about, the others
+    // go to visitBase, which does nothing. visit() does not go into the
+    // children by itself.
+    class ASTVisitor
+    {
+    public:
+        virtual                 ~ASTVisitor() = default;
+
+        void                    visit(const ExprAST* ast);
+
+        // a null child, and a node of type BASE.
+        virtual void            visitNull();
+        virtual void            visitBase(const ExprAST* ast);
+        virtual void            visitProgram(const ProgramAST* ast);
+        virtual void            visitBlock(const BlockAST* ast);
+        virtual void            visitClassDeclaration(const ClassDeclarationAST* ast);
+        virtual void            visitMainClass(const MainClassAST* ast);
+        virtual void            visitMethodBody(const MethodBodyAST* ast);
+        virtual void            visitMethodDeclaration(const MethodDeclarationAST* ast);
+        virtual void            visitMethodCall(const MethodCallAST* ast);
+        virtual void            visitVariableDeclaration(const VariableDeclarationAST* ast);
+        virtual void            visitVariable(const VariableAST* ast);
+        virtual void            visitArray(const ArrayAST* ast);
+        virtual void            visitIfStatement(const IfStatementAST* ast);
+        virtual void            visitWhileStatement(const WhileStatementAST* ast);
+        virtual void            visitForStatement(const ForStatementAST* ast);
+        virtual void            visitReturnStatement(const ReturnStatementAST* ast);
+        virtual void            visitPrintStatement(const PrintStatementAST* ast);
+        virtual void            visitNewStatement(const NewStatementAST* ast);
+        virtual void            visitBinaryOpExpression(const BinaryOpExpressionAST* ast);
+        virtual void            visitUnaryOpExpression(const UnaryOpExpressionAST* ast);
+        virtual void            visitReal(const RealAST* ast);
+        virtual void            visitInteger(const IntegerAST* ast);
+        virtual void            visitChar(const CharAST* ast);
+        virtual void            visitString(const StringAST* ast);
+        virtual void            visitBoolean(const BooleanAST* ast);
+    };
+
+    // ASTStaticVisitor does the same without virtual calls: Derived hides the
+    // visit functions it wants, and visit() calls them directly, so they can
+    // be inlined. every visit function returns ReturnType.
+    //
+    //     class NodeCounter : public ASTStaticVisitor<NodeCounter>
+    //     {
+    //     public:
+    //         void visitBase(const ExprAST* ast) { ++count_; visitChildren(ast); }
+    //         std::size_t count_ = 0;
+    //     };
+    template <typename Derived, typename ReturnType = void>
+    class ASTStaticVisitor
+    {
+    public:
+        ReturnType              visit(const ExprAST* ast);
+        // visit every child of ast in source order, the results are dropped.
+        void                    visitChildren(const ExprAST* ast);
+
+        // by default a node of any type goes to visitBase, and visitBase
+        // returns ReturnType().
+        ReturnType              visitNull() { return ReturnType(); }
+        ReturnType              visitBase(const ExprAST*) { return ReturnType(); }
+        ReturnType              visitProgram(const ProgramAST* ast) { return derived().visitBase(ast); }
+        ReturnType              visitBlock(const BlockAST* ast) { return derived().visitBase(ast); }
+        ReturnType              visitClassDeclaration(const ClassDeclarationAST* ast) { return derived().visitBase(ast); }
+        ReturnType              visitMainClass(const MainClassAST* ast) { return derived().visitBase(ast); }
+        ReturnType              visitMethodBody(const MethodBodyAST* ast) { return derived().visitBase(ast); }
+        ReturnType              visitMethodDeclaration(const MethodDeclarationAST* ast) { return derived().visitBase(ast); }
+        ReturnType              visitMethodCall(const MethodCallAST* ast) { return derived().visitBase(ast); }
+        ReturnType              visitVariableDeclaration(const VariableDeclarationAST* ast) { return derived().visitBase(ast); }
+        ReturnType              visitVariable(const VariableAST* ast) { return derived().visitBase(ast); }
+        ReturnType              visitArray(const ArrayAST* ast) { return derived().visitBase(ast); }
+        ReturnType              visitIfStatement(const IfStatementAST* ast) { return derived().visitBase(ast); }
+        ReturnType              visitWhileStatement(const WhileStatementAST* ast) { return derived().visitBase(ast); }
+        ReturnType              visitForStatement(const ForStatementAST* ast) { return derived().visitBase(ast); }
+        ReturnType              visitReturnStatement(const ReturnStatementAST* ast) { return derived().visitBase(ast); }
+        ReturnType              visitPrintStatement(const PrintStatementAST* ast) { return derived().visitBase(ast); }
+        ReturnType              visitNewStatement(const NewStatementAST* ast) { return derived().visitBase(ast); }
+        ReturnType              visitBinaryOpExpression(const BinaryOpExpressionAST* ast) { return derived().visitBase(ast); }
+        ReturnType              visitUnaryOpExpression(const UnaryOpExpressionAST* ast) { return derived().visitBase(ast); }
+        ReturnType              visitReal(const RealAST* ast) { return derived().visitBase(ast); }
+        ReturnType              visitInteger(const IntegerAST* ast) { return derived().visitBase(ast); }
+        ReturnType              visitChar(const CharAST* ast) { return derived().visitBase(ast); }
+        ReturnType              visitString(const StringAST* ast) { return derived().visitBase(ast); }
+        ReturnType              visitBoolean(const BooleanAST* ast) { return derived().visitBase(ast); }
+
+    private:
+        Derived&                derived() { return static_cast<Derived&>(*this); }
+        void                    visitElements(ExprASTArray asts);
+    };
+
+    template <typename Derived, typename ReturnType>
+    ReturnType ASTStaticVisitor<Derived, ReturnType>::visit(const ExprAST* ast)
+    {
+        if (ast == nullptr)
+        {
+            return derived().visitNull();
+        }
+
+        switch (ast->getID())
+        {
+            case ASTType::PROGRAM:
+                return derived().visitProgram(static_cast<const ProgramAST*>(ast));
+
+            case ASTType::BLOCK:
+                return derived().visitBlock(static_cast<const BlockAST*>(ast));
+
+            case ASTType::CLASSDECLARATION:
+                return derived().visitClassDeclaration(static_cast<const ClassDeclarationAST*>(ast));
+
+            case ASTType::MAINCLASS:
+                return derived().visitMainClass(static_cast<const MainClassAST*>(ast));
+
+            case ASTType::METHODBODY:
+                return derived().visitMethodBody(static_cast<const MethodBodyAST*>(ast));
+
+            case ASTType::METHODDECLARATION:
+                return derived().visitMethodDeclaration(static_cast<const MethodDeclarationAST*>(ast));
+
+            case ASTType::METHODCALL:
+                return derived().visitMethodCall(static_cast<const MethodCallAST*>(ast));
+
+            case ASTType::VARIABLEDECLARATION:
+                return derived().visitVariableDeclaration(static_cast<const VariableDeclarationAST*>(ast));
+
+            case ASTType::VARIABLE:
+                return derived().visitVariable(static_cast<const VariableAST*>(ast));
+
+            case ASTType::ARRAY:
+                return derived().visitArray(static_cast<const ArrayAST*>(ast));
+
+            case ASTType::IFSTATEMENT:
+                return derived().visitIfStatement(static_cast<const IfStatementAST*>(ast));
+
+            case ASTType::WHILESTATEMENT:
+                return derived().visitWhileStatement(static_cast<const WhileStatementAST*>(ast));
+
+            case ASTType::FORSTATEMENT:
+                return derived().visitForStatement(static_cast<const ForStatementAST*>(ast));
+
+            case ASTType::RETURNSTATEMENT:
+                return derived().visitReturnStatement(static_cast<const ReturnStatementAST*>(ast));
+
+            case ASTType::PRINTSTATEMENT:
+                return derived().visitPrintStatement(static_cast<const PrintStatementAST*>(ast));
+
+            case ASTType::NEWSTATEMENT:
+                return derived().visitNewStatement(static_cast<const NewStatementAST*>(ast));
+
+            case ASTType::BINARYOPEXPRESSION:
+                return derived().visitBinaryOpExpression(static_cast<const BinaryOpExpressionAST*>(ast));
+
+            case ASTType::UNARYOPEXPRESSION:
+                return derived().visitUnaryOpExpression(static_cast<const UnaryOpExpressionAST*>(ast));
+
+            case ASTType::REAL:
+                return derived().visitReal(static_cast<const RealAST*>(ast));
+
+            case ASTType::INTEGER:
+                return derived().visitInteger(static_cast<const IntegerAST*>(ast));
+
+            case ASTType::CHAR:
+                return derived().visitChar(static_cast<const CharAST*>(ast));
+
+            case ASTType::STRING:
+                return derived().visitString(static_cast<const StringAST*>(ast));
+
+            case ASTType::BOOLEAN:
+                return derived().visitBoolean(static_cast<const BooleanAST*>(ast));
+
+            default:
+                return derived().visitBase(ast);
+        }
+    }
+
+    template <typename Derived, typename ReturnType>
+    void ASTStaticVisitor<Derived, ReturnType>::visitElements(ExprASTArray asts)
+    {
+        for (const ExprAST* ast : asts)
+        {
+            visit(ast);
+        }
+    }
+
+    template <typename Derived, typename ReturnType>
+    void ASTStaticVisitor<Derived, ReturnType>::visitChildren(const ExprAST* ast)
+    {
+        if (ast == nullptr)
+        {
+            return;
+        }
+
+        switch (ast->getID())
+        {
+            case ASTType::PROGRAM:
+            {
+                const ProgramAST* node = static_cast<const ProgramAST*>(ast);
+                visitElements(node->getClasses());
+                break;
+            }
+
+            case ASTType::BLOCK:
+            {
+                const BlockAST* node = static_cast<const BlockAST*>(ast);
+                visitElements(node->getBlock());
+                break;
+            }
+
+            case ASTType::CLASSDECLARATION:
+            {
+                const ClassDeclarationAST* node = static_cast<const ClassDeclarationAST*>(ast);
+                visitElements(node->getMemberVariables());
+                visitElements(node->getMemberMemthods());
+                break;
+            }
+
+            case ASTType::MAINCLASS:
+            {
+                const MainClassAST* node = static_cast<const MainClassAST*>(ast);
+                visit(node->getMainMethod());
+                break;
+            }
+
+            case ASTType::METHODBODY:
+            {
+                const MethodBodyAST* node = static_cast<const MethodBodyAST*>(ast);
+                visitElements(node->getLocalVariables());
+                visitElements(node->getMethodBody());
+                visit(node->getReturnStatement());
+                break;
+            }
+
+            case ASTType::METHODDECLARATION:
+            {
+                const MethodDeclarationAST* node = static_cast<const MethodDeclarationAST*>(ast);
+                visitElements(node->getParameters());
+                visit(node->getBody());
+                break;
+            }
+
+            case ASTType::METHODCALL:
+            {
+                const MethodCallAST* node = static_cast<const MethodCallAST*>(ast);
+                visitElements(node->getParameters());
+                break;
+            }
+
+            case ASTType::ARRAY:
+            {
+                const ArrayAST* node = static_cast<const ArrayAST*>(ast);
+                visit(node->getIndex());
+                break;
+            }
+
+            case ASTType::IFSTATEMENT:
+            {
+                const IfStatementAST* node = static_cast<const IfStatementAST*>(ast);
+                visit(node->getCondition());
+                visit(node->getThenPart());
+                visit(node->getElsePart());
+                break;
+            }
+
+            case ASTType::WHILESTATEMENT:
+            {
+                const WhileStatementAST* node = static_cast<const WhileStatementAST*>(ast);
+                visit(node->getCondition());
+                visit(node->getBody());
+                break;
+            }
+
+            case ASTType::FORSTATEMENT:
+            {
+                const ForStatementAST* node = static_cast<const ForStatementAST*>(ast);
+                visit(node->getVariable());
+                visit(node->getCondition());
+                visit(node->getAction());
+                visit(node->getBody());
+                break;
+            }
+
+            case ASTType::RETURNSTATEMENT:
+            {
+                const ReturnStatementAST* node = static_cast<const ReturnStatementAST*>(ast);
+                visit(node->getReturnStatement());
+                break;
+            }
+
+            case ASTType::PRINTSTATEMENT:
+            {
+                const PrintStatementAST* node = static_cast<const PrintStatementAST*>(ast);
+                visit(node->getPrintStatement());
+                break;
+            }
+
+            case ASTType::NEWSTATEMENT:
+            {
+                const NewStatementAST* node = static_cast<const NewStatementAST*>(ast);
+                visit(node->getNewStatement());
+                break;
+            }
+
+            case ASTType::BINARYOPEXPRESSION:
+            {
+                const BinaryOpExpressionAST* node = static_cast<const BinaryOpExpressionAST*>(ast);
+                visit(node->getLhs());
+                visit(node->getRhs());
+                break;
+            }
+
+            case ASTType::UNARYOPEXPRESSION:
+            {
+                const UnaryOpExpressionAST* node = static_cast<const UnaryOpExpressionAST*>(ast);
+                visit(node->getExpression());
+                break;
+            }
+
+            default:
+                // variables, declarations and literals have no children.
+                break;
+        }
+    }
+
+    // NodeStack keeps the nodes forEachNode() has still to go to.
+    class NodeStack : public ASTStaticVisitor<NodeStack>
+    {
+    public:
+        void                    visitNull() {}
+        void                    visitBase(const ExprAST* ast) { nodes_.push_back(ast); }
+
+        std::vector<const ExprAST*> nodes_;
+    };
+
+    // call function on every node under root, root included, in no special
+    // order. the nodes wait on a stack of their own instead of the call
+    // stack, so a chain of many thousand operators is walked like a list.
+    template <typename Function>
+    void forEachNode(const ExprAST* root, Function function)
+    {
+        NodeStack stack;
+        stack.visit(root);
+
+        while (!stack.nodes_.empty())
+        {
+            const ExprAST* ast = stack.nodes_.back();
+            stack.nodes_.pop_back();
+            function(ast);
+            stack.visitChildren(ast);
+        }
+    }
+
+    // the number of nodes under root, root included.
+    std::size_t countNodes(const ExprAST* root);
+} // namespace MJava
+
+#endif // astvisitor.h
@@ -0,0 +1,121 @@
+// THIS FILE IS PART OF MJava-Compiler PROJECT
+// binaryast.h - binary file format of the flat syntax tree
+
+// Created by Li Taiji 2026-10-17
+// Copyright (c) 2026 Li Taiji All rights reserved
+
+#ifndef BINARYAST_H_
+#define BINARYAST_H_
+
+#include "arena.h"
+#include "flatast.h"
+#include "sourcebuffer.h"
+#include <cstddef>
+#include <cstdint>
+#include <ostream>
+#include <string>
+#include <string_view>
+
+namespace MJava
+{
+    // a binary ast file is the three arrays of FlatAST one after another, in
+    // the byte order of the machine that wrote it:
+    //
+    //     header          BinaryASTHeader, the number of items in every section
+    //     nodes           nodeCount FlatNode records of 32 bytes, node 0 is the root
+    //     lists           listCount 32-bit words, as FlatAST::lists()
+    //     string offsets  stringCount + 1 32-bit offsets into the string bytes
+    //     string bytes    stringBytes chars, string i is [offset i, offset i + 1)
+    //
+    // every section starts at a multiple of 4 bytes, so a reader can map the
+    // file and use the records where they are.
+    struct BinaryASTHeader
+    {
+        std::uint32_t       magic;
+        std::uint32_t       version;
+        std::uint32_t       nodeCount;
+        std::uint32_t       listCount;
+        std::uint32_t       stringCount;
+        std::uint32_t       stringBytes;
+        std::uint32_t       reserved[2];
+    };
+
+    static_assert(sizeof(BinaryASTHeader) == 32, "The header should keep the nodes 32-byte aligned.");
+
+    // BinaryAST writes a flat tree to a file and reads it back without
+    // building anything: the nodes, the lists and the names all point into
+    // the mapped file.
+    class BinaryAST
+    {
+      public:
+        // "MJAB", read as a little-endian word.
+        static constexpr std::uint32_t MAGIC = 0x42414A4D;
+        static constexpr std::uint32_t VERSION = 1;
+
+        BinaryAST();
+
+        BinaryAST(const BinaryAST&) = delete;
+        BinaryAST& operator=(const BinaryAST&) = delete;
+
+        static void         write(const FlatAST& tree, std::ostream& out);
+
+        // return false if the file can not be read or is not a binary ast of
+        // this version and byte order. every index, list and name of an
+        // opened file is checked, so the getters below never read past it.
+        bool                open(const std::string& fileName);
+
+        std::size_t         size() const;
+        bool                empty() const;
+        const FlatNode&     getNode(FlatIndex index) const;
+        ArrayRef<FlatNode>  nodes() const;
+        ArrayRef<FlatIndex> getList(std::uint32_t slot) const;
+        std::string_view    getName(Symbol symbol) const;
+
+      private:
+        bool                validate();
+        bool                validateStrings(std::uint32_t stringBytes) const;
+        bool                validateNodes() const;
+
+      private:
+        SourceBuffer            file_;
+        const FlatNode*         nodes_;
+        std::size_t             nodeCount_;
+        const std::uint32_t*    lists_;
+        std::size_t             listCount_;
+        const std::uint32_t*    stringOffsets_;
+        std::size_t             stringCount_;
+        const char*             strings_;
+    };
+
+    inline std::size_t BinaryAST::size() const
+    {
+        return nodeCount_;
+    }
+
+    inline bool BinaryAST::empty() const
+    {
+        return nodeCount_ == 0;
+    }
+
+    inline const FlatNode& BinaryAST::getNode(FlatIndex index) const
+    {
+        return nodes_[index];
+    }
+
+    inline ArrayRef<FlatNode> BinaryAST::nodes() const
+    {
+        return ArrayRef<FlatNode>(nodes_, nodeCount_);
+    }
+
+    inline ArrayRef<FlatIndex> BinaryAST::getList(std::uint32_t slot) const
+    {
+        return ArrayRef<FlatIndex>(lists_ + slot + 1, lists_[slot]);
+    }
+
+    inline std::string_view BinaryAST::getName(Symbol symbol) const
+    {
+        return std::string_view(strings_ + stringOffsets_[symbol], stringOffsets_[symbol + 1] - stringOffsets_[symbol]);
+    }
+} // namespace MJava
+
+#endif // binaryast.h
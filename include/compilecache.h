@@ -0,0 +1,72 @@
+// THIS FILE IS PART OF MJava-Compiler PROJECT
+// compilecache.h - outputs of earlier compilations, found by content hash
+
+// Created by Li Taiji 2026-10-17
+// Copyright (c) 2026 Li Taiji All rights reserved
+
+#ifndef COMPILECACHE_H_
+#define COMPILECACHE_H_
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+namespace MJava
+{
+    // bump it whenever the output for the same source may change.
+    inline constexpr std::string_view COMPILER_VERSION = "MJava-Compiler 2026.10.1";
+
+    // CompileCache keeps the output file of every successful compilation in a
+    // directory, named by a hash of the source bytes, the compiler version and
+    // the options that change the output, with the suffix ".mjc". the cache
+    // is limited in size: when it grows too big, the entries used longest ago
+    // are removed. any other file in the directory is never touched. a hit
+    // updates the time of the entry, so the time is the last use.
+    // fetch() and store() may be called from more than one thread.
+    class CompileCache
+    {
+      public:
+        struct Statistics
+        {
+            std::size_t     hits;
+            std::size_t     misses;
+            std::size_t     stores;
+            std::size_t     evictions;
+        };
+
+        // the directory is created if it does not exist.
+        CompileCache(const std::string& directory, std::uintmax_t maxBytes);
+
+        CompileCache(const CompileCache&) = delete;
+        CompileCache& operator=(const CompileCache&) = delete;
+
+        // 32 hex digits. options is anything else that changes the output.
+        static std::string  makeKey(const char* data, std::size_t size, std::string_view options);
+
+        // copy the cached output of key to outputFile, false on a miss.
+        bool                fetch(const std::string& key, const std::string& outputFile);
+        void                store(const std::string& key, const std::string& outputFile);
+
+        // remove the oldest entries until the cache is not bigger than the limit.
+        void                evict();
+
+        Statistics          getStatistics() const;
+
+      private:
+        std::string         entryPath(const std::string& key) const;
+        // true for the name of an entry, not for a temporary file or a file of the user.
+        static bool         isEntryName(const std::string& fileName);
+
+      private:
+        std::string                 directory_;
+        std::uintmax_t              maxBytes_;
+        std::atomic<std::size_t>    hits_;
+        std::atomic<std::size_t>    misses_;
+        std::atomic<std::size_t>    stores_;
+        std::atomic<std::size_t>    evictions_;
+    };
+} // namespace MJava
+
+#endif // compilecache.h
@@ -0,0 +1,90 @@
+// THIS FILE IS PART OF MJava-Compiler PROJECT
+// compileserver.h - answer compile requests on a Unix domain socket
+
+// Created by Li Taiji 2026-10-17
+// Copyright (c) 2026 Li Taiji All rights reserved
+
+#ifndef COMPILESERVER_H_
+#define COMPILESERVER_H_
+
+#include "serverprotocol.h"
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace MJava
+{
+    // CompileServer is the long running form of the lexer and the parser. it
+    // answers the requests of serverprotocol.h, every request on a thread of
+    // its pool, so a request pays neither the start of a process nor cold
+    // caches. a connection holds no thread until a whole request of it has
+    // arrived, it waits in poll() for that. the answers for the sources seen last are kept in memory,
+    // and a source which has not changed is answered from there.
+    class CompileServer
+    {
+      public:
+        struct Options
+        {
+            std::string         socketPath = getDefaultServerSocket();
+            // number of threads, 0 is one per hardware thread.
+            std::size_t         threads = 0;
+            // the size of the answers kept in memory, 0 keeps none.
+            std::uintmax_t      cacheSize = 256 * 1024 * 1024;
+        };
+
+        explicit        CompileServer(const Options& options);
+                        CompileServer(const CompileServer&) = delete;
+        CompileServer&  operator=(const CompileServer&) = delete;
+
+        // answer requests until a shutdown request or stop(). false if the
+        // socket can not be set up, or another server is listening on it.
+        bool            run();
+        // may be called from any thread. the requests being answered are finished.
+        void            stop();
+
+      private:
+        // accept a new connection, or refuse it if there are too many.
+        void            acceptConnection(std::vector<std::unique_ptr<Connection>>& idle);
+        // read one request of the connection and answer it, then give the
+        // connection back to run() to wait for the next one.
+        void            serveRequest(Connection* connection);
+        // close a connection of the client or of the server.
+        void            closeConnection(std::unique_ptr<Connection> connection);
+        // wake run() up from poll().
+        void            wakeUp();
+        Message         answer(const Message& request);
+        Message         compile(const Message& request);
+        // a response with status failed and the reason as its only error.
+        static Message  makeFailure(const std::string& reason);
+
+        bool            findAnswer(const std::string& key, Message& response);
+        void            keepAnswer(const std::string& key, const Message& response);
+
+      private:
+        using AnswerList = std::list<std::pair<std::string, Message>>;
+
+        Options                                             options_;
+        int                                                 listenFd_;
+        std::atomic<bool>                                   stopping_;
+        // the connections whose request has been answered, run() waits for
+        // their next request.
+        std::mutex                                          connectionMutex_;
+        std::vector<std::unique_ptr<Connection>>            answered_;
+        std::size_t                                         connectionCount_;
+        // a byte written here wakes run() up.
+        int                                                 wakeFds_[2];
+        // the answers, the one used last at the front.
+        std::mutex                                          cacheMutex_;
+        AnswerList                                          answers_;
+        std::unordered_map<std::string, AnswerList::iterator> answerIndex_;
+        std::uintmax_t                                      cacheBytes_;
+    };
+} // namespace MJava
+
+#endif // compileserver.h
@@ -0,0 +1,143 @@
+// THIS FILE IS PART OF MJava-Compiler PROJECT
+// diagnostic.h - the errors of one compilation, written at once
+
+// Created by Li Taiji 2026-10-17
+// Copyright (c) 2026 Li Taiji All rights reserved
+
+#ifndef DIAGNOSTIC_H_
+#define DIAGNOSTIC_H_
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+namespace MJava
+{
+    enum class Severity
+    {
+        ERROR,
+        WARNING
+    };
+
+    enum class DiagnosticKind
+    {
+        TOKEN,
+        SYNTAX,
+        FILE
+    };
+
+    struct Diagnostic
+    {
+        Severity        severity;
+        DiagnosticKind  kind;
+        // a file error has no place, its file is empty and its line and column are 0.
+        std::string     file;
+        int             line;
+        int             column;
+        std::string     message;
+
+        // the line the compiler has always written, without the newline.
+        std::string     toString() const;
+    };
+
+    // DiagnosticEngine collects the diagnostics of one compilation instead of
+    // writing every one as it comes, and writes them in one piece at the end,
+    // in the order of their places in the source. a diagnostic at the same
+    // place as the one before it is most likely caused by it, and is dropped
+    // unless deduplicate is off. only the first maxErrors diagnostics of the
+    // source are kept, the others are only counted. the limit trims what is
+    // written, not the work: the whole file is still scanned and parsed, as
+    // its tree is written anyway and the count of the others is exact.
+    class DiagnosticEngine
+    {
+      public:
+        enum class Format
+        {
+            // one line per diagnostic, as the compiler has always written them.
+            TEXT,
+            // one line of json per compilation.
+            JSON
+        };
+
+        struct Options
+        {
+            // 0 is no limit.
+            std::size_t     maxErrors = 0;
+            bool            deduplicate = true;
+            Format          format = Format::TEXT;
+        };
+
+        // fileName is the source the diagnostics are about, for the json output.
+                            DiagnosticEngine(const std::string& fileName, const Options& options);
+                            DiagnosticEngine(const DiagnosticEngine&) = delete;
+        DiagnosticEngine&   operator=(const DiagnosticEngine&) = delete;
+
+        void                report(Diagnostic diagnostic);
+
+        const std::vector<Diagnostic>& getDiagnostics() const;
+        // the diagnostics kept, and the ones dropped as duplicates or after the limit.
+        std::size_t         getCount() const;
+        std::size_t         getDuplicateCount() const;
+        std::size_t         getOmittedCount() const;
+
+        // all the diagnostics in the format of the options, empty if there are none.
+        std::string         format() const;
+        // write format() to std::cerr in one piece, and forget the diagnostics.
+        void                flush();
+
+      private:
+        std::string                 fileName_;
+        Options                     options_;
+        std::vector<Diagnostic>     diagnostics_;
+        std::size_t                 duplicates_;
+        std::size_t                 omitted_;
+    };
+
+    inline const std::vector<Diagnostic>& DiagnosticEngine::getDiagnostics() const
+    {
+        return diagnostics_;
+    }
+
+    inline std::size_t DiagnosticEngine::getCount() const
+    {
+        return diagnostics_.size();
+    }
+
+    inline std::size_t DiagnosticEngine::getDuplicateCount() const
+    {
+        return duplicates_;
+    }
+
+    inline std::size_t DiagnosticEngine::getOmittedCount() const
+    {
+        return omitted_;
+    }
+
+    // while a DiagnosticScope lives, the diagnostics of its thread go to its
+    // engine. scopes nest, without any the diagnostics are written to
+    // std::cerr one by one.
+    class DiagnosticScope
+    {
+      public:
+        explicit            DiagnosticScope(DiagnosticEngine& engine);
+                            ~DiagnosticScope();
+                            DiagnosticScope(const DiagnosticScope&) = delete;
+        DiagnosticScope&    operator=(const DiagnosticScope&) = delete;
+
+        DiagnosticEngine&   getEngine() const;
+
+      private:
+        DiagnosticEngine&   engine_;
+        DiagnosticScope*    previous_;
+    };
+
+    inline DiagnosticEngine& DiagnosticScope::getEngine() const
+    {
+        return engine_;
+    }
+
+    // to the engine of the calling thread, or straight to std::cerr.
+    void reportDiagnostic(Diagnostic diagnostic);
+} // namespace MJava
+
+#endif // diagnostic.h
@@ -8,25 +8,198 @@
 #define DICTIONARY_H_
 
 #include "token.h"
-#include <map>
-#include <string>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
 #include <tuple>
 
 namespace MJava
 {
+    // four token property: token name, token value, token type, precedence.
+    // the precedence is kept in the tokens and written by the lexer, the
+    // parser has its own table of binding powers in parser.cpp.
+    struct DictionaryEntry
+    {
+        std::string_view    name;
+        TokenValue          value;
+        TokenType           type;
+        int                 precedence;
+    };
+
+    // all the keywords, operators and symbols of MJava. the set is fixed,
+    // so we find a perfect hash for it when compiling.
+    inline constexpr DictionaryEntry DICTIONARY_ENTRIES[] =
+    {
+        {"=",                   TokenValue::ASSIGN,            TokenType::OPERATOR, 0},
+        {"<",                   TokenValue::LT,                TokenType::OPERATOR, 2},
+        {"+",                   TokenValue::ADD,               TokenType::OPERATOR, 10},
+        {"-",                   TokenValue::SUB,               TokenType::OPERATOR, 10},
+        {"*",                   TokenValue::MULTI,             TokenType::OPERATOR, 20},
+        {"&&",                  TokenValue::AND,               TokenType::OPERATOR, 20},
+        {"!",                   TokenValue::NOT,               TokenType::OPERATOR, 40},
+        {".",                   TokenValue::DOT,               TokenType::OPERATOR, 60},
+        {"(",                   TokenValue::LPAREN,            TokenType::DELIMITER, -1},
+        {")",                   TokenValue::RPAREN,            TokenType::DELIMITER, -1},
+        {"[",                   TokenValue::LBRACK,            TokenType::DELIMITER, -1},
+        {"]",                   TokenValue::RBRACK,            TokenType::DELIMITER, -1},
+        {"{",                   TokenValue::LBRACE,            TokenType::DELIMITER, -1},
+        {"}",                   TokenValue::RBRACE,            TokenType::DELIMITER, -1},
+        {",",                   TokenValue::COMMA,             TokenType::DELIMITER, -1},
+        {";",                   TokenValue::SEMICOLON,         TokenType::DELIMITER, -1},
+        {"class",               TokenValue::CLASS,             TokenType::KEYWORD,  -1},
+        {"public",              TokenValue::PUBLIC,            TokenType::KEYWORD,  -1},
+        {"static",              TokenValue::STATIC,            TokenType::KEYWORD,  -1},
+        {"void",                TokenValue::VOID,              TokenType::KEYWORD,  -1},
+        {"main",                TokenValue::MAIN,              TokenType::KEYWORD,  -1},
+        {"extends",             TokenValue::EXTENDS,           TokenType::KEYWORD,  -1},
+        {"return",              TokenValue::RETURN,            TokenType::KEYWORD,  -1},
+        {"if",                  TokenValue::IF,                TokenType::KEYWORD,  -1},
+        {"else",                TokenValue::ELSE,              TokenType::KEYWORD,  -1},
+        {"while",               TokenValue::WHILE,             TokenType::KEYWORD,  -1},
+        {"for",                 TokenValue::FOR,               TokenType::KEYWORD,  -1},
+        {"System.out.println",  TokenValue::PRINT,             TokenType::KEYWORD,  -1},
+        {"length",              TokenValue::LENGTH,            TokenType::KEYWORD,  -1},
+        {"this",                TokenValue::THIS,              TokenType::KEYWORD,  -1},
+        {"new",                 TokenValue::NEW,               TokenType::KEYWORD,  -1},
+        {"true",                TokenValue::TRUE,              TokenType::BOOLEAN,  -1},
+        {"false",               TokenValue::FALSE,             TokenType::BOOLEAN,  -1},
+        {"double",              TokenValue::DOUBLE,            TokenType::TYPE,  -1},
+        {"int",                 TokenValue::INT,               TokenType::TYPE,  -1},
+        {"char",                TokenValue::CHAR,              TokenType::TYPE,  -1},
+        {"String",              TokenValue::STRING,            TokenType::TYPE,  -1},
+        {"boolean",             TokenValue::BOOL,              TokenType::TYPE,  -1},
+    };
+
+    inline constexpr std::size_t DICTIONARY_SIZE = sizeof(DICTIONARY_ENTRIES) / sizeof(DICTIONARY_ENTRIES[0]);
+    inline constexpr std::size_t DICTIONARY_TABLE_SIZE = 128;
+
+    // the length, the first and the last char are enough to tell all the
+    // entries apart, the seed only spreads them over the table.
+    constexpr std::size_t dictionaryHash(std::string_view name, std::uint32_t seed)
+    {
+        std::uint32_t hash = static_cast<unsigned char>(name[0]) * seed
+                           + static_cast<unsigned char>(name[name.size() - 1]);
+        hash = hash * seed + static_cast<std::uint32_t>(name.size());
+
+        return (hash >> 16) % DICTIONARY_TABLE_SIZE;
+    }
+
+    // try seeds one by one until no two entries have the same hash.
+    constexpr std::uint32_t findDictionarySeed()
+    {
+        for (std::uint32_t seed = 1; seed < 100000; seed++)
+        {
+            bool used[DICTIONARY_TABLE_SIZE] = {};
+            bool collided = false;
+
+            for (std::size_t i = 0; i < DICTIONARY_SIZE && !collided; i++)
+            {
+                std::size_t hash = dictionaryHash(DICTIONARY_ENTRIES[i].name, seed);
+                collided = used[hash];
+                used[hash] = true;
+            }
+
+            if (!collided)
+            {
+                return seed;
+            }
+        }
+
+        return 0;
+    }
+
+    inline constexpr std::uint32_t DICTIONARY_SEED = findDictionarySeed();
+    static_assert(DICTIONARY_SEED != 0, "Can not find a perfect hash for the dictionary.");
+
+    // slot of the hash table is the index of the entry plus one, 0 is empty.
+    constexpr std::array<std::uint8_t, DICTIONARY_TABLE_SIZE> makeDictionaryTable()
+    {
+        std::array<std::uint8_t, DICTIONARY_TABLE_SIZE> table = {};
+
+        for (std::size_t i = 0; i < DICTIONARY_SIZE; i++)
+        {
+            table[dictionaryHash(DICTIONARY_ENTRIES[i].name, DICTIONARY_SEED)] = static_cast<std::uint8_t>(i + 1);
+        }
+
+        return table;
+    }
+
+    inline constexpr std::array<std::uint8_t, DICTIONARY_TABLE_SIZE> DICTIONARY_TABLE = makeDictionaryTable();
+
+    inline constexpr std::size_t TOKEN_VALUE_COUNT = static_cast<std::size_t>(TokenValue::UNRESERVED) + 1;
+
+    // the other way round: the spelling of every token value, empty for UNRESERVED.
+    constexpr std::array<std::string_view, TOKEN_VALUE_COUNT> makeSpellingTable()
+    {
+        std::array<std::string_view, TOKEN_VALUE_COUNT> table = {};
+
+        for (std::size_t i = 0; i < DICTIONARY_SIZE; i++)
+        {
+            table[static_cast<std::size_t>(DICTIONARY_ENTRIES[i].value)] = DICTIONARY_ENTRIES[i].name;
+        }
+
+        return table;
+    }
+
+    inline constexpr std::array<std::string_view, TOKEN_VALUE_COUNT> SPELLING_TABLE = makeSpellingTable();
+
     class Dictionary
     {
       public:
-        Dictionary();
-        std::tuple<TokenType, TokenValue, int> lookup(const std::string& name) const;
-        bool haveToken(const std::string& name) const;
-      private:
-        void addToken(const std::string& name, std::tuple<TokenValue, TokenType, int> tokenMeta);
-
-      private:
-        // four token property: token name, token value, token type, precedence.
-        std::map<std::string, std::tuple<TokenValue, TokenType, int>> dictionary_;
+        // return nullptr if the name is not a keyword, operator or symbol.
+        static constexpr const DictionaryEntry* find(std::string_view name);
+        // "&&" for TokenValue::AND, and so on.
+        static constexpr std::string_view spell(TokenValue value);
+
+        std::tuple<TokenType, TokenValue, int> lookup(std::string_view name) const;
+        bool haveToken(std::string_view name) const;
     };
+
+    constexpr const DictionaryEntry* Dictionary::find(std::string_view name)
+    {
+        if (name.empty())
+        {
+            return nullptr;
+        }
+
+        std::uint8_t slot = DICTIONARY_TABLE[dictionaryHash(name, DICTIONARY_SEED)];
+
+        if (slot == 0 || DICTIONARY_ENTRIES[slot - 1].name != name)
+        {
+            return nullptr;
+        }
+
+        return &DICTIONARY_ENTRIES[slot - 1];
+    }
+
+    constexpr std::string_view Dictionary::spell(TokenValue value)
+    {
+        return SPELLING_TABLE[static_cast<std::size_t>(value)];
+    }
+
+    // if we can find it in the dictionary, we change the token type
+    inline std::tuple<TokenType, TokenValue, int> Dictionary::lookup(std::string_view name) const
+    {
+        const DictionaryEntry* entry = find(name);
+
+        if (entry == nullptr)
+        {
+            return std::make_tuple(TokenType::IDENTIFIER, TokenValue::UNRESERVED, -1);
+        }
+
+        return std::make_tuple(entry->type, entry->value, entry->precedence);
+    }
+
+    inline bool Dictionary::haveToken(std::string_view name) const
+    {
+        return find(name) != nullptr;
+    }
+
+    static_assert(Dictionary::find("System.out.println")->value == TokenValue::PRINT, "Dictionary hash is broken.");
+    static_assert(Dictionary::find("&&")->value == TokenValue::AND, "Dictionary hash is broken.");
+    static_assert(Dictionary::find("System") == nullptr, "Dictionary hash is broken.");
+    static_assert(Dictionary::spell(TokenValue::AND) == "&&", "Dictionary spelling is broken.");
 } // namespace MJava
 
-#endif // dictionary.h
\ No newline at end of file
+#endif // dictionary.h
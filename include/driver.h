@@ -0,0 +1,122 @@
+// THIS FILE IS PART OF MJava-Compiler PROJECT
+// driver.h - compile many source files at once
+
+// Created by Li Taiji 2026-10-17
+// Copyright (c) 2026 Li Taiji All rights reserved
+
+#ifndef DRIVER_H_
+#define DRIVER_H_
+
+#include "compilecache.h"
+#include "diagnostic.h"
+#include "scanner.h"
+#include "sourcebuffer.h"
+#include "statistics.h"
+#include "threadpool.h"
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <ostream>
+#include <string>
+#include <vector>
+
+namespace MJava
+{
+    class Parser;
+
+    // one source file and the file its tokens or syntax tree are written to.
+    struct CompileJob
+    {
+        std::string     sourceFile;
+        std::string     outputFile;
+    };
+
+    // Driver runs the lexer or the parser, whichever this program is built
+    // as, over a list of source files. every file gets its own scanner and
+    // parser, so the files are compiled on a thread pool at the same time.
+    class Driver
+    {
+      public:
+        struct Options
+        {
+            Scanner::Engine     engine = Scanner::Engine::HAND_WRITTEN;
+            bool                batch = false;
+            bool                compact = false;
+            // write the syntax tree in the binary format instead of json.
+            bool                binary = false;
+            // parse the classes of one file on all the threads, the files
+            // one after another. the parser scans the whole file first.
+            bool                parallelClasses = false;
+            // number of threads, 0 is one per hardware thread.
+            std::size_t         threads = 0;
+            // keep the outputs in this directory and reuse them for the same
+            // source, no cache if it is empty.
+            std::string         cacheDirectory;
+            std::uintmax_t      cacheSize = 256 * 1024 * 1024;
+            // measure every phase of every file.
+            bool                statistics = false;
+            // read the perf_event_open counters around every phase too.
+            bool                perfCounters = false;
+            // write the phases as chrome trace events to this file, no trace if it is empty.
+            std::string         traceFile;
+            // the errors of every file are collected and written when it is done.
+            DiagnosticEngine::Options diagnostics;
+        };
+
+        explicit        Driver(const Options& options);
+
+        void            addJob(const std::string& sourceFile, const std::string& outputFile);
+        // a response file has one "<Source File> [Output File]" per line.
+        // empty lines and lines starting with '#' are skipped.
+        // return false if the file can not be read.
+        bool            readResponseFile(const std::string& fileName);
+        std::size_t     getJobCount() const;
+
+        // compile all the jobs and return how many of them failed.
+        std::size_t     run();
+        // all zero without a cache.
+        CompileCache::Statistics getCacheStatistics() const;
+        // null unless the options ask for statistics or a trace.
+        const CompileStatistics* getStatistics() const;
+
+        // the source file name with ".lex" or ".ast" appended.
+        static std::string defaultOutputFile(const std::string& sourceFile);
+
+        // write the tokens or the syntax tree of the source of scanner to out,
+        // as it is written to an output file. return false if the source has
+        // errors. the classes are parsed on pool if it is not null.
+        bool            compileSource(Scanner& scanner, std::ostream& out, ThreadPool* pool = nullptr) const;
+
+      private:
+#if defined(PARSER)
+        void            writeTree(const Parser& parser, std::ostream& out) const;
+#endif
+        std::size_t     compileAll();
+        // look in the cache first, and keep the output there if it is new.
+        bool            compile(const CompileJob& job, ThreadPool* pool) const;
+        // return false if the output can not be created or the source has errors.
+        // source is the file opened already, or null to let the scanner open it.
+        bool            compileSource(const CompileJob& job, SourceBuffer* source, ThreadPool* pool) const;
+        // the options which change the output, a part of the cache key. the
+        // lexer writes the file name in every token, so it is one of them.
+        std::string     getOutputOptions(const std::string& sourceFile) const;
+
+      private:
+        Options                         options_;
+        std::vector<CompileJob>         jobs_;
+        std::unique_ptr<CompileCache>   cache_;
+        std::unique_ptr<CompileStatistics> statistics_;
+    };
+
+    inline std::size_t Driver::getJobCount() const
+    {
+        return jobs_.size();
+    }
+
+    inline const CompileStatistics* Driver::getStatistics() const
+    {
+        return statistics_.get();
+    }
+} // namespace MJava
+
+#endif // driver.h
@@ -11,8 +11,12 @@
 
 namespace MJava
 {
-    extern void errorToken(const std::string& msg);
-    extern void errorSyntax(const std::string& msg);
+    class TokenLocation;
+
+    // the diagnostics go to the engine of the calling thread, see diagnostic.h.
+    extern void errorToken(const TokenLocation& loc, const std::string& msg);
+    extern void errorSyntax(const TokenLocation& loc, const std::string& msg);
+    extern void errorFile(const std::string& msg);
 } // namespace MJava
 
 #endif // error.h
@@ -0,0 +1,161 @@
+// THIS FILE IS PART OF MJava-Compiler PROJECT
+// flatast.h - abstract syntax tree in one flat array
+
+// Created by Li Taiji 2026-10-17
+// Copyright (c) 2026 Li Taiji All rights reserved
+
+#ifndef FLATAST_H_
+#define FLATAST_H_
+
+#include "arena.h"
+#include "ast.h"
+#include "symboltable.h"
+#include "token.h"
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+#include <vector>
+
+namespace MJava
+{
+    // a node is found by its index in the node array.
+    using FlatIndex = std::uint32_t;
+
+    // the index of a missing child.
+    inline constexpr FlatIndex FLAT_NULL = 0xFFFFFFFF;
+
+    // one node in 32 bytes. what the names and the slots hold depends on
+    // the type of the node:
+    //
+    //     PROGRAM              slot 0: list of classes
+    //     BLOCK                slot 0: list of statements
+    //     CLASSDECLARATION     name 0: class, name 1: base class, slot 0: list of variables, slot 1: list of methods
+    //     MAINCLASS            name 0: class, slot 0: main method
+    //     METHODBODY           slot 0: list of variables, slot 1: list of statements, slot 2: return statement
+    //     METHODDECLARATION    name 0: return type, name 1: method, slot 0: list of attribute names,
+    //                          slot 1: list of parameters, slot 2: body
+    //     METHODCALL           name 0: method, slot 0: list of parameters
+    //     VARIABLEDECLARATION  name 0: type, name 1: variable
+    //     VARIABLE             name 0: variable
+    //     ARRAY                name 0: array, slot 0: index
+    //     IFSTATEMENT          slot 0: condition, slot 1: then part, slot 2: else part
+    //     WHILESTATEMENT       slot 0: condition, slot 1: body
+    //     FORSTATEMENT         slot 0: variable, slot 1: condition, slot 2: action, slot 3: body
+    //     RETURNSTATEMENT      slot 0: expression
+    //     PRINTSTATEMENT       slot 0: expression
+    //     NEWSTATEMENT         name 0: type, slot 0: length or constructor call
+    //     BINARYOPEXPRESSION   operator, slot 0: lhs, slot 1: rhs
+    //     UNARYOPEXPRESSION    operator, slot 0: expression
+    //     REAL                 slot 0 and 1: the bits of the double
+    //     INTEGER, CHAR, BOOLEAN  slot 0: the value
+    //     STRING               name 0: the string
+    //
+    // a child slot holds a node index or FLAT_NULL, a list slot holds the
+    // position of the list in the list array.
+    struct FlatNode
+    {
+        std::uint8_t        type;
+        std::uint8_t        op;
+        std::uint16_t       reserved;
+        std::uint32_t       offset;
+        Symbol              names[2];
+        std::uint32_t       slots[4];
+
+        ASTType             getType() const { return static_cast<ASTType>(type); }
+        TokenValue          getOperator() const { return static_cast<TokenValue>(op); }
+        std::uint32_t       getOffset() const { return offset; }
+        FlatIndex           getChild(std::size_t slot) const { return slots[slot]; }
+
+        int                 getInteger() const { return static_cast<int>(slots[0]); }
+        char                getChar() const { return static_cast<char>(slots[0]); }
+        bool                getBoolean() const { return slots[0] != 0; }
+        double              getReal() const;
+    };
+
+    static_assert(sizeof(FlatNode) == 32, "A flat node should be 32 bytes.");
+
+    // FlatAST is the same tree as the ExprAST nodes in three arrays: the nodes
+    // in preorder, so a parent always comes before its children, the lists of
+    // children, each one its length followed by the node indexes, and the
+    // interned names. a pass that does not care about the shape of the tree,
+    // like counting the method calls, is one linear scan over nodes().
+    class FlatAST
+    {
+      public:
+        // convert the tree under root, which may be null.
+        explicit            FlatAST(const ExprAST* root);
+                            FlatAST(const FlatAST&) = delete;
+        FlatAST&            operator=(const FlatAST&) = delete;
+
+        // the root is node 0, if there is any node.
+        std::size_t         size() const;
+        bool                empty() const;
+        const FlatNode&     getNode(FlatIndex index) const;
+        const std::vector<FlatNode>& nodes() const;
+
+        ArrayRef<FlatIndex> getList(std::uint32_t slot) const;
+        std::string_view    getName(Symbol symbol) const;
+        FileID              getFileID() const;
+
+        // the raw arrays, for writing them out.
+        const std::vector<std::uint32_t>& lists() const;
+        const SymbolTable&  getSymbolTable() const;
+
+      private:
+        class Builder;
+
+      private:
+        FileID                      fileId_;
+        std::vector<FlatNode>       nodes_;
+        // list 0 is the empty list.
+        std::vector<std::uint32_t>  lists_;
+        SymbolTable                 names_;
+    };
+
+    inline std::size_t FlatAST::size() const
+    {
+        return nodes_.size();
+    }
+
+    inline bool FlatAST::empty() const
+    {
+        return nodes_.empty();
+    }
+
+    inline const FlatNode& FlatAST::getNode(FlatIndex index) const
+    {
+        return nodes_[index];
+    }
+
+    inline const std::vector<FlatNode>& FlatAST::nodes() const
+    {
+        return nodes_;
+    }
+
+    inline ArrayRef<FlatIndex> FlatAST::getList(std::uint32_t slot) const
+    {
+        return ArrayRef<FlatIndex>(lists_.data() + slot + 1, lists_[slot]);
+    }
+
+    inline std::string_view FlatAST::getName(Symbol symbol) const
+    {
+        return names_.getName(symbol);
+    }
+
+    inline FileID FlatAST::getFileID() const
+    {
+        return fileId_;
+    }
+
+    inline const std::vector<std::uint32_t>& FlatAST::lists() const
+    {
+        return lists_;
+    }
+
+    inline const SymbolTable& FlatAST::getSymbolTable() const
+    {
+        return names_;
+    }
+} // namespace MJava
+
+#endif // flatast.h
@@ -0,0 +1,145 @@
+// THIS FILE IS PART OF MJava-Compiler PROJECT
+// incrementalparser.h - scan and parse again only what an edit touches
+
+// Created by Li Taiji 2026-10-17
+// Copyright (c) 2026 Li Taiji All rights reserved
+
+#ifndef INCREMENTALPARSER_H_
+#define INCREMENTALPARSER_H_
+
+#include "arena.h"
+#include "ast.h"
+#include "scanner.h"
+#include "tokenbuffer.h"
+#include <cstddef>
+#include <cstdint>
+#include <ostream>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace MJava
+{
+    // IncrementalParser keeps the text, the tokens and the tree of a file
+    // which is being edited, like the buffer of an editor. after an edit it
+    // scans again from the token before the Scanner::MAX_LOOKAHEAD chars
+    // before the edit until a token starts where an old token started, and
+    // parses again only the method or the classes with changed tokens. every
+    // class has its own arena, so the trees of the other classes are kept.
+    // an edit only counts how far the classes after it have moved, their
+    // tokens and nodes are moved when they are parsed again or read, so an
+    // edit does not touch the rest of the file.
+    //
+    // the tree is the same as the one of Parser::parse() for the new text.
+    // a broken class which runs into the next class is parsed with it. token
+    // errors are reported when they are scanned, syntax errors when their
+    // class is parsed.
+    class IncrementalParser
+    {
+      public:
+        // how much the last edit scanned and parsed.
+        struct Statistics
+        {
+            std::size_t     tokensScanned;
+            std::size_t     classesParsed;
+            std::size_t     methodsParsed;
+        };
+
+                        IncrementalParser(const std::string& fileName, std::string_view source,
+                                          Scanner::Engine engine = Scanner::Engine::HAND_WRITTEN);
+                        IncrementalParser(const IncrementalParser&) = delete;
+        IncrementalParser& operator=(const IncrementalParser&) = delete;
+
+        // replace length chars at offset by text, and scan and parse again
+        // what it has changed. an edit out of the text is cut to its end.
+        void            edit(std::size_t offset, std::size_t length, std::string_view text);
+
+        // the tree of the current text, the classes moved by the edits since
+        // the last call are moved first.
+        ProgramASTPtr   getProgram();
+        std::string_view getSource() const;
+        // the tokens of the whole text, they refer to getSource().
+        const TokenBuffer& getTokens();
+        // true if a class of the current tree has a syntax error.
+        bool            getErrorFlag() const;
+        const Statistics& getStatistics() const;
+        void            writeJSON(std::ostream& out, bool pretty = true);
+
+      private:
+        // the tokens from a "class" outside any braces to the next one, the
+        // first segment starts at the first token and holds the main class.
+        // the segments cover all the tokens but END_OF_FILE.
+        struct Segment
+        {
+            std::size_t         begin;
+            std::size_t         end;
+            VecExprASTPtr       classes;
+            // the arena of the class, and one more for every method parsed again.
+            std::vector<Arena>  arenas;
+            std::size_t         parsedBytes;
+            bool                errorFlag;
+            // the offsets of the tokens and the nodes are moved chars behind
+            // the text, and the names of the tokens are still in the buffer
+            // text of capacity chars, at their offsets. update() moves them.
+            const char*         text;
+            std::size_t         capacity;
+            std::ptrdiff_t      moved;
+        };
+
+        // the tokens [first, first + removed) have been replaced by inserted new tokens.
+        struct TokenEdit
+        {
+            std::size_t     first;
+            std::size_t     removed;
+            std::size_t     inserted;
+        };
+
+        TokenEdit       rescan(std::size_t offset, std::size_t length, std::size_t inserted);
+        // move the kept tokens of the segments [first, last], which have
+        // tokens changed by edit, and count the move of the segments after.
+        void            moveSegments(std::size_t first, std::size_t last, const TokenEdit& edit, std::ptrdiff_t delta,
+                                     const char* oldText, std::size_t oldCapacity);
+        // parse the segments [first, last] again, and more around them if
+        // the edit has changed where the classes start.
+        void            parseSegments(std::size_t first, std::size_t last);
+        // parse the tokens [begin, end) of segment, false if the parser has
+        // gone on into the class at end.
+        bool            parseSegment(Segment& segment, bool mainClass);
+        // parse only the method the changed tokens are in, false if they are
+        // not in one method or the method has an error.
+        bool            parseMethod(Segment& segment, const TokenEdit& edit, std::size_t offset, std::ptrdiff_t delta);
+        void            buildProgram();
+        std::size_t     findSegment(std::size_t tokenIndex) const;
+        // move the tokens and the nodes of segment to the current text.
+        void            update(Segment& segment);
+        // the offset of the token at index, and the first token from begin
+        // on which starts at or after offset, END_OF_FILE if none. they look
+        // through the moves of the segments which have not been updated.
+        std::uint32_t   getOffset(std::size_t index) const;
+        std::size_t     lowerBound(std::uint32_t offset, std::size_t begin) const;
+        // move the nodes at or after offset from by delta chars.
+        static void     moveTree(const ExprAST* ast, std::size_t from, std::ptrdiff_t delta);
+
+      private:
+        std::string             source_;
+        Scanner                 scanner_;
+        TokenBuffer             tokens_;
+        std::vector<Segment>    segments_;
+        // only the program node, made again after every edit when it is asked for.
+        Arena                   arena_;
+        ProgramASTPtr           program_;
+        Statistics              statistics_;
+    };
+
+    inline std::string_view IncrementalParser::getSource() const
+    {
+        return source_;
+    }
+
+    inline const IncrementalParser::Statistics& IncrementalParser::getStatistics() const
+    {
+        return statistics_;
+    }
+} // namespace MJava
+
+#endif // incrementalparser.h
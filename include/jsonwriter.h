@@ -0,0 +1,73 @@
+// THIS FILE IS PART OF MJava-Compiler PROJECT
+// jsonwriter.h - streaming json writer
+
+// Created by Li Taiji 2026-10-17
+// Copyright (c) 2026 Li Taiji All rights reserved
+
+#ifndef JSONWRITER_H_
+#define JSONWRITER_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <ostream>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace MJava
+{
+    // JSONWriter writes json to a stream while the caller walks its data, so
+    // no part of the document is ever built as a string. the output is kept
+    // in a buffer and written to the stream in big blocks.
+    // pretty output puts every member and element on its own line, indented
+    // by four spaces. compact output has no spaces and no newlines at all.
+    class JSONWriter
+    {
+      public:
+        explicit        JSONWriter(std::ostream& out, bool pretty = true);
+                        ~JSONWriter();
+                        JSONWriter(const JSONWriter&) = delete;
+        JSONWriter&     operator=(const JSONWriter&) = delete;
+
+        void            beginObject();
+        void            endObject();
+        void            beginArray();
+        void            endArray();
+
+        // the name of the next member, only inside an object.
+        void            key(std::string_view name);
+
+        void            value(std::string_view text);
+        void            value(const char* text);
+        void            value(int number);
+        void            value(std::uint64_t number);
+        void            value(double number);
+        void            value(bool boolean);
+
+        // write the buffer to the stream.
+        void            flush();
+
+      private:
+        // comma, newline and indent before a member or an element.
+        void            separate();
+        void            close(char bracket);
+        void            writeString(std::string_view text);
+        // the size of the utf-8 character at the start of text, 0 if it
+        // does not start with a whole and valid one.
+        static std::size_t getUTF8Length(std::string_view text);
+        void            writeIndent(std::size_t depth);
+
+      private:
+        static constexpr std::size_t BUFFER_SIZE = 64 * 1024;
+
+        std::ostream&       out_;
+        bool                pretty_;
+        std::string         buffer_;
+        // number of members or elements written in every open object or array.
+        std::vector<std::size_t> counts_;
+        // true right after key(), the value goes on the same line.
+        bool                afterKey_;
+    };
+} // namespace MJava
+
+#endif // jsonwriter.h
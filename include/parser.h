@@ -7,27 +7,68 @@
 #ifndef PARSER_H_
 #define PARSER_H_
 
+#include "arena.h"
 #include "ast.h"
 #include "token.h"
 #include "scanner.h"
+#include "threadpool.h"
+#include "tokenbuffer.h"
+#include <cstddef>
 #include <memory>
+#include <ostream>
+#include <string_view>
 #include <vector>
 
 namespace MJava
 {
+    class IncrementalParser;
+
     class Parser
     {
     public:
+        // pull the tokens from the scanner one by one.
         explicit                Parser(Scanner& scanner);
-                                ~Parser();
-        static bool             getErrorFlag();
-        static void             setErrorFlag(bool flag);
+        // take the tokens from a buffer filled by Scanner::tokenizeAll().
+        explicit                Parser(const TokenBuffer& tokens);
+                                Parser(const Parser&) = delete;
+        Parser&                 operator=(const Parser&) = delete;
+        // true once a syntax error has been reported.
+        bool                    getErrorFlag() const;
+        void                    setErrorFlag(bool flag);
         ProgramASTPtr           parse();
-        std::string             toString();
+        // the same tree and errors as parse(), but the classes after the main
+        // class are parsed on the pool, each group of classes with its own
+        // arena. when a broken class runs into the next one, the file is
+        // parsed again by parse(). only for a parser over a token buffer, and
+        // not from a task of the pool.
+        ProgramASTPtr           parseParallel(ThreadPool& pool);
+        // write the tree as json, nothing if parse() has not run.
+        void                    writeJSON(std::ostream& out, bool pretty = true) const;
+        // write the tree in the binary format of binaryast.h.
+        void                    writeBinary(std::ostream& out) const;
 
     private:
+        // parses the classes and the methods touched by an edit on their own.
+        friend class IncrementalParser;
+
+        // parse only the tokens [begin, end). the token at end is seen, but
+        // it can not be taken: the parser gets END_OF_FILE instead and is
+        // overrun, its tree is not the one of a parser over the whole file.
+                                Parser(const TokenBuffer& tokens, std::size_t begin, std::size_t end);
+        // go on with only the tokens [begin, end) of the same buffer.
+        void                    setRange(std::size_t begin, std::size_t end);
+        // at the token at end, which a parser over the whole file goes on from.
+        bool                    isAtRangeEnd() const;
+        // the indexes of the "class" tokens outside any braces, from begin to end.
+        static std::vector<std::size_t> findClassStarts(const TokenBuffer& tokens, std::size_t begin, std::size_t end);
+
+        // ( TypeDeclaration )* up to END_OF_FILE or the end of the range, at least one round.
+        void                    parseClassDeclarations(VecExprASTPtr& classes);
         ExprASTPtr              parseExpression();
-        ExprASTPtr              parseBinOpRHS(int precedence, ExprASTPtr lhs);
+        // an operand and the operators which bind at least as tightly as bindingPower.
+        ExprASTPtr              parseOperatorExpression(int bindingPower);
+        // the "[" or "(" after an operand.
+        ExprASTPtr              parsePostfixOp(ExprASTPtr operand);
         ExprASTPtr              parseUnaryOp();
         ExprASTPtr              parseIdentifierExpression();
         ExprASTPtr              parseParenExpression();
@@ -62,7 +103,8 @@ namespace MJava
         ExprASTPtr              parseMethodBody();
         ExprASTPtr              parseVariableDeclaration();
         ExprASTPtr              parseVariableDeclaration(const Token& token);
-        ExprASTPtr              parseMethodCallStatement(const Token& token);
+        // the name is in the arena already.
+        ExprASTPtr              parseMethodCallStatement(const TokenLocation& loc, std::string_view name);
         ExprASTPtr              parseMethodParameter();
 
         // I/O routines
@@ -73,9 +115,13 @@ namespace MJava
 
         // Helper Functions.
     private:
+        const Token&            currentToken() const;
+        void                    advance();
         bool                    expectAST(ASTType type, const std::string& astName, ExprASTPtr ast);
         bool                    expectToken(TokenValue value, const std::string& tokenName, bool advanceToNextToken);
         bool                    expectToken(TokenType type, const std::string& tokenTypeDescription, bool advanceToNextToken);
+        // skip to a token the parser can go on from after an error.
+        void                    synchronize();
         bool                    validateAST(ASTType type, ExprASTPtr ast);
         bool                    validateToken(TokenValue value, bool advanceToNextToken);
         bool                    validateToken(TokenType type, bool advanceToNextToken);
@@ -83,18 +129,73 @@ namespace MJava
         void                    errorReport(ExprASTPtr ast, const std::string& msg);
 
     private:
-        Scanner&                scanner_;
+        // only one of scanner_ and tokens_ is set.
+        Scanner*                scanner_;
+        const TokenBuffer*      tokens_;
+        // the locations of the tree are printed after the scanner is gone too.
+        SourceFileReference     file_;
+        std::size_t             tokenIndex_;
+        // the index of tokens_ this parser stops at, and the token there.
+        std::size_t             tokenEnd_;
+        Token                   token_;
+        Token                   endToken_;
+        // the parser has tried to take the token at tokenEnd_.
+        bool                    overrun_;
+        // all the nodes of the tree, freed at once with the parser.
+        Arena                   arena_;
         ProgramASTPtr           program_;
-        static bool             errorFlag_;
+        bool                    errorFlag_;
+        // set the error flag, but do not print the errors.
+        bool                    quiet_;
         std::vector<Token>      stack_;
+        // the arenas of the classes parsed by parseParallel().
+        std::vector<Arena>      segmentArenas_;
 
     };
 
-    inline bool Parser::getErrorFlag()
+    inline bool Parser::getErrorFlag() const
     {
         return errorFlag_;
     }
 
+    inline const Token& Parser::currentToken() const
+    {
+        return token_;
+    }
+
+    inline bool Parser::isAtRangeEnd() const
+    {
+        return tokens_ != nullptr && tokenIndex_ == tokenEnd_;
+    }
+
+    inline void Parser::advance()
+    {
+        if (tokens_ != nullptr)
+        {
+            if (tokenIndex_ + 1 < tokenEnd_)
+            {
+                ++tokenIndex_;
+                token_ = tokens_->at(tokenIndex_);
+            }
+            else if (tokenIndex_ + 1 == tokenEnd_)
+            {
+                tokenIndex_ = tokenEnd_;
+                token_ = endToken_;
+            }
+            // stay at END_OF_FILE, or stop at the token after the range.
+            else if (token_.getTokenType() != TokenType::END_OF_FILE)
+            {
+                overrun_ = true;
+                token_ = Token(TokenType::END_OF_FILE, TokenValue::UNRESERVED, token_.getTokenLocation(),
+                               std::string_view("END_OF_FILE"), -1);
+            }
+        }
+        else
+        {
+            token_ = scanner_->getNextToken();
+        }
+    }
+
 } // namespace MJava
 
 #endif // parser.h
\ No newline at end of file
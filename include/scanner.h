@@ -8,9 +8,14 @@
 #define SCANNER_H_
 
 #include "dictionary.h"
+#include "scannertable.h"
+#include "sourcebuffer.h"
 #include "token.h"
-#include <fstream>
+#include "tokenbuffer.h"
+#include <cstddef>
+#include <cstdio>
 #include <string>
+#include <string_view>
 
 namespace MJava
 {
@@ -18,28 +23,73 @@ namespace MJava
     class Scanner
     {
       public:
-        explicit        Scanner(const std::string& srcFileName);
-        Token           getToken() const;
-        Token           getNextToken();
-        static bool     getErrorFlag();
-        static void     setErrorFlag(bool flag);
+        // the hand-written state functions, or the DFA of scannertable.h.
+        // both give the same tokens.
+        enum class Engine
+        {
+            HAND_WRITTEN,
+            TABLE_DRIVEN
+        };
+
+        explicit        Scanner(const std::string& srcFileName, Engine engine = Engine::HAND_WRITTEN);
+        // scan a source file opened already, like the one a cache key was made of.
+                        Scanner(const std::string& fileName, SourceBuffer&& source,
+                                Engine engine = Engine::HAND_WRITTEN);
+        // scan text kept in memory, fileName is only for the messages.
+        // the text is not copied, so it must outlive the scanner.
+                        Scanner(const std::string& fileName, std::string_view source,
+                                Engine engine = Engine::HAND_WRITTEN);
+                        ~Scanner();
+                        Scanner(const Scanner&) = delete;
+        Scanner&        operator=(const Scanner&) = delete;
+
+        // tokens refer to the source buffer and the file name of the scanner,
+        // so they are valid as long as the scanner.
+        const Token&    getToken() const;
+        const Token&    getNextToken();
+        // scan the rest of the file at once, up to and including END_OF_FILE.
+        TokenBuffer     tokenizeAll();
+        // no token is cut after looking further past its end than this. "System"
+        // reads ".out.println" and the char after it to find "System.out.println".
+        static constexpr std::size_t MAX_LOOKAHEAD = 13;
+
+        // go on with a new text of the same file from offset, where a token
+        // starts or the spaces before it. the text is not copied, and the
+        // tokens scanned before still refer to the old one.
+        void            rescan(std::string_view source, std::size_t offset);
+        // true while the current token is bad, reset by every getNextToken().
+        bool            getErrorFlag() const;
+        void            setErrorFlag(bool flag);
+        // number of token errors of the whole file.
+        std::size_t     getErrorCount() const;
+        // number of tokens scanned, END_OF_FILE included.
+        std::size_t     getTokenCount() const;
+        const std::string& getFileName() const;
+        FileID          getFileID() const;
 
       private:
         void            getNextChar();
-        char            peekChar();
-        void            addToBuffer(char c);
-        void            reduceBuffer();
+        char            peekChar() const;
+        bool            isEOF() const;
+        // no char after currentChar_. a char or string literal stops here
+        // without its end quote, like the first scanner over an ifstream did.
+        bool            isLastChar() const;
+        // go on to END_OF_FILE after a literal has stopped at the last char.
+        void            stopAtEndOfFile();
+        std::size_t     currentOffset() const;
+
+        // the chars of current token, from lexemeStart_ to the end offset (excluded).
+        std::string_view lexeme() const;
+        std::string_view lexeme(std::size_t endOffset) const;
 
         void            makeToken(TokenType tt, TokenValue tv,
-                                  const TokenLocation& loc, const std::string& name, int symbolPrecedence);
+                                  const TokenLocation& loc, std::string_view name, int symbolPrecedence);
 
         void            makeToken(TokenType tt, TokenValue tv,
-                                  const TokenLocation& loc, int intValue, const std::string& name);
+                                  const TokenLocation& loc, int intValue, std::string_view name);
 
         void            makeToken(TokenType tt, TokenValue tv,
-                                  const TokenLocation& loc, double realValue, const std::string& name);
-        void            makeToken(TokenType tt, TokenValue tv,
-                                  const TokenLocation& loc, const std::string& strVale, const std::string& name);
+                                  const TokenLocation& loc, double realValue, std::string_view name);
 
         void            handleEOFState();
         void            handleIdentifierState();
@@ -47,6 +97,8 @@ namespace MJava
         void            handleCharState();
         void            handleStringState();
         void            handleOperationState();
+        void            handleTableDrivenState();
+        void            rewindToLexemeStart();
         void            preprocess();
         void            handleLineComment();
         void            handleBlockComment();
@@ -68,37 +120,101 @@ namespace MJava
             NUMBER,
             SINGLE_CHAR,
             STRING,
-            OPERATION
+            OPERATION,
+            TABLE_DRIVEN
         };
 
       private:
         std::string         fileName_;
-        std::ifstream       input_;
-        long                line_;
-        long                column_;
+        FileID              fileId_;
+        SourceBuffer        input_;
+        // offset of the next char to be read, currentChar_ is at offset_ - 1.
+        std::size_t         offset_;
+        std::size_t         lexemeStart_;
         TokenLocation       loc_;
         char                currentChar_;
         State               state_;
+        Engine              engine_;
         Token               token_;
         Dictionary          dictionary_;
-        std::string         buffer_;
-        static bool         errorFlag_;
+        bool                errorFlag_;
+        std::size_t         errorCount_;
+        std::size_t         tokenCount_;
 
     };
 
-    inline Token Scanner::getToken() const
+    inline const Token& Scanner::getToken() const
     {
         return token_;
     }
 
-    inline bool Scanner::getErrorFlag()
+    inline bool Scanner::getErrorFlag() const
     {
         return errorFlag_;
     }
 
+    inline std::size_t Scanner::getErrorCount() const
+    {
+        return errorCount_;
+    }
+
+    inline std::size_t Scanner::getTokenCount() const
+    {
+        return tokenCount_;
+    }
+
+    inline const std::string& Scanner::getFileName() const
+    {
+        return fileName_;
+    }
+
+    inline FileID Scanner::getFileID() const
+    {
+        return fileId_;
+    }
+
+    inline char Scanner::peekChar() const
+    {
+        return offset_ < input_.size() ? input_.data()[offset_] : static_cast<char>(EOF);
+    }
+
+    // like std::ifstream::eof, it is true after we have tried to read past the end.
+    inline bool Scanner::isEOF() const
+    {
+        return offset_ > input_.size();
+    }
+
+    inline bool Scanner::isLastChar() const
+    {
+        return offset_ >= input_.size();
+    }
+
+    inline std::size_t Scanner::currentOffset() const
+    {
+        return offset_ - 1;
+    }
+
+    inline std::string_view Scanner::lexeme() const
+    {
+        return lexeme(currentOffset());
+    }
+
+    inline std::string_view Scanner::lexeme(std::size_t endOffset) const
+    {
+        return input_.slice(lexemeStart_, endOffset - lexemeStart_);
+    }
+
+    // go back to the first char of current token, so that a hand-written
+    // state function can scan it again.
+    inline void Scanner::rewindToLexemeStart()
+    {
+        offset_ = lexemeStart_ + 1;
+        currentChar_ = input_.data()[lexemeStart_];
+    }
+
     inline TokenLocation Scanner::getTokenLocation() const
     {
-        return TokenLocation(fileName_, line_, column_);
+        return TokenLocation(fileId_, static_cast<std::uint32_t>(currentOffset()));
     }
 } // namespace MJava
 
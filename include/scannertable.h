@@ -0,0 +1,176 @@
+// THIS FILE IS PART OF MJava-Compiler PROJECT
+// scannertable.h - tables of the table-driven scanner
+
+// Created by Li Taiji 2026-10-17
+// Copyright (c) 2026 Li Taiji All rights reserved
+
+#ifndef SCANNERTABLE_H_
+#define SCANNERTABLE_H_
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+namespace MJava
+{
+    // every char falls into one class, the DFA only looks at the class.
+    enum class CharClass : std::uint8_t
+    {
+        OTHER = 0,
+        LETTER,             // a-z A-Z, except e E x X
+        LETTER_E,           // e E, maybe the exponent of a number
+        LETTER_X,           // x X, maybe the prefix of a hexadecimal number
+        ZERO,               // 0
+        DIGIT,              // 1-9
+        UNDERSCORE,         // _
+        OPERATOR,           // = < + - * !
+        DOT,                // .
+        AMPERSAND,          // &
+        BRACKET,            // [ ] ( ) { }
+        SEPARATOR,          // , ;
+        SINGLE_QUOTE,       // '
+        DOUBLE_QUOTE,       // "
+        COUNT
+    };
+
+    // the states follow the automaton in state.dot. the first ones are not
+    // final, the DFA eats the char and goes on. a final state ends the token.
+    enum class DFAState : std::uint8_t
+    {
+        START = 0,          // 0 start
+        IDENTIFIER,         // 1 identifier or keyword
+        INTEGER,            // 2 integer
+        AND_FIRST,          // 4 the first & of &&
+        ZERO,               // 0 at the beginning of a number
+
+        // final states
+        IDENTIFIER_DONE,    // 8 identifier ends before current char
+        INTEGER_DONE,       // 9 integer ends before current char
+        OPERATOR,           // 3 operator, eat current char
+        AND,                // 5 &&, eat current char
+        BRACKET,            // 6 bracket, eat current char
+        SEPARATOR,          // 7 separator, eat current char
+        UNKNOWN,            // unknown char, eat current char
+        SYMBOL_DONE,        // single & ends before current char
+
+        // the hand-written state functions will do the rest
+        NUMBER_FALLBACK,    // hexadecimal, octal, fraction and exponent
+        CHAR_FALLBACK,
+        STRING_FALLBACK,
+        COUNT
+    };
+
+    constexpr std::size_t CHAR_CLASS_COUNT = static_cast<std::size_t>(CharClass::COUNT);
+    constexpr std::size_t DFA_STATE_COUNT = static_cast<std::size_t>(DFAState::COUNT);
+    constexpr std::uint8_t DFA_FIRST_FINAL_STATE = static_cast<std::uint8_t>(DFAState::IDENTIFIER_DONE);
+
+    using CharClassTable = std::array<CharClass, 256>;
+    using DFATransitionTable = std::array<std::array<DFAState, CHAR_CLASS_COUNT>, DFA_FIRST_FINAL_STATE>;
+
+    constexpr CharClassTable makeCharClassTable()
+    {
+        CharClassTable table = {};
+
+        for (int c = 'a'; c <= 'z'; c++)
+        {
+            table[c] = CharClass::LETTER;
+            table[c - 'a' + 'A'] = CharClass::LETTER;
+        }
+
+        table['e'] = table['E'] = CharClass::LETTER_E;
+        table['x'] = table['X'] = CharClass::LETTER_X;
+        table['0'] = CharClass::ZERO;
+
+        for (int c = '1'; c <= '9'; c++)
+        {
+            table[c] = CharClass::DIGIT;
+        }
+
+        table['_'] = CharClass::UNDERSCORE;
+        table['='] = table['<'] = table['+'] = table['-'] = table['*'] = table['!'] = CharClass::OPERATOR;
+        table['.'] = CharClass::DOT;
+        table['&'] = CharClass::AMPERSAND;
+        table['['] = table[']'] = table['('] = table[')'] = table['{'] = table['}'] = CharClass::BRACKET;
+        table[','] = table[';'] = CharClass::SEPARATOR;
+        table['\''] = CharClass::SINGLE_QUOTE;
+        table['\"'] = CharClass::DOUBLE_QUOTE;
+
+        return table;
+    }
+
+    constexpr DFATransitionTable makeDFATransitionTable()
+    {
+        DFATransitionTable table = {};
+
+        auto set = [&table](DFAState from, CharClass charClass, DFAState to)
+        {
+            table[static_cast<std::size_t>(from)][static_cast<std::size_t>(charClass)] = to;
+        };
+
+        auto setAll = [&table](DFAState from, DFAState to)
+        {
+            for (std::size_t i = 0; i < CHAR_CLASS_COUNT; i++)
+            {
+                table[static_cast<std::size_t>(from)][i] = to;
+            }
+        };
+
+        // 0 -> 1 a-zA-Z, 0 -> 2 0-9, 0 -> 3 = < + - * . !,
+        // 0 -> 4 &, 0 -> 6 [ ] ( ) { }, 0 -> 7 , ;
+        setAll(DFAState::START, DFAState::UNKNOWN);
+        set(DFAState::START, CharClass::LETTER, DFAState::IDENTIFIER);
+        set(DFAState::START, CharClass::LETTER_E, DFAState::IDENTIFIER);
+        set(DFAState::START, CharClass::LETTER_X, DFAState::IDENTIFIER);
+        set(DFAState::START, CharClass::ZERO, DFAState::ZERO);
+        set(DFAState::START, CharClass::DIGIT, DFAState::INTEGER);
+        set(DFAState::START, CharClass::OPERATOR, DFAState::OPERATOR);
+        set(DFAState::START, CharClass::DOT, DFAState::OPERATOR);
+        set(DFAState::START, CharClass::AMPERSAND, DFAState::AND_FIRST);
+        set(DFAState::START, CharClass::BRACKET, DFAState::BRACKET);
+        set(DFAState::START, CharClass::SEPARATOR, DFAState::SEPARATOR);
+        set(DFAState::START, CharClass::SINGLE_QUOTE, DFAState::CHAR_FALLBACK);
+        set(DFAState::START, CharClass::DOUBLE_QUOTE, DFAState::STRING_FALLBACK);
+
+        // 1 -> 1 a-zA-Z0-9_, 1 -> 8 other
+        setAll(DFAState::IDENTIFIER, DFAState::IDENTIFIER_DONE);
+        set(DFAState::IDENTIFIER, CharClass::LETTER, DFAState::IDENTIFIER);
+        set(DFAState::IDENTIFIER, CharClass::LETTER_E, DFAState::IDENTIFIER);
+        set(DFAState::IDENTIFIER, CharClass::LETTER_X, DFAState::IDENTIFIER);
+        set(DFAState::IDENTIFIER, CharClass::ZERO, DFAState::IDENTIFIER);
+        set(DFAState::IDENTIFIER, CharClass::DIGIT, DFAState::IDENTIFIER);
+        set(DFAState::IDENTIFIER, CharClass::UNDERSCORE, DFAState::IDENTIFIER);
+
+        // 2 -> 2 0-9, 2 -> 9 other. fraction and exponent go to the hand-written scanner.
+        setAll(DFAState::INTEGER, DFAState::INTEGER_DONE);
+        set(DFAState::INTEGER, CharClass::ZERO, DFAState::INTEGER);
+        set(DFAState::INTEGER, CharClass::DIGIT, DFAState::INTEGER);
+        set(DFAState::INTEGER, CharClass::DOT, DFAState::NUMBER_FALLBACK);
+        set(DFAState::INTEGER, CharClass::LETTER_E, DFAState::NUMBER_FALLBACK);
+
+        // a single 0 is a decimal integer, 0x and 0[0-7] are not.
+        setAll(DFAState::ZERO, DFAState::INTEGER_DONE);
+        set(DFAState::ZERO, CharClass::ZERO, DFAState::NUMBER_FALLBACK);
+        set(DFAState::ZERO, CharClass::DIGIT, DFAState::NUMBER_FALLBACK);
+        set(DFAState::ZERO, CharClass::LETTER_X, DFAState::NUMBER_FALLBACK);
+        set(DFAState::ZERO, CharClass::DOT, DFAState::NUMBER_FALLBACK);
+        set(DFAState::ZERO, CharClass::LETTER_E, DFAState::NUMBER_FALLBACK);
+
+        // 4 -> 5 &
+        setAll(DFAState::AND_FIRST, DFAState::SYMBOL_DONE);
+        set(DFAState::AND_FIRST, CharClass::AMPERSAND, DFAState::AND);
+
+        return table;
+    }
+
+    inline constexpr CharClassTable CHAR_CLASS_TABLE = makeCharClassTable();
+    inline constexpr DFATransitionTable DFA_TRANSITION_TABLE = makeDFATransitionTable();
+
+    // final states which eat the char that made the transition.
+    constexpr bool dfaStateEatsChar(DFAState state)
+    {
+        return state == DFAState::OPERATOR || state == DFAState::AND || state == DFAState::BRACKET
+            || state == DFAState::SEPARATOR || state == DFAState::UNKNOWN;
+    }
+} // namespace MJava
+
+#endif // scannertable.h
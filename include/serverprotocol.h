@@ -0,0 +1,125 @@
+// THIS FILE IS PART OF MJava-Compiler PROJECT
+// serverprotocol.h - messages between the compile server and its clients
+
+// Created by Li Taiji 2026-10-17
+// Copyright (c) 2026 Li Taiji All rights reserved
+
+#ifndef SERVERPROTOCOL_H_
+#define SERVERPROTOCOL_H_
+
+#include <cstddef>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace MJava
+{
+    // the socket the server listens on and the client connects to by default.
+    // it is in $XDG_RUNTIME_DIR, which only the user can enter, or it is a
+    // file in /tmp, which another user may have taken first. so both ends
+    // check with Connection::isSameUser() who is at the other end.
+    std::string getDefaultServerSocket();
+
+    // a request or a response. on the wire it is one "name value" line per
+    // field, an empty line, and then the body, whose size is in the "length"
+    // field. a request has the fields
+    //
+    //     command     compile (the default), ping or shutdown.
+    //     output      tokens, json (the default), binary or diagnostics.
+    //     engine      hand (the default) or dfa.
+    //     compact     1 to write json without spaces and newlines.
+    //     file        the absolute path of the source file, or the source is the body.
+    //     name        the file name of the source in the messages.
+    //     errors      text (the default) or json, the format of the errors.
+    //     maxerrors   the number of errors after which the others are only counted.
+    //     allerrors   1 to keep an error at the same place as the one before it.
+    //
+    // a response has the fields
+    //
+    //     status      ok, error (the source has errors) or failed.
+    //     output      the size of the output at the start of the body, the
+    //                 errors of the source follow it, one per line, or one
+    //                 line of json.
+    class Message
+    {
+      public:
+        void                setField(const std::string& name, const std::string& value);
+        // defaultValue if the message has no such field.
+        std::string         getField(const std::string& name, const std::string& defaultValue = std::string()) const;
+        bool                hasField(const std::string& name) const;
+
+        void                setBody(std::string body);
+        const std::string&  getBody() const;
+
+        // the fields and the body as they are sent.
+        std::string         encode() const;
+
+      private:
+        std::vector<std::pair<std::string, std::string>>    fields_;
+        std::string                                         body_;
+    };
+
+    inline const std::string& Message::getBody() const
+    {
+        return body_;
+    }
+
+    // one end of a connection over a Unix domain socket, it closes the
+    // socket when it is destroyed.
+    class Connection
+    {
+      public:
+        explicit            Connection(int fd = -1);
+                            ~Connection();
+                            Connection(const Connection&) = delete;
+        Connection&         operator=(const Connection&) = delete;
+
+        // connect to the server listening on socketPath, false if nobody listens there.
+        bool                open(const std::string& socketPath);
+        void                close();
+        bool                isOpen() const;
+        int                 getFd() const;
+        // a read or a write which waits longer than this fails.
+        void                setTimeout(int seconds);
+        // a message with a longer body is a bad message, without a limit by default.
+        void                setMaxBodySize(std::size_t size);
+        // true if the process at the other end runs as the same user as this one.
+        bool                isSameUser() const;
+        // read the bytes which have arrived without waiting for more, false
+        // at the end of the connection.
+        bool                receive();
+        // true if read() does not wait, the next message has been received
+        // whole or its header or its body is too long.
+        bool                hasMessage() const;
+
+        // false when the other end has closed the connection or sent a bad message.
+        bool                read(Message& message);
+        bool                write(const Message& message);
+
+      private:
+        // read more bytes into buffer_, false at the end of the connection.
+        bool                fill();
+        // the fields of the message at the start of buffer_ and where its
+        // body starts, false if the header has not been read whole.
+        bool                readHeader(Message& message, std::size_t& headerEnd) const;
+        static std::size_t  getBodyLength(const Message& message);
+
+      private:
+        int                 fd_;
+        std::size_t         maxBodySize_;
+        // bytes read but not used yet.
+        std::string         buffer_;
+    };
+
+    inline bool Connection::isOpen() const
+    {
+        return fd_ >= 0;
+    }
+
+    inline int Connection::getFd() const
+    {
+        return fd_;
+    }
+} // namespace MJava
+
+#endif // serverprotocol.h
@@ -0,0 +1,38 @@
+// THIS FILE IS PART OF MJava-Compiler PROJECT
+// simd.h - vectorized search in the source text
+
+// Created by Li Taiji 2026-10-17
+// Copyright (c) 2026 Li Taiji All rights reserved
+
+#ifndef SIMD_H_
+#define SIMD_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace MJava
+{
+    // the search functions look at data[offset, size) and return the offset of
+    // the first match, or size if nothing matches (also when offset >= size).
+    // they use AVX2 or SSE2 if the cpu has it, and plain loops otherwise.
+    // the choice is made once, at the first call.
+
+    // the first char which is not a space, the same as std::isspace in "C" locale.
+    std::size_t         skipWhitespace(const char* data, std::size_t size, std::size_t offset);
+
+    // the first '\n'.
+    std::size_t         findNewline(const char* data, std::size_t size, std::size_t offset);
+
+    // the '*' of the first "*/".
+    std::size_t         findBlockCommentEnd(const char* data, std::size_t size, std::size_t offset);
+
+    // push the offset just after every '\n' of data[0, size) to lineStarts.
+    void                appendLineStarts(const char* data, std::size_t size,
+                                         std::vector<std::uint32_t>& lineStarts);
+
+    // "avx2", "sse2" or "scalar".
+    const char*         simdLevelName();
+} // namespace MJava
+
+#endif // simd.h
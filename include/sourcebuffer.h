@@ -0,0 +1,77 @@
+// THIS FILE IS PART OF MJava-Compiler PROJECT
+// sourcebuffer.h - read-only view of the whole source file
+
+// Created by Li Taiji 2026-10-17
+// Copyright (c) 2026 Li Taiji All rights reserved
+
+#ifndef SOURCEBUFFER_H_
+#define SOURCEBUFFER_H_
+
+#include <cstddef>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace MJava
+{
+    // SourceBuffer holds the whole source file as one contiguous range of chars.
+    // regular files are mapped into memory, so the scanner can walk them without
+    // copying. pipes, character devices and platforms without mmap are read
+    // into a private buffer instead. a buffer can also be a view of text kept
+    // in memory by somebody else, like the text of an editor.
+    class SourceBuffer
+    {
+      public:
+        SourceBuffer();
+        ~SourceBuffer();
+
+        SourceBuffer(const SourceBuffer&) = delete;
+        SourceBuffer& operator=(const SourceBuffer&) = delete;
+        SourceBuffer(SourceBuffer&& other) noexcept;
+        SourceBuffer& operator=(SourceBuffer&& other) noexcept;
+
+        // return false if the file can not be opened or read.
+        bool                open(const std::string& fileName);
+        // refer to text owned by the caller, it must outlive the buffer.
+        void                view(std::string_view text);
+        void                close();
+
+        const char*         data() const;
+        std::size_t         size() const;
+        bool                isMapped() const;
+
+        // the slice [offset, offset + length) of the source.
+        std::string_view    slice(std::size_t offset, std::size_t length) const;
+
+      private:
+        bool                readAll(int fd);
+
+      private:
+        const char*         data_;
+        std::size_t         size_;
+        bool                mapped_;
+        std::vector<char>   storage_;
+    };
+
+    inline const char* SourceBuffer::data() const
+    {
+        return data_;
+    }
+
+    inline std::size_t SourceBuffer::size() const
+    {
+        return size_;
+    }
+
+    inline bool SourceBuffer::isMapped() const
+    {
+        return mapped_;
+    }
+
+    inline std::string_view SourceBuffer::slice(std::size_t offset, std::size_t length) const
+    {
+        return std::string_view(data_ + offset, length);
+    }
+} // namespace MJava
+
+#endif // sourcebuffer.h
@@ -0,0 +1,106 @@
+// THIS FILE IS PART OF MJava-Compiler PROJECT
+// sourcemanager.h - table of source files and their line index
+
+// Created by Li Taiji 2026-10-17
+// Copyright (c) 2026 Li Taiji All rights reserved
+
+#ifndef SOURCEMANAGER_H_
+#define SOURCEMANAGER_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <shared_mutex>
+#include <string>
+#include <vector>
+
+namespace MJava
+{
+    // file 0 is reserved for locations that do not belong to any file.
+    using FileID = std::uint32_t;
+
+    // SourceManager is the only place that knows file names and line numbers.
+    // a location is just a file id and an offset, the line and the column are
+    // computed from a line index only when somebody wants to print them.
+    // the table is shared by all the scanners of the process, it is safe to
+    // use from more than one thread. the queries only take the lock shared,
+    // so the threads printing their errors do not wait for each other, and a
+    // line index never changes once it is built, a changed text gets a new one.
+    //
+    // a file is counted by its references: the scanner which added it holds
+    // one, and a syntax tree which outlives the scanner holds another, so its
+    // locations still have their line and file name. the id of a file is
+    // used again once the last reference is gone.
+    class SourceManager
+    {
+      public:
+        static SourceManager&   instance();
+
+        // register the source text of a file with one reference. the text is
+        // not copied, so it must live until the file is removed.
+        FileID                  addFile(const std::string& fileName, const char* data, std::size_t size);
+        // the text goes away and its reference with it. the line index is
+        // built first if somebody else still holds the file.
+        void                    removeFile(FileID fileId);
+        void                    retainFile(FileID fileId);
+        void                    releaseFile(FileID fileId);
+        // the text of the file has been changed, its line index is built again
+        // at the next query.
+        void                    updateFile(FileID fileId, const char* data, std::size_t size);
+
+        std::string             getFileName(FileID fileId) const;
+
+        // build the line index now instead of at the first query. it is one
+        // vectorized pass over the text, done without holding the lock.
+        void                    buildLineIndex(FileID fileId) const;
+
+        // line and column of the char at offset, 1-based line and column.
+        // the same as the scanner counted them: a '\n' belongs to the next
+        // line with column 0, and offset -1 (before the first char) is 1:0.
+        void                    getLineAndColumn(FileID fileId, std::uint32_t offset,
+                                                 int& line, int& column) const;
+
+      private:
+        // offsets of the first char of every line.
+        using LineIndex = std::vector<std::uint32_t>;
+
+        struct SourceFile
+        {
+            std::string                         name;
+            const char*                         data;
+            std::size_t                         size;
+            // built by buildLineIndex or at the first query, null until then.
+            std::unique_ptr<const LineIndex>    lineStarts;
+            std::size_t                         references;
+        };
+
+        SourceManager();
+        SourceFile*             getFile(FileID fileId) const;
+        static std::unique_ptr<const LineIndex> makeLineIndex(const char* data, std::size_t size);
+        // drop a reference, the mutex is held.
+        void                    release(FileID fileId);
+
+      private:
+        mutable std::shared_mutex                   mutex_;
+        std::vector<std::unique_ptr<SourceFile>>    files_;
+        // the ids of the removed files, used again by addFile.
+        std::vector<FileID>                         freeIds_;
+    };
+
+    // holds a reference to a file while it lives, see SourceManager.
+    class SourceFileReference
+    {
+      public:
+        explicit                SourceFileReference(FileID fileId = 0);
+                                ~SourceFileReference();
+                                SourceFileReference(const SourceFileReference&) = delete;
+        SourceFileReference&    operator=(const SourceFileReference&) = delete;
+
+        FileID                  getFileID() const { return fileId_; }
+      private:
+        FileID                  fileId_;
+    };
+} // namespace MJava
+
+#endif // sourcemanager.h
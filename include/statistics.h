@@ -0,0 +1,171 @@
+// THIS FILE IS PART OF MJava-Compiler PROJECT
+// statistics.h - time, allocations and sizes of every compile phase
+
+// Created by Li Taiji 2026-10-17
+// Copyright (c) 2026 Li Taiji All rights reserved
+
+#ifndef STATISTICS_H_
+#define STATISTICS_H_
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <vector>
+
+namespace MJava
+{
+    // the allocations made by the calling thread since it started. the global
+    // operator new of statistics.cpp counts them in two thread local
+    // integers, so they are always on.
+    struct AllocationCounters
+    {
+        std::uint64_t   count;
+        std::uint64_t   bytes;
+    };
+
+    AllocationCounters getAllocationCounters();
+
+    // the counters read with perf_event_open around every phase, on Linux
+    // only. they count the calling thread in user mode. the processor ones
+    // are missing in most virtual machines, page faults are counted by the
+    // kernel and are there nearly everywhere.
+    enum class PerfCounter
+    {
+        CYCLES,
+        INSTRUCTIONS,
+        BRANCH_MISSES,
+        L1D_MISSES,
+        LLC_MISSES,
+        PAGE_FAULTS,
+        PERF_COUNTER_COUNT
+    };
+
+    constexpr std::size_t PERF_COUNTER_COUNT = static_cast<std::size_t>(PerfCounter::PERF_COUNTER_COUNT);
+
+    // CompileStatistics adds up the phases of all the files of a run, and
+    // keeps every phase of every file as an event for a trace viewer.
+    // add() may be called from more than one thread.
+    class CompileStatistics
+    {
+      public:
+        enum class Phase
+        {
+            // one file, from the cache lookup to the end of its output.
+            COMPILE,
+            SCAN,
+            PARSE,
+            // the parser pulls the tokens from the scanner one by one.
+            SCAN_AND_PARSE,
+            // the lexer writes the tokens as they are scanned.
+            SCAN_AND_WRITE,
+            WRITE,
+            PHASE_COUNT
+        };
+
+        struct Totals
+        {
+            std::size_t     files;
+            double          wallSeconds;
+            double          cpuSeconds;
+            std::uint64_t   allocations;
+            std::uint64_t   allocatedBytes;
+            std::uint64_t   tokens;
+            std::uint64_t   nodes;
+            // the peak resident set of the process at the end of the phase.
+            std::uint64_t   peakKilobytes;
+            std::uint64_t   perfCounters[PERF_COUNTER_COUNT];
+        };
+
+        // the point in a thread where a phase starts or stops.
+        struct Sample
+        {
+            std::chrono::steady_clock::time_point   wallTime;
+            double                                  cpuSeconds;
+            AllocationCounters                      allocations;
+            // of the whole process, the kernel does not keep it per thread.
+            std::uint64_t                           peakKilobytes;
+            std::uint64_t                           perfCounters[PERF_COUNTER_COUNT];
+        };
+
+        // the perf counters are read only if perfCounters is true. the ones
+        // which can not be opened read as zero and are left out of print().
+                            CompileStatistics(bool trace, bool perfCounters = false);
+                            CompileStatistics(const CompileStatistics&) = delete;
+        CompileStatistics&  operator=(const CompileStatistics&) = delete;
+
+        Sample              takeSample() const;
+        void                add(Phase phase, const std::string& file, const Sample& start, const Sample& stop,
+                                std::uint64_t tokens, std::uint64_t nodes);
+
+        Totals              getTotals(Phase phase) const;
+        static const char*  getPhaseName(Phase phase);
+        static const char*  getPerfCounterName(PerfCounter counter);
+        bool                isPerfCounterAvailable(PerfCounter counter) const;
+
+        // a table of the phases which have run.
+        void                print(std::ostream& out) const;
+        // the chrome trace event format, for chrome://tracing or Perfetto.
+        void                writeTrace(std::ostream& out) const;
+
+      private:
+        void                printPerfCounters(std::ostream& out) const;
+
+      private:
+        struct Event
+        {
+            Phase           phase;
+            std::string     file;
+            unsigned        thread;
+            double          startMicroseconds;
+            double          durationMicroseconds;
+            std::uint64_t   allocations;
+            std::uint64_t   allocatedBytes;
+            std::uint64_t   tokens;
+            std::uint64_t   nodes;
+            std::uint64_t   perfCounters[PERF_COUNTER_COUNT];
+        };
+
+        bool                                    trace_;
+        bool                                    perfCounters_;
+        bool                                    perfAvailable_[PERF_COUNTER_COUNT];
+        // why the first counter which is not available could not be opened.
+        std::string                             perfError_;
+        std::chrono::steady_clock::time_point   startTime_;
+        mutable std::mutex                      mutex_;
+        Totals                                  totals_[static_cast<std::size_t>(Phase::PHASE_COUNT)];
+        std::vector<Event>                      events_;
+    };
+
+    // PhaseTimer measures one phase of one file, from its construction to
+    // stop() or its destruction, and adds it to the statistics when it is
+    // destroyed. it does nothing without statistics. the file name is not
+    // copied, so it must outlive the timer.
+    class PhaseTimer
+    {
+      public:
+                        PhaseTimer(CompileStatistics* statistics, CompileStatistics::Phase phase,
+                                   const std::string& file);
+                        ~PhaseTimer();
+                        PhaseTimer(const PhaseTimer&) = delete;
+        PhaseTimer&     operator=(const PhaseTimer&) = delete;
+
+        void            stop();
+        // the tokens and the nodes of the phase, they may be counted after stop().
+        void            setSizes(std::uint64_t tokens, std::uint64_t nodes = 0);
+
+      private:
+        CompileStatistics*          statistics_;
+        CompileStatistics::Phase    phase_;
+        const std::string&          file_;
+        bool                        stopped_;
+        CompileStatistics::Sample   start_;
+        CompileStatistics::Sample   stop_;
+        std::uint64_t               tokens_;
+        std::uint64_t               nodes_;
+    };
+} // namespace MJava
+
+#endif // statistics.h
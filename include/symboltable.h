@@ -0,0 +1,63 @@
+// THIS FILE IS PART OF MJava-Compiler PROJECT
+// symboltable.h - interned identifiers and literals
+
+// Created by Li Taiji 2026-10-17
+// Copyright (c) 2026 Li Taiji All rights reserved
+
+#ifndef SYMBOLTABLE_H_
+#define SYMBOLTABLE_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+namespace MJava
+{
+    // a symbol is a small integer standing for one interned string.
+    // symbol 0 is always the empty string.
+    using Symbol = std::uint32_t;
+
+    class SymbolTable
+    {
+      public:
+        SymbolTable();
+
+        SymbolTable(const SymbolTable&) = delete;
+        SymbolTable& operator=(const SymbolTable&) = delete;
+
+        // return the symbol of name, the same name always gets the same symbol.
+        Symbol              intern(std::string_view name);
+
+        // the returned view is valid as long as the symbol table.
+        std::string_view    getName(Symbol symbol) const;
+        std::size_t         size() const;
+
+      private:
+        // copy name into the arena, so that views into it never move.
+        std::string_view    store(std::string_view name);
+
+      private:
+        static const std::size_t                    CHUNK_SIZE = 16 * 1024;
+
+        std::vector<std::unique_ptr<char[]>>        chunks_;
+        char*                                       current_;
+        std::size_t                                 available_;
+        std::vector<std::string_view>               names_;
+        std::unordered_map<std::string_view, Symbol> symbols_;
+    };
+
+    inline std::string_view SymbolTable::getName(Symbol symbol) const
+    {
+        return names_[symbol];
+    }
+
+    inline std::size_t SymbolTable::size() const
+    {
+        return names_.size();
+    }
+} // namespace MJava
+
+#endif // symboltable.h
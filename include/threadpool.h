@@ -0,0 +1,59 @@
+// THIS FILE IS PART OF MJava-Compiler PROJECT
+// threadpool.h - fixed number of worker threads
+
+// Created by Li Taiji 2026-10-17
+// Copyright (c) 2026 Li Taiji All rights reserved
+
+#ifndef THREADPOOL_H_
+#define THREADPOOL_H_
+
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace MJava
+{
+    // ThreadPool starts its threads once and runs the submitted tasks on them
+    // in the order they were submitted. a task must not throw.
+    class ThreadPool
+    {
+      public:
+        explicit        ThreadPool(std::size_t threadCount);
+        // wait for the tasks that are left, then stop the threads.
+                        ~ThreadPool();
+                        ThreadPool(const ThreadPool&) = delete;
+        ThreadPool&     operator=(const ThreadPool&) = delete;
+
+        void            submit(std::function<void()> task);
+        // block until every submitted task has finished.
+        void            wait();
+        std::size_t     size() const;
+
+        // number of hardware threads, at least 1.
+        static std::size_t defaultThreadCount();
+
+      private:
+        void            workerLoop();
+
+      private:
+        std::mutex                          mutex_;
+        std::condition_variable             taskReady_;
+        std::condition_variable             allDone_;
+        std::deque<std::function<void()>>   tasks_;
+        // tasks taken from the queue but not finished yet.
+        std::size_t                         running_;
+        bool                                stopping_;
+        std::vector<std::thread>            workers_;
+    };
+
+    inline std::size_t ThreadPool::size() const
+    {
+        return workers_.size();
+    }
+} // namespace MJava
+
+#endif // threadpool.h
@@ -7,15 +7,17 @@
 #ifndef TOKEN_H_
 #define TOKEN_H_
 
+#include "sourcemanager.h"
 #include <cassert>
+#include <cstdint>
 #include <iostream>
-#include <map>
 #include <string>
-#include <tuple>
+#include <string_view>
+#include <type_traits>
 
 namespace MJava
 {
-    enum class TokenType
+    enum class TokenType : std::uint8_t
     {
         // in fact, we can put these 5 types to one category
         // named constant. but I want to make it cleaner.
@@ -34,7 +36,7 @@ namespace MJava
         UNKNOWN
     };
 
-    enum class TokenValue
+    enum class TokenValue : std::uint8_t
     {
         // keyword
         CLASS = 0,
@@ -85,38 +87,44 @@ namespace MJava
     };
 
 
+    // a location is the file id and the offset of the char in that file.
+    // line and column are looked up in the SourceManager when they are needed.
     class TokenLocation
     {
       public:
         TokenLocation();
-        TokenLocation(const std::string& fileName, int line, int column);
+        TokenLocation(FileID fileId, std::uint32_t offset);
+
+        FileID getFileID() const { return fileId_; }
+        std::uint32_t getOffset() const { return offset_; }
+        int getLine() const;
+        int getColumn() const;
 
         // this method is very similar with toString method in Java.
         std::string toString() const;
       private:
-        std::string fileName_;
-        int line_;
-        int column_;
+        FileID          fileId_;
+        std::uint32_t   offset_;
     };
 
+    // token does not own any string. its name refers to the source
+    // buffer of the scanner, so the scanner must outlive its tokens.
     class Token
     {
       public:
         Token();
         Token(TokenType type, TokenValue value, const TokenLocation& location,
-              const std::string& name, int symbolPrecedence);
-        Token(TokenType type, TokenValue value, const TokenLocation& location,
-              const std::string& strValue, const std::string& name);
+              std::string_view name, int symbolPrecedence);
         Token(TokenType type, TokenValue value, const TokenLocation& location,
-              int intValue, const std::string& name);
+              int intValue, std::string_view name);
         Token(TokenType type, TokenValue value, const TokenLocation& location,
-              double realValue, const std::string& name);
+              double realValue, std::string_view name);
 
         // get token information
         TokenType getTokenType() const;
         TokenValue getTokenValue() const;
         const TokenLocation& getTokenLocation() const;
-        std::string getTokenName() const;
+        std::string_view getTokenName() const;
 
         // + - * / and so on.
         int getSymbolPrecedence() const;
@@ -124,7 +132,7 @@ namespace MJava
         // get constant values of token
         int getIntValue() const;
         double getRealValue() const;
-        std::string getStringValue() const;
+        std::string_view getStringValue() const;
 
         // output debug information.
         // here output token location, value and type.
@@ -134,27 +142,30 @@ namespace MJava
 
         // more exact function for getting identifier name.
         // Its essential heart is just getTokenName.
-        std::string getIdentifierName() const;
+        std::string_view getIdentifierName() const;
 
         std::string tokenTypeDescription() const;
         std::string toString() const;
 
       private:
-        TokenType       type_;
-        TokenValue      value_;
-        TokenLocation   location_;
-        std::string     name_;
-        int             symbolPrecedence_;
-        
-
-        // const values of token
-        int             intValue_;
-        double          realValue_;
-        std::string     strValue_;
-
-
+        TokenLocation       location_;
+        std::string_view    name_;
+
+        // const values of token, string literal is its name.
+        union
+        {
+            int             intValue_;
+            double          realValue_;
+        };
+
+        std::int16_t        symbolPrecedence_;
+        TokenType           type_;
+        TokenValue          value_;
     };
 
+    static_assert(std::is_trivially_copyable<Token>::value, "Token should be copied with memcpy.");
+    static_assert(sizeof(Token) <= 64, "Token should fit in one cache line.");
+
     inline TokenType Token::getTokenType() const
     {
         return type_;
@@ -165,7 +176,7 @@ namespace MJava
         return value_;
     }
 
-    inline std::string Token::getTokenName() const
+    inline std::string_view Token::getTokenName() const
     {
         return name_;
     }
@@ -185,9 +196,9 @@ namespace MJava
         return realValue_;
     }
 
-    inline std::string Token::getStringValue() const
+    inline std::string_view Token::getStringValue() const
     {
-        return strValue_;
+        return name_;
     }
 
     inline int Token::getSymbolPrecedence() const
@@ -195,7 +206,7 @@ namespace MJava
         return symbolPrecedence_;
     }
 
-    inline std::string Token::getIdentifierName() const
+    inline std::string_view Token::getIdentifierName() const
     {
         assert(type_ == TokenType::IDENTIFIER && "Token type should be identifier.");
         return name_;
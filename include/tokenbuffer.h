@@ -0,0 +1,106 @@
+// THIS FILE IS PART OF MJava-Compiler PROJECT
+// tokenbuffer.h - all the tokens of a file, one array per field
+
+// Created by Li Taiji 2026-10-17
+// Copyright (c) 2026 Li Taiji All rights reserved
+
+#ifndef TOKENBUFFER_H_
+#define TOKENBUFFER_H_
+
+#include "sourcemanager.h"
+#include "token.h"
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+#include <vector>
+
+namespace MJava
+{
+    // TokenBuffer keeps the tokens of a whole file as a structure of arrays,
+    // so looking at the type or the value of the next tokens touches only a
+    // few bytes. like Token, it refers to the source buffer of the scanner.
+    // the last token is always END_OF_FILE.
+    class TokenBuffer
+    {
+      public:
+        explicit            TokenBuffer(FileID fileId = 0);
+
+        void                reserve(std::size_t count);
+        void                push(const Token& token);
+
+        std::size_t         size() const;
+        bool                empty() const;
+        FileID              getFileID() const;
+
+        TokenType           getTokenType(std::size_t index) const;
+        TokenValue          getTokenValue(std::size_t index) const;
+        std::uint32_t       getOffset(std::size_t index) const;
+        std::string_view    getTokenName(std::size_t index) const;
+
+        // build the token at index again.
+        Token               at(std::size_t index) const;
+        // the first token in [begin, end) which starts at or after offset, end if none.
+        std::size_t         lowerBound(std::uint32_t offset, std::size_t begin, std::size_t end) const;
+
+        // replace the tokens [begin, end) by all the tokens of other.
+        void                splice(std::size_t begin, std::size_t end, const TokenBuffer& other);
+        // move the tokens [begin, end) by delta chars after an edit of the
+        // source. the names in the old text [from, from + size) are moved to
+        // the same place of the new text at to.
+        void                relocate(std::size_t begin, std::size_t end, std::ptrdiff_t delta,
+                                     const char* from, std::size_t size, const char* to);
+
+      private:
+        // the constant value of the token.
+        union Literal
+        {
+            int             intValue;
+            double          realValue;
+        };
+
+        FileID                          fileId_;
+        std::vector<TokenType>          types_;
+        std::vector<TokenValue>         values_;
+        std::vector<std::uint32_t>      offsets_;
+        std::vector<std::string_view>   names_;
+        std::vector<Literal>            literals_;
+        std::vector<std::int16_t>       precedences_;
+    };
+
+    inline std::size_t TokenBuffer::size() const
+    {
+        return types_.size();
+    }
+
+    inline bool TokenBuffer::empty() const
+    {
+        return types_.empty();
+    }
+
+    inline FileID TokenBuffer::getFileID() const
+    {
+        return fileId_;
+    }
+
+    inline TokenType TokenBuffer::getTokenType(std::size_t index) const
+    {
+        return types_[index];
+    }
+
+    inline TokenValue TokenBuffer::getTokenValue(std::size_t index) const
+    {
+        return values_[index];
+    }
+
+    inline std::uint32_t TokenBuffer::getOffset(std::size_t index) const
+    {
+        return offsets_[index];
+    }
+
+    inline std::string_view TokenBuffer::getTokenName(std::size_t index) const
+    {
+        return names_[index];
+    }
+} // namespace MJava
+
+#endif // tokenbuffer.h
@@ -1,10 +1,12 @@
 @echo off
+set arguments=%1
+if not "%~2"=="" set arguments=%1 -o %2
 if exist .\bin (
     if exist .\bin\Lexer.exe (
-    .\bin\Lexer.exe %1 %2
+    .\bin\Lexer.exe %arguments%
     ) else ( 
-        g++ src/main.cpp src/scanner.cpp src/error.cpp src/dictionary.cpp src/token.cpp -I ./include -DLEXER -o .\bin\Lexer.exe && .\bin\Lexer.exe %1 %2
+        g++ -std=c++17 -pthread src/main.cpp src/driver.cpp src/threadpool.cpp src/compilecache.cpp src/serverprotocol.cpp src/compileserver.cpp src/statistics.cpp src/sourcebuffer.cpp src/symboltable.cpp src/sourcemanager.cpp src/simd.cpp src/scanner.cpp src/error.cpp src/diagnostic.cpp src/token.cpp src/tokenbuffer.cpp src/jsonwriter.cpp -I ./include -DLEXER -o .\bin\Lexer.exe && .\bin\Lexer.exe %arguments%
     )
 ) else (
-    md .\bin && g++ src/main.cpp src/scanner.cpp src/error.cpp src/dictionary.cpp src/token.cpp -I ./include -DLEXER -o .\bin\Lexer.exe && .\bin\Lexer.exe %1 %2
+    md .\bin && g++ -std=c++17 -pthread src/main.cpp src/driver.cpp src/threadpool.cpp src/compilecache.cpp src/serverprotocol.cpp src/compileserver.cpp src/statistics.cpp src/sourcebuffer.cpp src/symboltable.cpp src/sourcemanager.cpp src/simd.cpp src/scanner.cpp src/error.cpp src/diagnostic.cpp src/token.cpp src/tokenbuffer.cpp src/jsonwriter.cpp -I ./include -DLEXER -o .\bin\Lexer.exe && .\bin\Lexer.exe %arguments%
 )
\ No newline at end of file
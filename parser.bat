@@ -1,10 +1,12 @@
 @echo off
+set arguments=%1
+if not "%~2"=="" set arguments=%1 -o %2
 if exist .\bin (
     if exist .\bin\Parser.exe (
-        .\bin\Parser.exe %1 %2
+        .\bin\Parser.exe %arguments%
     ) else ( 
-        g++ src/main.cpp src/scanner.cpp src/error.cpp src/dictionary.cpp src/token.cpp src/ast.cpp src/parser.cpp src/jsonformatter.cpp -I ./include -DPARSER -o .\bin\Parser.exe && .\bin\Parser.exe %1 %2
+        g++ -std=c++17 -pthread src/main.cpp src/driver.cpp src/threadpool.cpp src/compilecache.cpp src/serverprotocol.cpp src/compileserver.cpp src/statistics.cpp src/sourcebuffer.cpp src/symboltable.cpp src/sourcemanager.cpp src/simd.cpp src/scanner.cpp src/error.cpp src/diagnostic.cpp src/token.cpp src/tokenbuffer.cpp src/arena.cpp src/ast.cpp src/astvisitor.cpp src/flatast.cpp src/binaryast.cpp src/incrementalparser.cpp src/parser.cpp src/jsonwriter.cpp src/astserializer.cpp -I ./include -DPARSER -o .\bin\Parser.exe && .\bin\Parser.exe %arguments%
     )
 ) else (
-    md .\bin && g++ src/main.cpp src/scanner.cpp src/error.cpp src/dictionary.cpp src/token.cpp src/ast.cpp src/parser.cpp src/jsonformatter.cpp -I ./include -DPARSER -o .\bin\Parser.exe && .\bin\Parser.exe %1 %2
+    md .\bin && g++ -std=c++17 -pthread src/main.cpp src/driver.cpp src/threadpool.cpp src/compilecache.cpp src/serverprotocol.cpp src/compileserver.cpp src/statistics.cpp src/sourcebuffer.cpp src/symboltable.cpp src/sourcemanager.cpp src/simd.cpp src/scanner.cpp src/error.cpp src/diagnostic.cpp src/token.cpp src/tokenbuffer.cpp src/arena.cpp src/ast.cpp src/astvisitor.cpp src/flatast.cpp src/binaryast.cpp src/incrementalparser.cpp src/parser.cpp src/jsonwriter.cpp src/astserializer.cpp -I ./include -DPARSER -o .\bin\Parser.exe && .\bin\Parser.exe %arguments%
 )
\ No newline at end of file
@@ -0,0 +1,70 @@
+// THIS FILE IS PART OF MJava-Compiler PROJECT
+// arena.cpp - bump pointer allocator for the syntax tree
+
+// Created by Li Taiji 2026-10-17
+// Copyright (c) 2026 Li Taiji All rights reserved
+
+#include "arena.h"
+
+namespace MJava
+{
+    Arena::Arena(std::size_t chunkSize)
+        : chunkSize_(chunkSize), current_(nullptr), end_(nullptr), bytesUsed_(0)
+    {}
+
+    Arena::Arena(Arena&& other) noexcept
+        : chunkSize_(other.chunkSize_), chunks_(std::move(other.chunks_)),
+          current_(other.current_), end_(other.end_), bytesUsed_(other.bytesUsed_)
+    {
+        other.chunks_.clear();
+        other.current_ = nullptr;
+        other.end_ = nullptr;
+        other.bytesUsed_ = 0;
+    }
+
+    Arena& Arena::operator=(Arena&& other) noexcept
+    {
+        if (this != &other)
+        {
+            chunkSize_ = other.chunkSize_;
+            chunks_ = std::move(other.chunks_);
+            current_ = other.current_;
+            end_ = other.end_;
+            bytesUsed_ = other.bytesUsed_;
+
+            other.chunks_.clear();
+            other.current_ = nullptr;
+            other.end_ = nullptr;
+            other.bytesUsed_ = 0;
+        }
+
+        return *this;
+    }
+
+    void Arena::grow(std::size_t size)
+    {
+        // a very big request gets a chunk of its own.
+        std::size_t chunkSize = size > chunkSize_ ? size : chunkSize_;
+
+        chunks_.emplace_back(new char[chunkSize]);
+        current_ = chunks_.back().get();
+        end_ = current_ + chunkSize;
+    }
+
+    void Arena::rewind(const Mark& mark)
+    {
+        // the chunks added after the mark hold nothing else.
+        chunks_.resize(mark.chunkCount);
+        current_ = mark.current;
+        end_ = mark.end;
+        bytesUsed_ = mark.bytesUsed;
+    }
+
+    void Arena::release()
+    {
+        chunks_.clear();
+        current_ = nullptr;
+        end_ = nullptr;
+        bytesUsed_ = 0;
+    }
+} // namespace MJava
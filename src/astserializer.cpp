@@ -0,0 +1,349 @@
+// THIS FILE IS PART OF MJava-Compiler PROJECT
+// astserializer.cpp - write the abstract syntax tree as json
+
+// Created by Li Taiji 2026-10-17
+// Copyright (c) 2026 Li Taiji All rights reserved
+
+#include "astserializer.h"
+#include "dictionary.h"
+
+namespace MJava
+{
+    ASTSerializer::ASTSerializer(JSONWriter& writer) : writer_(writer)
+    {}
+
+    void ASTSerializer::write(const ExprAST* ast)
+    {
+        visit(ast);
+    }
+
+    void ASTSerializer::visitNull()
+    {
+        writer_.beginObject();
+        writer_.endObject();
+    }
+
+    void ASTSerializer::visitBase(const ExprAST*)
+    {
+        visitNull();
+    }
+
+    void ASTSerializer::visitBlock(const BlockAST* ast)
+    {
+        writeStatementArray(ast);
+    }
+
+    void ASTSerializer::visitReal(const RealAST* ast)
+    {
+        writeHeader(ast);
+        writer_.key("real");
+        writer_.value(ast->getReal());
+        writer_.endObject();
+    }
+
+    void ASTSerializer::visitInteger(const IntegerAST* ast)
+    {
+        writeHeader(ast);
+        writer_.key("integer");
+        writer_.value(ast->getInteger());
+        writer_.endObject();
+    }
+
+    void ASTSerializer::visitChar(const CharAST* ast)
+    {
+        char ch = ast->getChar();
+        writeHeader(ast);
+        writer_.key("char");
+        writer_.value(std::string_view(&ch, 1));
+        writer_.endObject();
+    }
+
+    void ASTSerializer::visitString(const StringAST* ast)
+    {
+        writeHeader(ast);
+        writer_.key("string");
+        writer_.value(ast->getString());
+        writer_.endObject();
+    }
+
+    void ASTSerializer::visitBoolean(const BooleanAST* ast)
+    {
+        writeHeader(ast);
+        writer_.key("boolean");
+        writer_.value(ast->getBoolean());
+        writer_.endObject();
+    }
+
+    void ASTSerializer::writeStatements(const ExprAST* ast)
+    {
+        if (ast != nullptr && ast->getID() == ASTType::BLOCK)
+        {
+            for (const ExprAST* statement : static_cast<const BlockAST*>(ast)->getBlock())
+            {
+                writeStatements(statement);
+            }
+        }
+        else
+        {
+            visit(ast);
+        }
+    }
+
+    void ASTSerializer::writeStatementArray(const ExprAST* ast)
+    {
+        writer_.beginArray();
+
+        if (ast != nullptr)
+        {
+            writeStatements(ast);
+        }
+
+        writer_.endArray();
+    }
+
+    void ASTSerializer::writeArray(ExprASTArray asts)
+    {
+        writer_.beginArray();
+
+        for (const ExprAST* ast : asts)
+        {
+            writeStatements(ast);
+        }
+
+        writer_.endArray();
+    }
+
+    // {"id": ..., "type": ..., and the caller writes the rest.
+    void ASTSerializer::writeHeader(const ExprAST* ast)
+    {
+        writer_.beginObject();
+        writer_.key("id");
+        writer_.value(static_cast<int>(ast->getID()));
+        writer_.key("type");
+        writer_.value(ast->getASTTypeDescription());
+    }
+
+    void ASTSerializer::visitProgram(const ProgramAST* ast)
+    {
+        writeHeader(ast);
+        writer_.key("classes");
+        writeArray(ast->getClasses());
+        writer_.endObject();
+    }
+
+    void ASTSerializer::visitClassDeclaration(const ClassDeclarationAST* ast)
+    {
+        writeHeader(ast);
+        writer_.key("class name");
+        writer_.value(ast->getClassName());
+        writer_.key("base class");
+        writer_.value(ast->getBaseClassName());
+        writer_.key("member variables");
+        writeArray(ast->getMemberVariables());
+        writer_.key("member methods");
+        writeArray(ast->getMemberMemthods());
+        writer_.endObject();
+    }
+
+    void ASTSerializer::visitMainClass(const MainClassAST* ast)
+    {
+        writeHeader(ast);
+        writer_.key("class name");
+        writer_.value(ast->getClassName());
+        writer_.key("main method");
+        visit(ast->getMainMethod());
+        writer_.endObject();
+    }
+
+    // the method body has no id and no type.
+    void ASTSerializer::visitMethodBody(const MethodBodyAST* ast)
+    {
+        writer_.beginObject();
+        writer_.key("local variables");
+        writeArray(ast->getLocalVariables());
+        writer_.key("method body");
+        writeArray(ast->getMethodBody());
+        writer_.key("return statement");
+        visit(ast->getReturnStatement());
+        writer_.endObject();
+    }
+
+    void ASTSerializer::visitMethodDeclaration(const MethodDeclarationAST* ast)
+    {
+        writeHeader(ast);
+        writer_.key("attributes");
+        writer_.beginArray();
+
+        for (std::string_view attribute : ast->getAttributes())
+        {
+            writer_.value(attribute);
+        }
+
+        writer_.endArray();
+        writer_.key("return type");
+        writer_.value(ast->getReturnType());
+        writer_.key("method name");
+        writer_.value(ast->getMethodName());
+        writer_.key("parameters");
+        writeArray(ast->getParameters());
+        writer_.key("body");
+        visit(ast->getBody());
+        writer_.endObject();
+    }
+
+    void ASTSerializer::visitMethodCall(const MethodCallAST* ast)
+    {
+        writeHeader(ast);
+        writer_.key("method name");
+        writer_.value(ast->getName());
+        writer_.key("parameters");
+        writeArray(ast->getParameters());
+        writer_.endObject();
+    }
+
+    void ASTSerializer::visitVariableDeclaration(const VariableDeclarationAST* ast)
+    {
+        writeHeader(ast);
+        writer_.key("variable type");
+        writer_.value(ast->getType());
+        writer_.key("variable name");
+        writer_.value(ast->getName());
+        writer_.endObject();
+    }
+
+    void ASTSerializer::visitVariable(const VariableAST* ast)
+    {
+        writeHeader(ast);
+        writer_.key("name");
+        writer_.value(ast->getName());
+        writer_.endObject();
+    }
+
+    void ASTSerializer::visitArray(const ArrayAST* ast)
+    {
+        writeHeader(ast);
+        writer_.key("name");
+        writer_.value(ast->getName());
+        writer_.key("index");
+        visit(ast->getIndex());
+        writer_.endObject();
+    }
+
+    void ASTSerializer::visitIfStatement(const IfStatementAST* ast)
+    {
+        writeHeader(ast);
+        writer_.key("condition");
+        visit(ast->getCondition());
+        writer_.key("then part");
+        writeStatementArray(ast->getThenPart());
+        writer_.key("else part");
+        writeStatementArray(ast->getElsePart());
+        writer_.endObject();
+    }
+
+    void ASTSerializer::visitWhileStatement(const WhileStatementAST* ast)
+    {
+        writeHeader(ast);
+        writer_.key("condition");
+        visit(ast->getCondition());
+        writer_.key("while body");
+        writeStatementArray(ast->getBody());
+        writer_.endObject();
+    }
+
+    void ASTSerializer::visitForStatement(const ForStatementAST* ast)
+    {
+        writeHeader(ast);
+        writer_.key("variable");
+        visit(ast->getVariable());
+        writer_.key("condition");
+        visit(ast->getCondition());
+        writer_.key("action");
+        visit(ast->getAction());
+        writer_.key("body");
+        writeStatementArray(ast->getBody());
+        writer_.endObject();
+    }
+
+    void ASTSerializer::visitReturnStatement(const ReturnStatementAST* ast)
+    {
+        writeHeader(ast);
+        writer_.key("return expression");
+        visit(ast->getReturnStatement());
+        writer_.endObject();
+    }
+
+    void ASTSerializer::visitPrintStatement(const PrintStatementAST* ast)
+    {
+        writeHeader(ast);
+        writer_.key("print expression");
+        visit(ast->getPrintStatement());
+        writer_.endObject();
+    }
+
+    void ASTSerializer::visitNewStatement(const NewStatementAST* ast)
+    {
+        const ExprAST* expression = ast->getNewStatement();
+
+        writeHeader(ast);
+        writer_.key("variable type");
+        writer_.value(ast->getType());
+        // new Foo() is a method call, new int[n] has a length.
+        writer_.key(expression != nullptr && expression->getID() == ASTType::METHODCALL ? "expression" : "length");
+        visit(expression);
+        writer_.endObject();
+    }
+
+    // a chain of operators is as deep as it is long, so the operands which
+    // are operators too are written from operators_ instead of by recursion.
+    void ASTSerializer::visitBinaryOpExpression(const BinaryOpExpressionAST* ast)
+    {
+        std::size_t base = operators_.size();
+        operators_.push_back(Operator{ast, 0});
+
+        while (operators_.size() > base)
+        {
+            Operator& top = operators_.back();
+            const BinaryOpExpressionAST* node = top.ast;
+
+            if (top.operand == 0)
+            {
+                writeHeader(node);
+                writer_.key("binary operator");
+                writer_.value(Dictionary::spell(node->getBinaryOp()));
+                writer_.key("lhs");
+            }
+            else if (top.operand == 1)
+            {
+                writer_.key("rhs");
+            }
+            else
+            {
+                writer_.endObject();
+                operators_.pop_back();
+                continue;
+            }
+
+            const ExprAST* operand = top.operand++ == 0 ? node->getLhs() : node->getRhs();
+
+            if (operand != nullptr && operand->getID() == ASTType::BINARYOPEXPRESSION)
+            {
+                operators_.push_back(Operator{static_cast<const BinaryOpExpressionAST*>(operand), 0});
+            }
+            else
+            {
+                visit(operand);
+            }
+        }
+    }
+
+    void ASTSerializer::visitUnaryOpExpression(const UnaryOpExpressionAST* ast)
+    {
+        writeHeader(ast);
+        writer_.key("unary operator");
+        writer_.value(Dictionary::spell(ast->getUnaryOp()));
+        writer_.key("expression");
+        visit(ast->getExpression());
+        writer_.endObject();
+    }
+} // namespace MJava
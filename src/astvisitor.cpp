@@ -0,0 +1,247 @@
+// THIS FILE IS PART OF MJava-Compiler PROJECT
+// astvisitor.cpp - visitors of the abstract syntax tree
+
+// Created by Li Taiji 2026-10-17
+// Copyright (c) 2026 Li Taiji All rights reserved
+
+#include "astvisitor.h"
+
+namespace MJava
+{
+    void ASTVisitor::visit(const ExprAST* ast)
+    {
+        if (ast == nullptr)
+        {
+            visitNull();
+            return;
+        }
+
+        switch (ast->getID())
+        {
+            case ASTType::PROGRAM:
+                visitProgram(static_cast<const ProgramAST*>(ast));
+                break;
+
+            case ASTType::BLOCK:
+                visitBlock(static_cast<const BlockAST*>(ast));
+                break;
+
+            case ASTType::CLASSDECLARATION:
+                visitClassDeclaration(static_cast<const ClassDeclarationAST*>(ast));
+                break;
+
+            case ASTType::MAINCLASS:
+                visitMainClass(static_cast<const MainClassAST*>(ast));
+                break;
+
+            case ASTType::METHODBODY:
+                visitMethodBody(static_cast<const MethodBodyAST*>(ast));
+                break;
+
+            case ASTType::METHODDECLARATION:
+                visitMethodDeclaration(static_cast<const MethodDeclarationAST*>(ast));
+                break;
+
+            case ASTType::METHODCALL:
+                visitMethodCall(static_cast<const MethodCallAST*>(ast));
+                break;
+
+            case ASTType::VARIABLEDECLARATION:
+                visitVariableDeclaration(static_cast<const VariableDeclarationAST*>(ast));
+                break;
+
+            case ASTType::VARIABLE:
+                visitVariable(static_cast<const VariableAST*>(ast));
+                break;
+
+            case ASTType::ARRAY:
+                visitArray(static_cast<const ArrayAST*>(ast));
+                break;
+
+            case ASTType::IFSTATEMENT:
+                visitIfStatement(static_cast<const IfStatementAST*>(ast));
+                break;
+
+            case ASTType::WHILESTATEMENT:
+                visitWhileStatement(static_cast<const WhileStatementAST*>(ast));
+                break;
+
+            case ASTType::FORSTATEMENT:
+                visitForStatement(static_cast<const ForStatementAST*>(ast));
+                break;
+
+            case ASTType::RETURNSTATEMENT:
+                visitReturnStatement(static_cast<const ReturnStatementAST*>(ast));
+                break;
+
+            case ASTType::PRINTSTATEMENT:
+                visitPrintStatement(static_cast<const PrintStatementAST*>(ast));
+                break;
+
+            case ASTType::NEWSTATEMENT:
+                visitNewStatement(static_cast<const NewStatementAST*>(ast));
+                break;
+
+            case ASTType::BINARYOPEXPRESSION:
+                visitBinaryOpExpression(static_cast<const BinaryOpExpressionAST*>(ast));
+                break;
+
+            case ASTType::UNARYOPEXPRESSION:
+                visitUnaryOpExpression(static_cast<const UnaryOpExpressionAST*>(ast));
+                break;
+
+            case ASTType::REAL:
+                visitReal(static_cast<const RealAST*>(ast));
+                break;
+
+            case ASTType::INTEGER:
+                visitInteger(static_cast<const IntegerAST*>(ast));
+                break;
+
+            case ASTType::CHAR:
+                visitChar(static_cast<const CharAST*>(ast));
+                break;
+
+            case ASTType::STRING:
+                visitString(static_cast<const StringAST*>(ast));
+                break;
+
+            case ASTType::BOOLEAN:
+                visitBoolean(static_cast<const BooleanAST*>(ast));
+                break;
+
+            default:
+                visitBase(ast);
+                break;
+        }
+    }
+
+    void ASTVisitor::visitNull()
+    {}
+
+    void ASTVisitor::visitBase(const ExprAST*)
+    {}
+
+    void ASTVisitor::visitProgram(const ProgramAST* ast)
+    {
+        visitBase(ast);
+    }
+
+    void ASTVisitor::visitBlock(const BlockAST* ast)
+    {
+        visitBase(ast);
+    }
+
+    void ASTVisitor::visitClassDeclaration(const ClassDeclarationAST* ast)
+    {
+        visitBase(ast);
+    }
+
+    void ASTVisitor::visitMainClass(const MainClassAST* ast)
+    {
+        visitBase(ast);
+    }
+
+    void ASTVisitor::visitMethodBody(const MethodBodyAST* ast)
+    {
+        visitBase(ast);
+    }
+
+    void ASTVisitor::visitMethodDeclaration(const MethodDeclarationAST* ast)
+    {
+        visitBase(ast);
+    }
+
+    void ASTVisitor::visitMethodCall(const MethodCallAST* ast)
+    {
+        visitBase(ast);
+    }
+
+    void ASTVisitor::visitVariableDeclaration(const VariableDeclarationAST* ast)
+    {
+        visitBase(ast);
+    }
+
+    void ASTVisitor::visitVariable(const VariableAST* ast)
+    {
+        visitBase(ast);
+    }
+
+    void ASTVisitor::visitArray(const ArrayAST* ast)
+    {
+        visitBase(ast);
+    }
+
+    void ASTVisitor::visitIfStatement(const IfStatementAST* ast)
+    {
+        visitBase(ast);
+    }
+
+    void ASTVisitor::visitWhileStatement(const WhileStatementAST* ast)
+    {
+        visitBase(ast);
+    }
+
+    void ASTVisitor::visitForStatement(const ForStatementAST* ast)
+    {
+        visitBase(ast);
+    }
+
+    void ASTVisitor::visitReturnStatement(const ReturnStatementAST* ast)
+    {
+        visitBase(ast);
+    }
+
+    void ASTVisitor::visitPrintStatement(const PrintStatementAST* ast)
+    {
+        visitBase(ast);
+    }
+
+    void ASTVisitor::visitNewStatement(const NewStatementAST* ast)
+    {
+        visitBase(ast);
+    }
+
+    void ASTVisitor::visitBinaryOpExpression(const BinaryOpExpressionAST* ast)
+    {
+        visitBase(ast);
+    }
+
+    void ASTVisitor::visitUnaryOpExpression(const UnaryOpExpressionAST* ast)
+    {
+        visitBase(ast);
+    }
+
+    void ASTVisitor::visitReal(const RealAST* ast)
+    {
+        visitBase(ast);
+    }
+
+    void ASTVisitor::visitInteger(const IntegerAST* ast)
+    {
+        visitBase(ast);
+    }
+
+    void ASTVisitor::visitChar(const CharAST* ast)
+    {
+        visitBase(ast);
+    }
+
+    void ASTVisitor::visitString(const StringAST* ast)
+    {
+        visitBase(ast);
+    }
+
+    void ASTVisitor::visitBoolean(const BooleanAST* ast)
+    {
+        visitBase(ast);
+    }
+
+    std::size_t countNodes(const ExprAST* root)
+    {
+        std::size_t count = 0;
+        forEachNode(root, [&count](const ExprAST*) { ++count; });
+
+        return count;
+    }
+} // namespace MJava
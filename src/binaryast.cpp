@@ -0,0 +1,281 @@
+// THIS FILE IS PART OF MJava-Compiler PROJECT
+// binaryast.cpp - binary file format of the flat syntax tree
+
+// Created by Li Taiji 2026-10-17
+// Copyright (c) 2026 Li Taiji All rights reserved
+
+#include "binaryast.h"
+#include <vector>
+
+namespace MJava
+{
+    namespace
+    {
+        // what the slots of a node hold, as described in flatast.h.
+        enum class SlotKind : std::uint8_t
+        {
+            NONE,
+            CHILD,
+            LIST,
+            NAME_LIST
+        };
+
+        struct SlotLayout
+        {
+            SlotKind    slots[4];
+        };
+
+        SlotLayout getSlotLayout(ASTType type)
+        {
+            constexpr SlotKind N = SlotKind::NONE;
+            constexpr SlotKind C = SlotKind::CHILD;
+            constexpr SlotKind L = SlotKind::LIST;
+
+            switch (type)
+            {
+                case ASTType::PROGRAM:
+                case ASTType::BLOCK:
+                case ASTType::METHODCALL:
+                    return SlotLayout{{L, N, N, N}};
+
+                case ASTType::CLASSDECLARATION:
+                    return SlotLayout{{L, L, N, N}};
+
+                case ASTType::METHODBODY:
+                    return SlotLayout{{L, L, C, N}};
+
+                case ASTType::METHODDECLARATION:
+                    return SlotLayout{{SlotKind::NAME_LIST, L, C, N}};
+
+                case ASTType::MAINCLASS:
+                case ASTType::ARRAY:
+                case ASTType::RETURNSTATEMENT:
+                case ASTType::PRINTSTATEMENT:
+                case ASTType::NEWSTATEMENT:
+                case ASTType::UNARYOPEXPRESSION:
+                    return SlotLayout{{C, N, N, N}};
+
+                case ASTType::WHILESTATEMENT:
+                case ASTType::BINARYOPEXPRESSION:
+                    return SlotLayout{{C, C, N, N}};
+
+                case ASTType::IFSTATEMENT:
+                    return SlotLayout{{C, C, C, N}};
+
+                case ASTType::FORSTATEMENT:
+                    return SlotLayout{{C, C, C, C}};
+
+                default:
+                    // names only, or a value in the slots.
+                    return SlotLayout{{N, N, N, N}};
+            }
+        }
+    } // namespace
+
+    BinaryAST::BinaryAST()
+        : nodes_(nullptr), nodeCount_(0), lists_(nullptr), listCount_(0),
+          stringOffsets_(nullptr), stringCount_(0), strings_(nullptr)
+    {}
+
+    void BinaryAST::write(const FlatAST& tree, std::ostream& out)
+    {
+        const SymbolTable& names = tree.getSymbolTable();
+        std::vector<std::uint32_t> stringOffsets;
+        std::uint32_t stringBytes = 0;
+
+        stringOffsets.reserve(names.size() + 1);
+
+        for (Symbol symbol = 0; symbol < names.size(); symbol++)
+        {
+            stringOffsets.push_back(stringBytes);
+            stringBytes += static_cast<std::uint32_t>(names.getName(symbol).size());
+        }
+
+        stringOffsets.push_back(stringBytes);
+
+        BinaryASTHeader header = {};
+        header.magic = MAGIC;
+        header.version = VERSION;
+        header.nodeCount = static_cast<std::uint32_t>(tree.size());
+        header.listCount = static_cast<std::uint32_t>(tree.lists().size());
+        header.stringCount = static_cast<std::uint32_t>(names.size());
+        header.stringBytes = stringBytes;
+
+        out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+        out.write(reinterpret_cast<const char*>(tree.nodes().data()),
+                  static_cast<std::streamsize>(tree.size() * sizeof(FlatNode)));
+        out.write(reinterpret_cast<const char*>(tree.lists().data()),
+                  static_cast<std::streamsize>(tree.lists().size() * sizeof(std::uint32_t)));
+        out.write(reinterpret_cast<const char*>(stringOffsets.data()),
+                  static_cast<std::streamsize>(stringOffsets.size() * sizeof(std::uint32_t)));
+
+        for (Symbol symbol = 0; symbol < names.size(); symbol++)
+        {
+            std::string_view name = names.getName(symbol);
+            out.write(name.data(), static_cast<std::streamsize>(name.size()));
+        }
+
+        // keep the size of the file a multiple of 4.
+        static const char PADDING[4] = {};
+        out.write(PADDING, (4 - stringBytes % 4) % 4);
+    }
+
+    bool BinaryAST::open(const std::string& fileName)
+    {
+        nodes_ = nullptr;
+        nodeCount_ = 0;
+
+        if (!file_.open(fileName))
+        {
+            return false;
+        }
+
+        if (!validate())
+        {
+            file_.close();
+            nodes_ = nullptr;
+            nodeCount_ = 0;
+            return false;
+        }
+
+        return true;
+    }
+
+    // check the sizes of the sections against the size of the file, and every
+    // index, list and string offset against its section, so that a cut,
+    // foreign or corrupt file is refused instead of read past its end. the
+    // children of a node come after it, so a walk of the tree always ends.
+    bool BinaryAST::validate()
+    {
+        if (file_.size() < sizeof(BinaryASTHeader))
+        {
+            return false;
+        }
+
+        const BinaryASTHeader* header = reinterpret_cast<const BinaryASTHeader*>(file_.data());
+
+        if (header->magic != MAGIC || header->version != VERSION || header->listCount == 0)
+        {
+            return false;
+        }
+
+        std::size_t nodeBytes = static_cast<std::size_t>(header->nodeCount) * sizeof(FlatNode);
+        std::size_t listBytes = static_cast<std::size_t>(header->listCount) * sizeof(std::uint32_t);
+        std::size_t offsetBytes = (static_cast<std::size_t>(header->stringCount) + 1) * sizeof(std::uint32_t);
+
+        if (sizeof(BinaryASTHeader) + nodeBytes + listBytes + offsetBytes + header->stringBytes > file_.size())
+        {
+            return false;
+        }
+
+        const char* data = file_.data() + sizeof(BinaryASTHeader);
+
+        nodes_ = reinterpret_cast<const FlatNode*>(data);
+        nodeCount_ = header->nodeCount;
+        data += nodeBytes;
+
+        lists_ = reinterpret_cast<const std::uint32_t*>(data);
+        listCount_ = header->listCount;
+        data += listBytes;
+
+        stringOffsets_ = reinterpret_cast<const std::uint32_t*>(data);
+        stringCount_ = header->stringCount;
+        data += offsetBytes;
+
+        strings_ = data;
+
+        return validateStrings(header->stringBytes) && validateNodes();
+    }
+
+    bool BinaryAST::validateStrings(std::uint32_t stringBytes) const
+    {
+        if (stringOffsets_[0] != 0 || stringOffsets_[stringCount_] != stringBytes)
+        {
+            return false;
+        }
+
+        for (std::size_t i = 0; i < stringCount_; i++)
+        {
+            if (stringOffsets_[i] > stringOffsets_[i + 1])
+            {
+                return false;
+            }
+        }
+
+        return true;
+    }
+
+    bool BinaryAST::validateNodes() const
+    {
+        // the lists lie one after another, each its length and its items.
+        // list 0 is the empty list.
+        std::vector<bool> listStarts(listCount_, false);
+
+        if (lists_[0] != 0)
+        {
+            return false;
+        }
+
+        for (std::size_t slot = 0; slot < listCount_; slot += lists_[slot] + 1)
+        {
+            if (lists_[slot] >= listCount_ - slot)
+            {
+                return false;
+            }
+
+            listStarts[slot] = true;
+        }
+
+        for (std::size_t index = 0; index < nodeCount_; index++)
+        {
+            const FlatNode& node = nodes_[index];
+
+            if (node.type > static_cast<std::uint8_t>(ASTType::BOOLEAN) ||
+                node.op > static_cast<std::uint8_t>(TokenValue::UNRESERVED) ||
+                node.names[0] >= stringCount_ || node.names[1] >= stringCount_)
+            {
+                return false;
+            }
+
+            SlotLayout layout = getSlotLayout(node.getType());
+
+            for (std::size_t i = 0; i < 4; i++)
+            {
+                std::uint32_t slot = node.slots[i];
+
+                switch (layout.slots[i])
+                {
+                    case SlotKind::CHILD:
+                        if (slot != FLAT_NULL && (slot <= index || slot >= nodeCount_))
+                        {
+                            return false;
+                        }
+                        break;
+
+                    case SlotKind::LIST:
+                    case SlotKind::NAME_LIST:
+                        if (slot >= listCount_ || !listStarts[slot])
+                        {
+                            return false;
+                        }
+
+                        for (std::uint32_t item : getList(slot))
+                        {
+                            bool valid = layout.slots[i] == SlotKind::LIST ? item > index && item < nodeCount_
+                                                                           : item < stringCount_;
+                            if (!valid)
+                            {
+                                return false;
+                            }
+                        }
+                        break;
+
+                    default:
+                        break;
+                }
+            }
+        }
+
+        return true;
+    }
+} // namespace MJava
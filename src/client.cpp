@@ -0,0 +1,212 @@
+// THIS FILE IS PART OF MJava-Compiler PROJECT
+// client.cpp - send a source file to the compile server
+
+// Created by Li Taiji 2026-10-17
+// Copyright (c) 2026 Li Taiji All rights reserved
+
+#include "serverprotocol.h"
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <string>
+#include <vector>
+
+#if !defined(_WIN32)
+    #include <climits>
+#endif
+
+namespace
+{
+    void printUsage()
+    {
+        std::cout << "Usage: ParserClient [--socket <Socket>] [--tokens|--diagnostics|--binary] [--compact] [--dfa] [--inline] [--max-errors <Count>] [--all-errors] [--error-format text|json] <Source File> [[-o] <Output File>]\n"
+                  << "       ParserClient [--socket <Socket>] --ping|--shutdown\n"
+                  << "Sends the source file to the server started by \"Parser --serve\" or \"Lexer --serve\".\n"
+                  << "Output File is \"SyntaxOut.txt\", or \"tokenOut.txt\" for --tokens, by default. it may be given with -o, as for the compiler.\n"
+                  << "--socket is \"" << MJava::getDefaultServerSocket() << "\" by default.\n"
+                  << "--tokens writes the tokens instead of the syntax tree.\n"
+                  << "--diagnostics only prints the errors of the source.\n"
+                  << "--max-errors, --all-errors and --error-format are the same as for the compiler.\n"
+                  << "--inline sends the text of the source instead of its path, for a server which can not read it.\n"
+                  << "--ping prints the version of the server, --shutdown stops it." << std::endl;
+    }
+
+    // the server reads the file itself, and it may run in another directory.
+    std::string absolutePath(const std::string& fileName)
+    {
+#if defined(_WIN32)
+        return fileName;
+
+#else
+        char path[PATH_MAX];
+        return ::realpath(fileName.c_str(), path) != nullptr ? std::string(path) : fileName;
+#endif
+    }
+} // namespace
+
+int main(int argc, char** argv)
+{
+    std::vector<std::string> arguments;
+    std::string outputFile;
+    std::string socketPath = MJava::getDefaultServerSocket();
+    MJava::Message request;
+    bool sendText = false;
+
+    request.setField("command", "compile");
+    request.setField("output", "json");
+
+    for (int i = 1; i < argc; i++)
+    {
+        std::string argument = argv[i];
+
+        if ((argument == "--socket" || argument == "--error-format" || argument == "--max-errors" || argument == "-o") &&
+            i + 1 >= argc)
+        {
+            std::cerr << "Missing value for " << argument << std::endl;
+            printUsage();
+            return 0;
+        }
+
+        if (argument == "--socket")
+        {
+            socketPath = argv[++i];
+        }
+        else if (argument == "--tokens" || argument == "--diagnostics" || argument == "--binary")
+        {
+            request.setField("output", argument.substr(2));
+        }
+        else if (argument == "--compact")
+        {
+            request.setField("compact", "1");
+        }
+        else if (argument == "--dfa")
+        {
+            request.setField("engine", "dfa");
+        }
+        else if (argument == "--error-format")
+        {
+            request.setField("errors", argv[++i]);
+        }
+        else if (argument == "--max-errors")
+        {
+            request.setField("maxerrors", argv[++i]);
+        }
+        else if (argument == "--all-errors")
+        {
+            request.setField("allerrors", "1");
+        }
+        else if (argument == "--inline")
+        {
+            sendText = true;
+        }
+        else if (argument == "--ping" || argument == "--shutdown")
+        {
+            request.setField("command", argument.substr(2));
+        }
+        else if (argument == "-o")
+        {
+            outputFile = argv[++i];
+        }
+        else
+        {
+            arguments.push_back(argument);
+        }
+    }
+
+    std::string command = request.getField("command");
+    std::string output = request.getField("output");
+
+    if (command == "compile")
+    {
+        if (arguments.empty())
+        {
+            std::cerr << "Missing source file!" << std::endl;
+            printUsage();
+            return 0;
+        }
+
+        // one source file, and its output file once.
+        if (arguments.size() > 2 || (arguments.size() == 2 && !outputFile.empty()))
+        {
+            std::cerr << "Too many files: " << arguments.back() << std::endl;
+            printUsage();
+            return 0;
+        }
+
+        if (sendText)
+        {
+            std::ifstream in(arguments[0], std::ios::in | std::ios::binary);
+
+            if (in.fail())
+            {
+                std::cerr << "File Error: Source file " << arguments[0] << " can not be read!" << std::endl;
+                return 1;
+            }
+
+            request.setField("name", arguments[0]);
+            request.setBody(std::string(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>()));
+        }
+        else
+        {
+            request.setField("file", absolutePath(arguments[0]));
+            request.setField("name", arguments[0]);
+        }
+    }
+
+    MJava::Connection connection;
+    MJava::Message response;
+
+    if (!connection.open(socketPath))
+    {
+        std::cerr << "No compile server is listening on " << socketPath << "." << std::endl;
+        return 1;
+    }
+
+    // another user may have taken the socket path in /tmp before the server.
+    if (!connection.isSameUser())
+    {
+        std::cerr << "The compile server on " << socketPath << " is run by another user." << std::endl;
+        return 1;
+    }
+
+    if (!connection.write(request) || !connection.read(response))
+    {
+        std::cerr << "The compile server closed the connection." << std::endl;
+        return 1;
+    }
+
+    const std::string& body = response.getBody();
+    std::size_t outputSize = static_cast<std::size_t>(std::strtoull(response.getField("output", "0").c_str(), nullptr, 10));
+
+    if (outputSize > body.size())
+    {
+        outputSize = body.size();
+    }
+
+    if (command == "ping")
+    {
+        std::cout << response.getField("version") << std::endl;
+    }
+    else if (command == "compile" && output != "diagnostics" && response.getField("status") != "failed")
+    {
+        if (outputFile.empty())
+        {
+            outputFile = arguments.size() > 1 ? arguments[1] : (output == "tokens" ? "./tokenOut.txt" : "./SyntaxOut.txt");
+        }
+
+        std::ofstream of(outputFile, std::ios::out | std::ios::binary);
+
+        if (of.fail())
+        {
+            std::cerr << "File Error: Output file " << outputFile << " can not be created!" << std::endl;
+            return 1;
+        }
+
+        of.write(body.data(), static_cast<std::streamsize>(outputSize));
+    }
+
+    std::cerr << body.substr(outputSize);
+
+    return response.getField("status") == "ok" ? 0 : 1;
+}
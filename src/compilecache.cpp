@@ -0,0 +1,251 @@
+// THIS FILE IS PART OF MJava-Compiler PROJECT
+// compilecache.cpp - outputs of earlier compilations, found by content hash
+
+// Created by Li Taiji 2026-10-17
+// Copyright (c) 2026 Li Taiji All rights reserved
+
+#include "compilecache.h"
+#include <algorithm>
+#include <cstring>
+#include <filesystem>
+#include <system_error>
+#include <thread>
+#include <vector>
+
+#if defined(_WIN32)
+    #include <process.h>
+#else
+    #include <unistd.h>
+#endif
+
+namespace MJava
+{
+    namespace
+    {
+        const std::string_view ENTRY_SUFFIX = ".mjc";
+        const std::size_t KEY_SIZE = 32;
+
+        // the finalizer of MurmurHash3.
+        std::uint64_t mix(std::uint64_t hash)
+        {
+            hash ^= hash >> 33;
+            hash *= 0xFF51AFD7ED558CCDULL;
+            hash ^= hash >> 33;
+            hash *= 0xC4CEB9FE1A85EC53ULL;
+            hash ^= hash >> 33;
+            return hash;
+        }
+
+        // two 64-bit lanes over 8-byte words, each with its own multiplier.
+        // it is not a cryptographic hash, the 128 bits only make an accidental
+        // collision of two sources very unlikely.
+        class Hasher
+        {
+          public:
+            Hasher() : first_(0x9E3779B97F4A7C15ULL), second_(0xC2B2AE3D27D4EB4FULL), length_(0) {}
+
+            void update(const char* data, std::size_t size)
+            {
+                std::size_t i = 0;
+
+                for (; i + 8 <= size; i += 8)
+                {
+                    std::uint64_t word;
+                    std::memcpy(&word, data + i, sizeof(word));
+                    addWord(word);
+                }
+
+                // the tail, with its length so that "a" and "a\0" differ.
+                std::uint64_t word = size - i;
+
+                for (std::size_t shift = 8; i < size; i++, shift += 8)
+                {
+                    word ^= static_cast<std::uint64_t>(static_cast<unsigned char>(data[i])) << (shift % 64);
+                }
+
+                addWord(word);
+                length_ += size;
+            }
+
+            std::string hexDigest() const
+            {
+                static const char HEX_DIGITS[] = "0123456789abcdef";
+
+                std::uint64_t words[2] = {mix(first_ ^ length_), mix(second_ + length_)};
+                std::string digest;
+
+                for (std::uint64_t word : words)
+                {
+                    for (int shift = 60; shift >= 0; shift -= 4)
+                    {
+                        digest += HEX_DIGITS[(word >> shift) & 0xF];
+                    }
+                }
+
+                return digest;
+            }
+
+          private:
+            void addWord(std::uint64_t word)
+            {
+                first_ = (first_ ^ mix(word)) * 0x87C37B91114253D5ULL;
+                first_ = (first_ << 31) | (first_ >> 33);
+                second_ = (second_ + mix(word ^ 0x4CF5AD432745937FULL)) * 0x52DCE729ULL;
+                second_ = (second_ << 27) | (second_ >> 37);
+            }
+
+          private:
+            std::uint64_t   first_;
+            std::uint64_t   second_;
+            std::uint64_t   length_;
+        };
+
+        long processId()
+        {
+#if defined(_WIN32)
+            return static_cast<long>(_getpid());
+#else
+            return static_cast<long>(getpid());
+#endif
+        }
+    } // namespace
+
+    CompileCache::CompileCache(const std::string& directory, std::uintmax_t maxBytes)
+        : directory_(directory), maxBytes_(maxBytes), hits_(0), misses_(0), stores_(0), evictions_(0)
+    {
+        std::error_code error;
+        std::filesystem::create_directories(directory_, error);
+    }
+
+    std::string CompileCache::makeKey(const char* data, std::size_t size, std::string_view options)
+    {
+        Hasher hasher;
+
+        hasher.update(COMPILER_VERSION.data(), COMPILER_VERSION.size());
+        hasher.update(options.data(), options.size());
+        hasher.update(data, size);
+
+        return hasher.hexDigest();
+    }
+
+    bool CompileCache::fetch(const std::string& key, const std::string& outputFile)
+    {
+        std::error_code error;
+        std::string path = entryPath(key);
+
+        if (!std::filesystem::copy_file(path, outputFile, std::filesystem::copy_options::overwrite_existing, error))
+        {
+            misses_.fetch_add(1, std::memory_order_relaxed);
+            return false;
+        }
+
+        // used now, so it is the last one to be evicted.
+        std::filesystem::last_write_time(path, std::filesystem::file_time_type::clock::now(), error);
+        hits_.fetch_add(1, std::memory_order_relaxed);
+
+        return true;
+    }
+
+    void CompileCache::store(const std::string& key, const std::string& outputFile)
+    {
+        std::error_code error;
+        std::string path = entryPath(key);
+        // copy to a file of this process and thread first, so that nobody sees a
+        // half-written entry. processes sharing the directory never share the file.
+        std::string temporary = path + ".tmp" + std::to_string(processId()) + "-" +
+                                std::to_string(std::hash<std::thread::id>()(std::this_thread::get_id()));
+
+        if (!std::filesystem::copy_file(outputFile, temporary, std::filesystem::copy_options::overwrite_existing, error))
+        {
+            return;
+        }
+
+        std::filesystem::rename(temporary, path, error);
+
+        if (error)
+        {
+            std::filesystem::remove(temporary, error);
+            return;
+        }
+
+        stores_.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    void CompileCache::evict()
+    {
+        struct Entry
+        {
+            std::filesystem::path               path;
+            std::filesystem::file_time_type     time;
+            std::uintmax_t                      size;
+        };
+
+        std::error_code error;
+        std::vector<Entry> entries;
+        std::uintmax_t totalBytes = 0;
+
+        for (const std::filesystem::directory_entry& file : std::filesystem::directory_iterator(directory_, error))
+        {
+            // the temporary files of other writers and the files of the user are left alone.
+            if (!isEntryName(file.path().filename().string()) || !file.is_regular_file(error))
+            {
+                continue;
+            }
+
+            Entry entry{file.path(), file.last_write_time(error), file.file_size(error)};
+
+            if (!error)
+            {
+                totalBytes += entry.size;
+                entries.push_back(entry);
+            }
+        }
+
+        if (totalBytes <= maxBytes_)
+        {
+            return;
+        }
+
+        std::sort(entries.begin(), entries.end(), [](const Entry& lhs, const Entry& rhs)
+        {
+            return lhs.time < rhs.time;
+        });
+
+        for (const Entry& entry : entries)
+        {
+            if (totalBytes <= maxBytes_)
+            {
+                break;
+            }
+
+            if (std::filesystem::remove(entry.path, error))
+            {
+                totalBytes -= entry.size;
+                evictions_.fetch_add(1, std::memory_order_relaxed);
+            }
+        }
+    }
+
+    CompileCache::Statistics CompileCache::getStatistics() const
+    {
+        return Statistics{hits_.load(), misses_.load(), stores_.load(), evictions_.load()};
+    }
+
+    std::string CompileCache::entryPath(const std::string& key) const
+    {
+        return (std::filesystem::path(directory_) / (key + std::string(ENTRY_SUFFIX))).string();
+    }
+
+    bool CompileCache::isEntryName(const std::string& fileName)
+    {
+        if (fileName.size() != KEY_SIZE + ENTRY_SUFFIX.size() || fileName.compare(KEY_SIZE, std::string::npos, ENTRY_SUFFIX) != 0)
+        {
+            return false;
+        }
+
+        return std::all_of(fileName.begin(), fileName.begin() + KEY_SIZE, [](char c)
+        {
+            return (c >= '0' && c <= '9') || (c >= 'a' && c <= 'f');
+        });
+    }
+} // namespace MJava
@@ -0,0 +1,481 @@
+// THIS FILE IS PART OF MJava-Compiler PROJECT
+// compileserver.cpp - answer compile requests on a Unix domain socket
+
+// Created by Li Taiji 2026-10-17
+// Copyright (c) 2026 Li Taiji All rights reserved
+
+#include "compilecache.h"
+#include "compileserver.h"
+#include "diagnostic.h"
+#include "driver.h"
+#include "error.h"
+#include "scanner.h"
+#include "sourcebuffer.h"
+#include "threadpool.h"
+#include <cstdlib>
+#include <iostream>
+#include <memory>
+#include <sstream>
+#include <vector>
+
+#if !defined(_WIN32)
+    #include <cerrno>
+    #include <cstring>
+    #include <fcntl.h>
+    #include <poll.h>
+    #include <sys/socket.h>
+    #include <sys/stat.h>
+    #include <sys/un.h>
+    #include <unistd.h>
+#endif
+
+namespace MJava
+{
+    namespace
+    {
+        // a client which does not take its answer for longer is dropped.
+        const int CONNECTION_TIMEOUT_SECONDS = 10;
+        // the connections open at the same time, the others are refused.
+        const std::size_t MAX_CONNECTIONS = 256;
+        // a request with a longer source is dropped before it is read.
+        const std::size_t MAX_REQUEST_BODY_SIZE = 256 * 1024 * 1024;
+    } // namespace
+
+    CompileServer::CompileServer(const Options& options)
+        : options_(options), listenFd_(-1), stopping_(false), connectionCount_(0), wakeFds_{-1, -1}, cacheBytes_(0)
+    {}
+
+#if defined(_WIN32)
+    bool CompileServer::run()
+    {
+        errorFile("The compile server needs Unix domain sockets, which are not supported here.");
+        return false;
+    }
+
+    void CompileServer::stop()
+    {
+        stopping_ = true;
+    }
+
+    void CompileServer::acceptConnection(std::vector<std::unique_ptr<Connection>>& /* idle */)
+    {}
+
+    void CompileServer::serveRequest(Connection* connection)
+    {
+        delete connection;
+    }
+
+    void CompileServer::closeConnection(std::unique_ptr<Connection> /* connection */)
+    {}
+
+    void CompileServer::wakeUp()
+    {}
+
+#else
+    bool CompileServer::run()
+    {
+        const std::string& socketPath = options_.socketPath;
+        sockaddr_un address;
+        std::memset(&address, 0, sizeof(address));
+        address.sun_family = AF_UNIX;
+
+        if (socketPath.size() >= sizeof(address.sun_path))
+        {
+            errorFile("Socket path " + socketPath + " is too long!");
+            return false;
+        }
+
+        std::memcpy(address.sun_path, socketPath.c_str(), socketPath.size() + 1);
+
+        // the socket file of a server which has died is removed, a live server is left alone.
+        Connection probe;
+
+        if (probe.open(socketPath))
+        {
+            errorFile("A compile server is already listening on " + socketPath + "!");
+            return false;
+        }
+
+        ::unlink(socketPath.c_str());
+
+        listenFd_ = ::socket(AF_UNIX, SOCK_STREAM, 0);
+
+        // nobody can connect before listen(), so only the user can connect at all.
+        if (listenFd_ < 0 ||
+            ::bind(listenFd_, reinterpret_cast<sockaddr*>(&address), sizeof(address)) != 0 ||
+            ::chmod(socketPath.c_str(), S_IRUSR | S_IWUSR) != 0 ||
+            ::listen(listenFd_, SOMAXCONN) != 0 ||
+            ::pipe(wakeFds_) != 0)
+        {
+            errorFile("Can not listen on " + socketPath + ": " + std::strerror(errno));
+
+            if (listenFd_ >= 0)
+            {
+                ::close(listenFd_);
+                listenFd_ = -1;
+            }
+
+            return false;
+        }
+
+        // stop() must never block on a full pipe.
+        ::fcntl(wakeFds_[0], F_SETFL, O_NONBLOCK);
+        ::fcntl(wakeFds_[1], F_SETFL, O_NONBLOCK);
+
+        std::cout << "Compile server listening on " << socketPath << std::endl;
+
+        {
+            ThreadPool pool(options_.threads != 0 ? options_.threads : ThreadPool::defaultThreadCount());
+            // the connections waiting for their next request.
+            std::vector<std::unique_ptr<Connection>> idle;
+
+            while (!stopping_)
+            {
+                // the connections with a request to read.
+                std::vector<std::unique_ptr<Connection>> ready;
+
+                {
+                    std::lock_guard<std::mutex> lock(connectionMutex_);
+
+                    for (auto& connection : answered_)
+                    {
+                        // the next request has been sent with the last one, poll() does not see it.
+                        (connection->hasMessage() ? ready : idle).push_back(std::move(connection));
+                    }
+
+                    answered_.clear();
+                }
+
+                std::vector<pollfd> fds;
+                fds.push_back(pollfd{listenFd_, POLLIN, 0});
+                fds.push_back(pollfd{wakeFds_[0], POLLIN, 0});
+
+                for (const auto& connection : idle)
+                {
+                    fds.push_back(pollfd{connection->getFd(), POLLIN, 0});
+                }
+
+                if (::poll(fds.data(), fds.size(), ready.empty() ? -1 : 0) < 0)
+                {
+                    if (errno == EINTR)
+                    {
+                        continue;
+                    }
+
+                    break;
+                }
+
+                if (fds[1].revents != 0)
+                {
+                    char bytes[64];
+
+                    while (::read(wakeFds_[0], bytes, sizeof(bytes)) > 0)
+                    {}
+                }
+
+                // the bytes are collected here, a pool thread only gets a
+                // request which it can read without waiting for the client.
+                for (std::size_t i = idle.size(); i-- > 0;)
+                {
+                    if (fds[i + 2].revents == 0)
+                    {
+                        continue;
+                    }
+
+                    if (!idle[i]->receive())
+                    {
+                        closeConnection(std::move(idle[i]));
+                        idle.erase(idle.begin() + i);
+                    }
+                    else if (idle[i]->hasMessage())
+                    {
+                        ready.push_back(std::move(idle[i]));
+                        idle.erase(idle.begin() + i);
+                    }
+                }
+
+                if (fds[0].revents != 0)
+                {
+                    acceptConnection(idle);
+                }
+
+                for (auto& connection : ready)
+                {
+                    Connection* served = connection.release();
+
+                    pool.submit([this, served]
+                    {
+                        serveRequest(served);
+                    });
+                }
+            }
+
+            // the idle connections are closed here, and the pool finishes the
+            // requests it has before it is destroyed.
+        }
+
+        answered_.clear();
+        connectionCount_ = 0;
+
+        ::close(wakeFds_[0]);
+        ::close(wakeFds_[1]);
+        wakeFds_[0] = -1;
+        wakeFds_[1] = -1;
+        ::close(listenFd_);
+        listenFd_ = -1;
+        ::unlink(socketPath.c_str());
+
+        return true;
+    }
+
+    void CompileServer::stop()
+    {
+        stopping_ = true;
+        wakeUp();
+    }
+
+    void CompileServer::acceptConnection(std::vector<std::unique_ptr<Connection>>& idle)
+    {
+        int fd = ::accept(listenFd_, nullptr, nullptr);
+
+        if (fd < 0)
+        {
+            return;
+        }
+
+        std::lock_guard<std::mutex> lock(connectionMutex_);
+
+        if (connectionCount_ >= MAX_CONNECTIONS)
+        {
+            ::close(fd);
+            return;
+        }
+
+        std::unique_ptr<Connection> connection(new Connection(fd));
+
+        // the socket can only be reached by the user, unless its directory is not the user's.
+        if (!connection->isSameUser())
+        {
+            return;
+        }
+
+        ++connectionCount_;
+        connection->setTimeout(CONNECTION_TIMEOUT_SECONDS);
+        connection->setMaxBodySize(MAX_REQUEST_BODY_SIZE);
+        idle.push_back(std::move(connection));
+    }
+
+    void CompileServer::serveRequest(Connection* connection)
+    {
+        std::unique_ptr<Connection> served(connection);
+        Message request;
+
+        // a bad request, or a client which does not take the answer in time, is dropped.
+        if (!stopping_ && served->read(request) && served->write(answer(request)))
+        {
+            std::lock_guard<std::mutex> lock(connectionMutex_);
+            answered_.push_back(std::move(served));
+            wakeUp();
+
+            return;
+        }
+
+        closeConnection(std::move(served));
+    }
+
+    void CompileServer::closeConnection(std::unique_ptr<Connection> connection)
+    {
+        connection->close();
+
+        std::lock_guard<std::mutex> lock(connectionMutex_);
+        --connectionCount_;
+    }
+
+    void CompileServer::wakeUp()
+    {
+        char byte = 0;
+        ssize_t written = ::write(wakeFds_[1], &byte, 1);
+        static_cast<void>(written);
+    }
+#endif
+
+    Message CompileServer::answer(const Message& request)
+    {
+        std::string command = request.getField("command", "compile");
+
+        if (command == "compile")
+        {
+            return compile(request);
+        }
+
+        Message response;
+
+        if (command == "ping")
+        {
+            response.setField("status", "ok");
+            response.setField("version", std::string(COMPILER_VERSION));
+        }
+        else if (command == "shutdown")
+        {
+            stop();
+            response.setField("status", "ok");
+        }
+        else
+        {
+            return makeFailure("Unknown command " + command + ".");
+        }
+
+        response.setField("output", "0");
+        return response;
+    }
+
+    Message CompileServer::compile(const Message& request)
+    {
+        std::string output = request.getField("output", "json");
+
+        if (output != "tokens" && output != "json" && output != "binary" && output != "diagnostics")
+        {
+            return makeFailure("Unknown output " + output + ".");
+        }
+
+#if defined(LEXER)
+        if (output == "json" || output == "binary")
+        {
+            return makeFailure("The lexer does not build a syntax tree, ask the parser for " + output + ".");
+        }
+#endif
+
+        Driver::Options options;
+        options.engine = request.getField("engine") == "dfa" ? Scanner::Engine::TABLE_DRIVEN : Scanner::Engine::HAND_WRITTEN;
+        options.compact = request.getField("compact") == "1";
+        options.binary = output == "binary";
+        options.batch = true;
+        options.diagnostics.format = request.getField("errors") == "json" ? DiagnosticEngine::Format::JSON
+                                                                          : DiagnosticEngine::Format::TEXT;
+        options.diagnostics.maxErrors = static_cast<std::size_t>(std::strtoull(request.getField("maxerrors", "0").c_str(), nullptr, 10));
+        options.diagnostics.deduplicate = request.getField("allerrors") != "1";
+
+        SourceBuffer file;
+        std::string_view source;
+        std::string name;
+
+        if (request.hasField("file"))
+        {
+            name = request.getField("name", request.getField("file"));
+
+            if (!file.open(request.getField("file")))
+            {
+                return makeFailure("Source file " + name + " can not be read!");
+            }
+
+            source = std::string_view(file.data(), file.size());
+        }
+        else
+        {
+            name = request.getField("name", "<source>");
+            source = request.getBody();
+        }
+
+        std::string key = CompileCache::makeKey(source.data(), source.size(),
+                                                output + ' ' + request.getField("engine") + ' ' +
+                                                request.getField("compact") + ' ' + request.getField("errors") + ' ' +
+                                                request.getField("maxerrors") + ' ' + request.getField("allerrors") + ' ' + name);
+        Message response;
+
+        if (findAnswer(key, response))
+        {
+            return response;
+        }
+
+        DiagnosticEngine diagnostics(name, options.diagnostics);
+        DiagnosticScope scope(diagnostics);
+        std::ostringstream out;
+        bool succeeded = false;
+
+        {
+            Scanner scanner(name, source, options.engine);
+
+            if (output == "tokens")
+            {
+                TokenBuffer tokens = scanner.tokenizeAll();
+
+                for (std::size_t i = 0; i < tokens.size(); i++)
+                {
+                    out << tokens.at(i).toString() << '\n';
+                }
+
+                succeeded = scanner.getErrorCount() == 0;
+            }
+            else
+            {
+                Driver driver(options);
+                succeeded = driver.compileSource(scanner, out);
+            }
+        }
+
+        std::string body = output == "diagnostics" ? std::string() : out.str();
+
+        response.setField("status", succeeded ? "ok" : "error");
+        response.setField("output", std::to_string(body.size()));
+        response.setBody(body + diagnostics.format());
+
+        keepAnswer(key, response);
+        return response;
+    }
+
+    Message CompileServer::makeFailure(const std::string& reason)
+    {
+        Message response;
+        response.setField("status", "failed");
+        response.setField("output", "0");
+        response.setBody("File Error: " + reason + '\n');
+
+        return response;
+    }
+
+    bool CompileServer::findAnswer(const std::string& key, Message& response)
+    {
+        std::lock_guard<std::mutex> lock(cacheMutex_);
+        auto iter = answerIndex_.find(key);
+
+        if (iter == answerIndex_.end())
+        {
+            return false;
+        }
+
+        answers_.splice(answers_.begin(), answers_, iter->second);
+        response = iter->second->second;
+
+        return true;
+    }
+
+    void CompileServer::keepAnswer(const std::string& key, const Message& response)
+    {
+        std::uintmax_t size = key.size() + response.getBody().size();
+
+        if (size > options_.cacheSize)
+        {
+            return;
+        }
+
+        std::lock_guard<std::mutex> lock(cacheMutex_);
+
+        // another thread may have answered the same request meanwhile.
+        if (answerIndex_.count(key) != 0)
+        {
+            return;
+        }
+
+        answers_.emplace_front(key, response);
+        answerIndex_[key] = answers_.begin();
+        cacheBytes_ += size;
+
+        while (cacheBytes_ > options_.cacheSize)
+        {
+            const auto& oldest = answers_.back();
+            cacheBytes_ -= oldest.first.size() + oldest.second.getBody().size();
+            answerIndex_.erase(oldest.first);
+            answers_.pop_back();
+        }
+    }
+} // namespace MJava
@@ -0,0 +1,214 @@
+// THIS FILE IS PART OF MJava-Compiler PROJECT
+// diagnostic.cpp - the errors of one compilation, written at once
+
+// Created by Li Taiji 2026-10-17
+// Copyright (c) 2026 Li Taiji All rights reserved
+
+#include "diagnostic.h"
+#include "jsonwriter.h"
+#include <algorithm>
+#include <iostream>
+#include <mutex>
+#include <sstream>
+#include <utility>
+
+namespace MJava
+{
+    namespace
+    {
+        // the driver compiles several files at once, everything is written
+        // as one piece so that lines of two files never mix.
+        std::mutex errorMutex;
+
+        thread_local DiagnosticScope* currentScope = nullptr;
+
+        void writeText(const std::string& text)
+        {
+            std::lock_guard<std::mutex> lock(errorMutex);
+            std::cerr << text << std::flush;
+        }
+
+        const char* getKindName(DiagnosticKind kind)
+        {
+            switch (kind)
+            {
+                case DiagnosticKind::TOKEN:
+                    return "token";
+
+                case DiagnosticKind::SYNTAX:
+                    return "syntax";
+
+                case DiagnosticKind::FILE:
+                    return "file";
+            }
+
+            return "unknown";
+        }
+    } // namespace
+
+    std::string Diagnostic::toString() const
+    {
+        std::string place = file + ":" + std::to_string(line) + ":" + std::to_string(column) + ":";
+
+        switch (kind)
+        {
+            case DiagnosticKind::TOKEN:
+                return "Token Error:" + place + message;
+
+            case DiagnosticKind::SYNTAX:
+                return "Syntax Error: " + place + message;
+
+            case DiagnosticKind::FILE:
+                return "File Error: " + message;
+        }
+
+        return message;
+    }
+
+    DiagnosticEngine::DiagnosticEngine(const std::string& fileName, const Options& options)
+        : fileName_(fileName), options_(options), duplicates_(0), omitted_(0)
+    {
+    }
+
+    void DiagnosticEngine::report(Diagnostic diagnostic)
+    {
+        // the tokens of a file may be scanned before it is parsed, and its
+        // classes parsed apart, so the diagnostics are put in the order of
+        // the source here. one at the same place stays after the ones before it.
+        auto position = std::upper_bound(diagnostics_.begin(), diagnostics_.end(), diagnostic,
+                                         [](const Diagnostic& left, const Diagnostic& right)
+        {
+            return left.line != right.line ? left.line < right.line : left.column < right.column;
+        });
+
+        if (options_.deduplicate && position != diagnostics_.begin() &&
+            diagnostic.kind != DiagnosticKind::FILE)
+        {
+            const Diagnostic& last = *(position - 1);
+
+            if (last.kind == diagnostic.kind && last.line == diagnostic.line &&
+                last.column == diagnostic.column && last.file == diagnostic.file)
+            {
+                ++duplicates_;
+                return;
+            }
+        }
+
+        // the diagnostics kept are the first ones in the source.
+        if (options_.maxErrors != 0 && diagnostics_.size() >= options_.maxErrors)
+        {
+            ++omitted_;
+
+            if (position == diagnostics_.end())
+            {
+                return;
+            }
+
+            diagnostics_.pop_back();
+        }
+
+        diagnostics_.insert(position, std::move(diagnostic));
+    }
+
+    std::string DiagnosticEngine::format() const
+    {
+        if (diagnostics_.empty() && omitted_ == 0)
+        {
+            return std::string();
+        }
+
+        if (options_.format == Format::TEXT)
+        {
+            std::string text;
+
+            for (const auto& diagnostic : diagnostics_)
+            {
+                text += diagnostic.toString();
+                text += '\n';
+            }
+
+            if (omitted_ != 0)
+            {
+                text += "Too many errors, " + std::to_string(omitted_) + " more are not shown.\n";
+            }
+
+            return text;
+        }
+
+        std::ostringstream out;
+
+        {
+            JSONWriter writer(out, false);
+            writer.beginObject();
+            writer.key("file");
+            writer.value(fileName_);
+            writer.key("errors");
+            writer.value(static_cast<std::uint64_t>(diagnostics_.size()));
+            writer.key("duplicates");
+            writer.value(static_cast<std::uint64_t>(duplicates_));
+            writer.key("omitted");
+            writer.value(static_cast<std::uint64_t>(omitted_));
+            writer.key("diagnostics");
+            writer.beginArray();
+
+            for (const auto& diagnostic : diagnostics_)
+            {
+                writer.beginObject();
+                writer.key("severity");
+                writer.value(diagnostic.severity == Severity::ERROR ? "error" : "warning");
+                writer.key("kind");
+                writer.value(getKindName(diagnostic.kind));
+                writer.key("file");
+                writer.value(diagnostic.file);
+                writer.key("line");
+                writer.value(diagnostic.line);
+                writer.key("column");
+                writer.value(diagnostic.column);
+                writer.key("message");
+                writer.value(diagnostic.message);
+                writer.endObject();
+            }
+
+            writer.endArray();
+            writer.endObject();
+        }
+
+        out << '\n';
+        return out.str();
+    }
+
+    void DiagnosticEngine::flush()
+    {
+        std::string text = format();
+
+        if (!text.empty())
+        {
+            writeText(text);
+        }
+
+        diagnostics_.clear();
+        duplicates_ = 0;
+        omitted_ = 0;
+    }
+
+    DiagnosticScope::DiagnosticScope(DiagnosticEngine& engine) : engine_(engine), previous_(currentScope)
+    {
+        currentScope = this;
+    }
+
+    DiagnosticScope::~DiagnosticScope()
+    {
+        currentScope = previous_;
+    }
+
+    void reportDiagnostic(Diagnostic diagnostic)
+    {
+        if (currentScope != nullptr)
+        {
+            currentScope->getEngine().report(std::move(diagnostic));
+            return;
+        }
+
+        writeText(diagnostic.toString() + "\n");
+    }
+} // namespace MJava
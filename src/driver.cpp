@@ -0,0 +1,345 @@
+// THIS FILE IS PART OF MJava-Compiler PROJECT
+// driver.cpp - compile many source files at once
+
+// Created by Li Taiji 2026-10-17
+// Copyright (c) 2026 Li Taiji All rights reserved
+
+#include "driver.h"
+#include "error.h"
+#include "sourcebuffer.h"
+
+#if defined(PARSER)
+    #include "astvisitor.h"
+    #include "parser.h"
+#endif
+
+#include <algorithm>
+#include <atomic>
+#include <fstream>
+#include <sstream>
+#include <utility>
+
+namespace MJava
+{
+    Driver::Driver(const Options& options) : options_(options)
+    {}
+
+    void Driver::addJob(const std::string& sourceFile, const std::string& outputFile)
+    {
+        jobs_.push_back(CompileJob{sourceFile, outputFile});
+    }
+
+    bool Driver::readResponseFile(const std::string& fileName)
+    {
+        std::ifstream in(fileName);
+
+        if (!in)
+        {
+            errorFile("Response file " + fileName + " can not be read!");
+            return false;
+        }
+
+        std::string line;
+
+        while (std::getline(in, line))
+        {
+            std::istringstream words(line);
+            std::string sourceFile;
+            std::string outputFile;
+
+            if (!(words >> sourceFile) || sourceFile[0] == '#')
+            {
+                continue;
+            }
+
+            if (!(words >> outputFile))
+            {
+                outputFile = defaultOutputFile(sourceFile);
+            }
+
+            addJob(sourceFile, outputFile);
+        }
+
+        return true;
+    }
+
+    std::string Driver::defaultOutputFile(const std::string& sourceFile)
+    {
+#if defined(LEXER)
+        return sourceFile + ".lex";
+
+#elif defined(PARSER)
+        return sourceFile + ".ast";
+
+#else
+    #error Please pass the macro definition "LEXER" or "PARSER" when compile.
+#endif
+    }
+
+    std::size_t Driver::run()
+    {
+        if (!options_.cacheDirectory.empty())
+        {
+            cache_.reset(new CompileCache(options_.cacheDirectory, options_.cacheSize));
+        }
+
+        if (options_.statistics || options_.perfCounters || !options_.traceFile.empty())
+        {
+            statistics_.reset(new CompileStatistics(!options_.traceFile.empty(), options_.perfCounters));
+        }
+
+        std::size_t failures = compileAll();
+
+        if (cache_ != nullptr)
+        {
+            cache_->evict();
+        }
+
+        if (!options_.traceFile.empty())
+        {
+            std::ofstream trace(options_.traceFile);
+
+            if (trace.fail())
+            {
+                errorFile("Trace file " + options_.traceFile + " can not be created!");
+            }
+            else
+            {
+                statistics_->writeTrace(trace);
+            }
+        }
+
+        return failures;
+    }
+
+    CompileCache::Statistics Driver::getCacheStatistics() const
+    {
+        return cache_ != nullptr ? cache_->getStatistics() : CompileCache::Statistics{0, 0, 0, 0};
+    }
+
+    std::size_t Driver::compileAll()
+    {
+        std::size_t threadCount = options_.threads != 0 ? options_.threads : ThreadPool::defaultThreadCount();
+
+        if (options_.parallelClasses)
+        {
+            std::size_t failures = 0;
+            ThreadPool pool(threadCount);
+
+            for (const CompileJob& job : jobs_)
+            {
+                if (!compile(job, &pool))
+                {
+                    ++failures;
+                }
+            }
+
+            return failures;
+        }
+
+        threadCount = std::min(threadCount, jobs_.size());
+
+        // one file is compiled right here, no thread is started for it.
+        if (threadCount <= 1)
+        {
+            std::size_t failures = 0;
+
+            for (const CompileJob& job : jobs_)
+            {
+                if (!compile(job, nullptr))
+                {
+                    ++failures;
+                }
+            }
+
+            return failures;
+        }
+
+        std::atomic<std::size_t> failures(0);
+        ThreadPool pool(threadCount);
+
+        for (const CompileJob& job : jobs_)
+        {
+            pool.submit([this, &job, &failures]
+            {
+                if (!compile(job, nullptr))
+                {
+                    failures.fetch_add(1, std::memory_order_relaxed);
+                }
+            });
+        }
+
+        pool.wait();
+
+        return failures.load();
+    }
+
+#if defined(PARSER)
+    void Driver::writeTree(const Parser& parser, std::ostream& out) const
+    {
+        if (options_.binary)
+        {
+            parser.writeBinary(out);
+        }
+        else
+        {
+            parser.writeJSON(out, !options_.compact);
+        }
+    }
+#endif
+
+    bool Driver::compile(const CompileJob& job, ThreadPool* pool) const
+    {
+        PhaseTimer timer(statistics_.get(), CompileStatistics::Phase::COMPILE, job.sourceFile);
+        std::string key;
+        SourceBuffer source;
+
+        // a file that can not be read is left to the scanner to report. the
+        // source is read once, so the output is always stored under the key
+        // of the text it was compiled from.
+        bool opened = source.open(job.sourceFile);
+
+        if (cache_ != nullptr && opened)
+        {
+            key = CompileCache::makeKey(source.data(), source.size(), getOutputOptions(job.sourceFile));
+
+            if (cache_->fetch(key, job.outputFile))
+            {
+                return true;
+            }
+        }
+
+        bool succeeded = compileSource(job, opened ? &source : nullptr, pool);
+
+        // the output of a file with errors is not kept, so its errors are
+        // reported again next time.
+        if (succeeded && !key.empty())
+        {
+            cache_->store(key, job.outputFile);
+        }
+
+        return succeeded;
+    }
+
+    std::string Driver::getOutputOptions(const std::string& sourceFile) const
+    {
+#if defined(LEXER)
+        std::string outputOptions = "Lexer " + sourceFile;
+
+#elif defined(PARSER)
+        // the syntax tree has no file name in it.
+        static_cast<void>(sourceFile);
+        std::string outputOptions = "Parser";
+
+#else
+    #error Please pass the macro definition "LEXER" or "PARSER" when compile.
+#endif
+
+        outputOptions += options_.engine == Scanner::Engine::TABLE_DRIVEN ? " --dfa" : "";
+        outputOptions += options_.compact ? " --compact" : "";
+        outputOptions += options_.binary ? " --binary" : "";
+
+        return outputOptions;
+    }
+
+    bool Driver::compileSource(const CompileJob& job, SourceBuffer* source, ThreadPool* pool) const
+    {
+        DiagnosticEngine diagnostics(job.sourceFile, options_.diagnostics);
+        DiagnosticScope scope(diagnostics);
+        std::ofstream of(job.outputFile, options_.binary ? std::ios::out | std::ios::binary : std::ios::out);
+        bool succeeded = false;
+
+        if (of.fail())
+        {
+            errorFile("Output file " + job.outputFile + " can not be created!");
+        }
+        else
+        {
+            std::unique_ptr<Scanner> scanner(source != nullptr ? new Scanner(job.sourceFile, std::move(*source), options_.engine)
+                                                               : new Scanner(job.sourceFile, options_.engine));
+            succeeded = compileSource(*scanner, of, pool);
+        }
+
+        diagnostics.flush();
+
+        return succeeded;
+    }
+
+    bool Driver::compileSource(Scanner& scanner, std::ostream& out, ThreadPool* pool) const
+    {
+        CompileStatistics* statistics = statistics_.get();
+        const std::string& fileName = scanner.getFileName();
+
+#if defined(LEXER)
+        // the tokens of one file are always scanned in order.
+        static_cast<void>(pool);
+
+        if (options_.batch)
+        {
+            PhaseTimer scanTimer(statistics, CompileStatistics::Phase::SCAN, fileName);
+            TokenBuffer tokens = scanner.tokenizeAll();
+            scanTimer.stop();
+            scanTimer.setSizes(tokens.size());
+
+            PhaseTimer writeTimer(statistics, CompileStatistics::Phase::WRITE, fileName);
+
+            for (std::size_t i = 0; i < tokens.size(); i++)
+            {
+                out << tokens.at(i).toString() << '\n';
+            }
+        }
+        else
+        {
+            PhaseTimer timer(statistics, CompileStatistics::Phase::SCAN_AND_WRITE, fileName);
+
+            while (scanner.getToken().getTokenType() != TokenType::END_OF_FILE)
+            {
+                out << scanner.getNextToken().toString() << '\n';
+            }
+
+            timer.setSizes(scanner.getTokenCount());
+        }
+
+        return scanner.getErrorCount() == 0;
+
+#elif defined(PARSER)
+        bool syntaxError = false;
+
+        if (pool != nullptr || options_.batch)
+        {
+            PhaseTimer scanTimer(statistics, CompileStatistics::Phase::SCAN, fileName);
+            TokenBuffer tokens = scanner.tokenizeAll();
+            scanTimer.stop();
+            scanTimer.setSizes(tokens.size());
+
+            // the allocations of the classes parsed on the pool are not counted.
+            PhaseTimer parseTimer(statistics, CompileStatistics::Phase::PARSE, fileName);
+            Parser parser(tokens);
+            ProgramASTPtr program = pool != nullptr ? parser.parseParallel(*pool) : parser.parse();
+            parseTimer.stop();
+            parseTimer.setSizes(tokens.size(), statistics != nullptr ? countNodes(program) : 0);
+
+            PhaseTimer writeTimer(statistics, CompileStatistics::Phase::WRITE, fileName);
+            writeTree(parser, out);
+            syntaxError = parser.getErrorFlag();
+        }
+        else
+        {
+            PhaseTimer parseTimer(statistics, CompileStatistics::Phase::SCAN_AND_PARSE, fileName);
+            Parser parser(scanner);
+            ProgramASTPtr program = parser.parse();
+            parseTimer.stop();
+            parseTimer.setSizes(scanner.getTokenCount(), statistics != nullptr ? countNodes(program) : 0);
+
+            PhaseTimer writeTimer(statistics, CompileStatistics::Phase::WRITE, fileName);
+            writeTree(parser, out);
+            syntaxError = parser.getErrorFlag();
+        }
+
+        return scanner.getErrorCount() == 0 && !syntaxError;
+
+#else
+    #error Please pass the macro definition "LEXER" or "PARSER" when compile.
+#endif
+    }
+} // namespace MJava
@@ -5,28 +5,38 @@
 // Copyright (c) 2020 Li Taiji All rights reserved
 
 #include "error.h"
-
-#ifndef LEXER
-    #include "parser.h"
-#endif
-
-#include "scanner.h"
-#include <iostream>
+#include "diagnostic.h"
+#include "sourcemanager.h"
+#include "token.h"
 
 namespace MJava
 {
-    void errorToken(const std::string& msg)
+    namespace
+    {
+        Diagnostic makeDiagnostic(DiagnosticKind kind, const TokenLocation& loc, const std::string& msg)
+        {
+            Diagnostic diagnostic{Severity::ERROR, kind, std::string(), 0, 0, msg};
+            SourceManager& sourceManager = SourceManager::instance();
+
+            sourceManager.getLineAndColumn(loc.getFileID(), loc.getOffset(), diagnostic.line, diagnostic.column);
+            diagnostic.file = sourceManager.getFileName(loc.getFileID());
+            return diagnostic;
+        }
+    } // namespace
+
+    void errorToken(const TokenLocation& loc, const std::string& msg)
+    {
+        reportDiagnostic(makeDiagnostic(DiagnosticKind::TOKEN, loc, msg));
+    }
+
+    void errorSyntax(const TokenLocation& loc, const std::string& msg)
     {
-        std::cerr << "Token Error:" << msg << std::endl;
-        Scanner::setErrorFlag(true);
+        reportDiagnostic(makeDiagnostic(DiagnosticKind::SYNTAX, loc, msg));
     }
 
-#ifndef LEXER
-    void errorSyntax(const std::string& msg)
+    void errorFile(const std::string& msg)
     {
-        std::cerr << "Syntax Error: " << msg << std::endl;
-        Parser::setErrorFlag(true);
+        reportDiagnostic(Diagnostic{Severity::ERROR, DiagnosticKind::FILE, std::string(), 0, 0, msg});
     }
-#endif
 
-} // namespace MJava
\ No newline at end of file
+} // namespace MJava
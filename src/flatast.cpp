@@ -0,0 +1,351 @@
+// THIS FILE IS PART OF MJava-Compiler PROJECT
+// flatast.cpp - abstract syntax tree in one flat array
+
+// Created by Li Taiji 2026-10-17
+// Copyright (c) 2026 Li Taiji All rights reserved
+
+#include "flatast.h"
+#include "astvisitor.h"
+#include <cstring>
+
+namespace MJava
+{
+    double FlatNode::getReal() const
+    {
+        double real = 0.0;
+        std::memcpy(&real, slots, sizeof(real));
+        return real;
+    }
+
+    // Builder appends every node it visits to the flat tree and returns the
+    // index of the node.
+    class FlatAST::Builder : public ASTStaticVisitor<FlatAST::Builder, FlatIndex>
+    {
+    public:
+        explicit                Builder(FlatAST& tree) : tree_(tree) {}
+
+        FlatIndex               visitNull() { return FLAT_NULL; }
+        FlatIndex               visitBase(const ExprAST* ast) { return addNode(ast); }
+
+        FlatIndex               visitProgram(const ProgramAST* ast)
+        {
+            FlatIndex index = addNode(ast);
+            std::uint32_t classes = addList(ast->getClasses());
+            tree_.nodes_[index].slots[0] = classes;
+            return index;
+        }
+
+        FlatIndex               visitBlock(const BlockAST* ast)
+        {
+            FlatIndex index = addNode(ast);
+            std::uint32_t block = addList(ast->getBlock());
+            tree_.nodes_[index].slots[0] = block;
+            return index;
+        }
+
+        FlatIndex               visitClassDeclaration(const ClassDeclarationAST* ast)
+        {
+            FlatIndex index = addNode(ast, ast->getClassName(), ast->getBaseClassName());
+            std::uint32_t memberVariables = addList(ast->getMemberVariables());
+            std::uint32_t memberMethods = addList(ast->getMemberMemthods());
+            setSlots(index, memberVariables, memberMethods);
+            return index;
+        }
+
+        FlatIndex               visitMainClass(const MainClassAST* ast)
+        {
+            FlatIndex index = addNode(ast, ast->getClassName());
+            FlatIndex mainMethod = visit(ast->getMainMethod());
+            setSlots(index, mainMethod);
+            return index;
+        }
+
+        FlatIndex               visitMethodBody(const MethodBodyAST* ast)
+        {
+            FlatIndex index = addNode(ast);
+            std::uint32_t localVariables = addList(ast->getLocalVariables());
+            std::uint32_t methodBody = addList(ast->getMethodBody());
+            FlatIndex returnStatement = visit(ast->getReturnStatement());
+            setSlots(index, localVariables, methodBody, returnStatement);
+            return index;
+        }
+
+        FlatIndex               visitMethodDeclaration(const MethodDeclarationAST* ast)
+        {
+            FlatIndex index = addNode(ast, ast->getReturnType(), ast->getMethodName());
+            std::uint32_t attributes = addNameList(ast->getAttributes());
+            std::uint32_t parameters = addList(ast->getParameters());
+            FlatIndex body = visit(ast->getBody());
+            setSlots(index, attributes, parameters, body);
+            return index;
+        }
+
+        FlatIndex               visitMethodCall(const MethodCallAST* ast)
+        {
+            FlatIndex index = addNode(ast, ast->getName());
+            std::uint32_t parameters = addList(ast->getParameters());
+            setSlots(index, parameters);
+            return index;
+        }
+
+        FlatIndex               visitVariableDeclaration(const VariableDeclarationAST* ast)
+        {
+            return addNode(ast, ast->getType(), ast->getName());
+        }
+
+        FlatIndex               visitVariable(const VariableAST* ast)
+        {
+            return addNode(ast, ast->getName());
+        }
+
+        FlatIndex               visitArray(const ArrayAST* ast)
+        {
+            FlatIndex index = addNode(ast, ast->getName());
+            FlatIndex arrayIndex = visit(ast->getIndex());
+            setSlots(index, arrayIndex);
+            return index;
+        }
+
+        FlatIndex               visitIfStatement(const IfStatementAST* ast)
+        {
+            FlatIndex index = addNode(ast);
+            FlatIndex condition = visit(ast->getCondition());
+            FlatIndex thenPart = visit(ast->getThenPart());
+            FlatIndex elsePart = visit(ast->getElsePart());
+            setSlots(index, condition, thenPart, elsePart);
+            return index;
+        }
+
+        FlatIndex               visitWhileStatement(const WhileStatementAST* ast)
+        {
+            FlatIndex index = addNode(ast);
+            FlatIndex condition = visit(ast->getCondition());
+            FlatIndex body = visit(ast->getBody());
+            setSlots(index, condition, body);
+            return index;
+        }
+
+        FlatIndex               visitForStatement(const ForStatementAST* ast)
+        {
+            FlatIndex index = addNode(ast);
+            FlatIndex variable = visit(ast->getVariable());
+            FlatIndex condition = visit(ast->getCondition());
+            FlatIndex action = visit(ast->getAction());
+            FlatIndex body = visit(ast->getBody());
+            setSlots(index, variable, condition, action, body);
+            return index;
+        }
+
+        FlatIndex               visitReturnStatement(const ReturnStatementAST* ast)
+        {
+            FlatIndex index = addNode(ast);
+            FlatIndex expression = visit(ast->getReturnStatement());
+            setSlots(index, expression);
+            return index;
+        }
+
+        FlatIndex               visitPrintStatement(const PrintStatementAST* ast)
+        {
+            FlatIndex index = addNode(ast);
+            FlatIndex expression = visit(ast->getPrintStatement());
+            setSlots(index, expression);
+            return index;
+        }
+
+        FlatIndex               visitNewStatement(const NewStatementAST* ast)
+        {
+            FlatIndex index = addNode(ast, ast->getType());
+            FlatIndex expression = visit(ast->getNewStatement());
+            setSlots(index, expression);
+            return index;
+        }
+
+        // a chain of operators is as deep as it is long, so the operands
+        // which are operators too are added from operators_ instead of by
+        // recursion, in the same preorder.
+        FlatIndex               visitBinaryOpExpression(const BinaryOpExpressionAST* ast)
+        {
+            FlatIndex root = addOperatorNode(ast, ast->getBinaryOp());
+            std::size_t base = operators_.size();
+            operators_.push_back(Operator{ast, root, 0});
+
+            while (operators_.size() > base)
+            {
+                Operator& top = operators_.back();
+
+                if (top.operand == 2)
+                {
+                    operators_.pop_back();
+                    continue;
+                }
+
+                FlatIndex index = top.index;
+                std::size_t slot = top.operand++;
+                const ExprAST* operand = slot == 0 ? top.ast->getLhs() : top.ast->getRhs();
+
+                if (operand != nullptr && operand->getID() == ASTType::BINARYOPEXPRESSION)
+                {
+                    const BinaryOpExpressionAST* op = static_cast<const BinaryOpExpressionAST*>(operand);
+                    FlatIndex child = addOperatorNode(op, op->getBinaryOp());
+                    tree_.nodes_[index].slots[slot] = child;
+                    operators_.push_back(Operator{op, child, 0});
+                }
+                else
+                {
+                    FlatIndex child = visit(operand);
+                    tree_.nodes_[index].slots[slot] = child;
+                }
+            }
+
+            return root;
+        }
+
+        FlatIndex               visitUnaryOpExpression(const UnaryOpExpressionAST* ast)
+        {
+            FlatIndex index = addOperatorNode(ast, ast->getUnaryOp());
+            FlatIndex expression = visit(ast->getExpression());
+            setSlots(index, expression);
+            return index;
+        }
+
+        FlatIndex               visitReal(const RealAST* ast)
+        {
+            FlatIndex index = addNode(ast);
+            double real = ast->getReal();
+            std::memcpy(tree_.nodes_[index].slots, &real, sizeof(real));
+            return index;
+        }
+
+        FlatIndex               visitInteger(const IntegerAST* ast)
+        {
+            FlatIndex index = addNode(ast);
+            setSlots(index, static_cast<std::uint32_t>(ast->getInteger()));
+            return index;
+        }
+
+        FlatIndex               visitChar(const CharAST* ast)
+        {
+            FlatIndex index = addNode(ast);
+            setSlots(index, static_cast<unsigned char>(ast->getChar()));
+            return index;
+        }
+
+        FlatIndex               visitString(const StringAST* ast)
+        {
+            return addNode(ast, ast->getString());
+        }
+
+        FlatIndex               visitBoolean(const BooleanAST* ast)
+        {
+            FlatIndex index = addNode(ast);
+            setSlots(index, ast->getBoolean() ? 1 : 0);
+            return index;
+        }
+
+    private:
+        FlatIndex               addNode(const ExprAST* ast, std::string_view name0 = std::string_view(),
+                                        std::string_view name1 = std::string_view())
+        {
+            FlatNode node;
+            node.type = static_cast<std::uint8_t>(ast->getID());
+            node.op = static_cast<std::uint8_t>(TokenValue::UNRESERVED);
+            node.reserved = 0;
+            node.offset = ast->getTokenLocation().getOffset();
+            node.names[0] = tree_.names_.intern(name0);
+            node.names[1] = tree_.names_.intern(name1);
+            node.slots[0] = node.slots[1] = node.slots[2] = node.slots[3] = FLAT_NULL;
+
+            tree_.nodes_.push_back(node);
+
+            return static_cast<FlatIndex>(tree_.nodes_.size() - 1);
+        }
+
+        FlatIndex               addOperatorNode(const ExprAST* ast, TokenValue op)
+        {
+            FlatIndex index = addNode(ast);
+            tree_.nodes_[index].op = static_cast<std::uint8_t>(op);
+            return index;
+        }
+
+        // the children first, the list itself goes after the lists of the children.
+        std::uint32_t           addList(ExprASTArray asts)
+        {
+            if (asts.empty())
+            {
+                return 0;
+            }
+
+            std::vector<FlatIndex> indexes;
+            indexes.reserve(asts.size());
+
+            for (const ExprAST* ast : asts)
+            {
+                indexes.push_back(visit(ast));
+            }
+
+            return appendList(indexes);
+        }
+
+        std::uint32_t           addNameList(ArrayRef<std::string_view> names)
+        {
+            if (names.empty())
+            {
+                return 0;
+            }
+
+            std::vector<std::uint32_t> symbols;
+            symbols.reserve(names.size());
+
+            for (std::string_view name : names)
+            {
+                symbols.push_back(tree_.names_.intern(name));
+            }
+
+            return appendList(symbols);
+        }
+
+        std::uint32_t           appendList(const std::vector<std::uint32_t>& values)
+        {
+            std::vector<std::uint32_t>& lists = tree_.lists_;
+            std::uint32_t slot = static_cast<std::uint32_t>(lists.size());
+
+            lists.push_back(static_cast<std::uint32_t>(values.size()));
+            lists.insert(lists.end(), values.begin(), values.end());
+
+            return slot;
+        }
+
+        void                    setSlots(FlatIndex index, std::uint32_t slot0, std::uint32_t slot1 = FLAT_NULL,
+                                         std::uint32_t slot2 = FLAT_NULL, std::uint32_t slot3 = FLAT_NULL)
+        {
+            std::uint32_t* slots = tree_.nodes_[index].slots;
+            slots[0] = slot0;
+            slots[1] = slot1;
+            slots[2] = slot2;
+            slots[3] = slot3;
+        }
+
+    private:
+        // an operator whose operands are being added, and the next one of them.
+        struct Operator
+        {
+            const BinaryOpExpressionAST*    ast;
+            FlatIndex                       index;
+            std::size_t                     operand;
+        };
+
+        FlatAST&                tree_;
+        // the operators of all the expressions being added, innermost last.
+        std::vector<Operator>   operators_;
+    };
+
+    FlatAST::FlatAST(const ExprAST* root)
+        : fileId_(root != nullptr ? root->getTokenLocation().getFileID() : 0)
+    {
+        // the empty list.
+        lists_.push_back(0);
+
+        Builder builder(*this);
+        builder.visit(root);
+    }
+} // namespace MJava
@@ -0,0 +1,587 @@
+// THIS FILE IS PART OF MJava-Compiler PROJECT
+// incrementalparser.cpp - scan and parse again only what an edit touches
+
+// Created by Li Taiji 2026-10-17
+// Copyright (c) 2026 Li Taiji All rights reserved
+
+#include "astserializer.h"
+#include "astvisitor.h"
+#include "diagnostic.h"
+#include "incrementalparser.h"
+#include "jsonwriter.h"
+#include "parser.h"
+#include <algorithm>
+
+namespace MJava
+{
+    namespace
+    {
+        // most classes are small, and every class has arenas of its own.
+        const std::size_t SEGMENT_CHUNK_SIZE = 4 * 1024;
+
+        // the depth after the tokens [begin, end), and the lowest depth on the way.
+        int braceDepth(const TokenBuffer& tokens, std::size_t begin, std::size_t end, int& lowest)
+        {
+            int depth = 0;
+            lowest = 0;
+
+            for (std::size_t i = begin; i < end; i++)
+            {
+                if (tokens.getTokenValue(i) == TokenValue::LBRACE)
+                {
+                    ++depth;
+                }
+                else if (tokens.getTokenValue(i) == TokenValue::RBRACE)
+                {
+                    lowest = std::min(lowest, --depth);
+                }
+            }
+
+            return depth;
+        }
+
+        bool isClassStart(const TokenBuffer& tokens, std::size_t index)
+        {
+            return tokens.getTokenValue(index) == TokenValue::CLASS && tokens.getTokenType(index) == TokenType::KEYWORD;
+        }
+    }
+
+    IncrementalParser::IncrementalParser(const std::string& fileName, std::string_view source, Scanner::Engine engine)
+        : source_(source), scanner_(fileName, source_, engine), program_(nullptr), statistics_{0, 0, 0}
+    {
+        tokens_ = scanner_.tokenizeAll();
+        statistics_.tokensScanned = tokens_.size();
+
+        // one segment over the whole file, cut into classes by parseSegments().
+        segments_.push_back(Segment{0, tokens_.size() - 1, {}, {}, 0, false, source_.data(), source_.capacity(), 0});
+        parseSegments(0, 0);
+    }
+
+    void IncrementalParser::edit(std::size_t offset, std::size_t length, std::string_view text)
+    {
+        offset = std::min(offset, source_.size());
+        length = std::min(length, source_.size() - offset);
+
+        const char* oldText = source_.data();
+        std::size_t oldCapacity = source_.capacity();
+        std::ptrdiff_t delta = static_cast<std::ptrdiff_t>(text.size()) - static_cast<std::ptrdiff_t>(length);
+
+        statistics_ = Statistics{0, 0, 0};
+        program_ = nullptr;
+        source_.replace(offset, length, text.data(), text.size());
+
+        TokenEdit edit = rescan(offset, length, text.size());
+        // the segments with changed tokens, or the one the edit is in if no token has changed.
+        std::size_t first = findSegment(edit.first);
+        std::size_t last = edit.removed != 0 ? findSegment(edit.first + edit.removed - 1) : first;
+
+        moveSegments(first, last, edit, delta, oldText, oldCapacity);
+
+        if (edit.removed == 0 && edit.inserted == 0)
+        {
+            for (ExprASTPtr classAST : segments_[first].classes)
+            {
+                moveTree(classAST, offset, delta);
+            }
+        }
+        else if (first != last || !parseMethod(segments_[first], edit, offset, delta))
+        {
+            parseSegments(first, last);
+        }
+    }
+
+    ProgramASTPtr IncrementalParser::getProgram()
+    {
+        if (program_ == nullptr)
+        {
+            for (Segment& segment : segments_)
+            {
+                update(segment);
+            }
+
+            buildProgram();
+        }
+
+        return program_;
+    }
+
+    const TokenBuffer& IncrementalParser::getTokens()
+    {
+        for (Segment& segment : segments_)
+        {
+            update(segment);
+        }
+
+        return tokens_;
+    }
+
+    bool IncrementalParser::getErrorFlag() const
+    {
+        return std::any_of(segments_.begin(), segments_.end(),
+                           [](const Segment& segment) { return segment.errorFlag; });
+    }
+
+    void IncrementalParser::writeJSON(std::ostream& out, bool pretty)
+    {
+        ProgramASTPtr program = getProgram();
+        JSONWriter writer(out, pretty);
+        ASTSerializer serializer(writer);
+        serializer.write(program);
+    }
+
+    IncrementalParser::TokenEdit IncrementalParser::rescan(std::size_t offset, std::size_t length, std::size_t inserted)
+    {
+        std::size_t oldCount = tokens_.size();
+        std::ptrdiff_t delta = static_cast<std::ptrdiff_t>(inserted) - static_cast<std::ptrdiff_t>(length);
+        std::size_t editEnd = offset + inserted;
+
+        // a token which ends less than MAX_LOOKAHEAD chars before the edit may
+        // have looked at it, so the scan starts at the last token before those
+        // chars. every token before it ends before them.
+        std::size_t from = offset > Scanner::MAX_LOOKAHEAD ? offset - Scanner::MAX_LOOKAHEAD : 0;
+        std::size_t first = lowerBound(static_cast<std::uint32_t>(from), 0);
+        first = first >= 1 ? first - 1 : 0;
+        // the next old token a new token may start at.
+        std::size_t next = first;
+        TokenBuffer scanned(tokens_.getFileID());
+
+        // the first token may start after the edit, like END_OF_FILE after a
+        // comment, so the scan before it starts from the start of the file.
+        scanner_.rescan(source_, first > 0 ? getOffset(first) : 0);
+
+        while (true)
+        {
+            const Token& token = scanner_.getNextToken();
+
+            if (token.getTokenType() == TokenType::END_OF_FILE)
+            {
+                scanned.push(token);
+                next = oldCount;
+                break;
+            }
+
+            std::size_t tokenOffset = token.getTokenLocation().getOffset();
+
+            // an old token started here too, from now on the tokens are the same.
+            if (tokenOffset >= editEnd)
+            {
+                std::uint32_t oldOffset = static_cast<std::uint32_t>(tokenOffset - delta);
+                next = lowerBound(oldOffset, next);
+
+                if (next < oldCount - 1 && getOffset(next) == oldOffset)
+                {
+                    break;
+                }
+            }
+
+            // a token which ends before the edit is the same as before.
+            if (scanned.empty() && first < oldCount - 1 && tokenOffset + token.getTokenName().size() <= offset &&
+                getOffset(first) == tokenOffset && tokens_.getTokenType(first) == token.getTokenType() &&
+                tokens_.getTokenValue(first) == token.getTokenValue() &&
+                tokens_.getTokenName(first).size() == token.getTokenName().size())
+            {
+                next = std::max(next, ++first);
+                continue;
+            }
+
+            scanned.push(token);
+        }
+
+        statistics_.tokensScanned = scanned.size();
+        tokens_.splice(first, next, scanned);
+
+        return TokenEdit{first, next - first, scanned.size()};
+    }
+
+    void IncrementalParser::moveSegments(std::size_t first, std::size_t last, const TokenEdit& edit, std::ptrdiff_t delta,
+                                         const char* oldText, std::size_t oldCapacity)
+    {
+        std::ptrdiff_t shift = static_cast<std::ptrdiff_t>(edit.inserted) - static_cast<std::ptrdiff_t>(edit.removed);
+        std::size_t next = edit.first + edit.removed;
+
+        // the tokens before the changed ones stay where they are, the ones
+        // after them are moved by delta too. the indexes are the old ones.
+        for (std::size_t i = first; i <= last; i++)
+        {
+            Segment& segment = segments_[i];
+
+            if (segment.begin < edit.first)
+            {
+                tokens_.relocate(segment.begin, std::min(segment.end, edit.first), segment.moved,
+                                 segment.text, segment.capacity, source_.data());
+            }
+
+            if (segment.end > next)
+            {
+                tokens_.relocate(std::max(segment.begin, next) + shift, segment.end + shift, segment.moved + delta,
+                                 segment.text, segment.capacity, source_.data());
+            }
+
+            for (ExprASTPtr classAST : segment.classes)
+            {
+                moveTree(classAST, 0, segment.moved);
+            }
+
+            segment.text = source_.data();
+            segment.capacity = source_.capacity();
+            segment.moved = 0;
+        }
+
+        segments_[last].end += shift;
+
+        for (std::size_t i = last + 1; i < segments_.size(); i++)
+        {
+            segments_[i].begin += shift;
+            segments_[i].end += shift;
+            segments_[i].moved += delta;
+        }
+
+        // END_OF_FILE is always up to date, it is not in a segment.
+        if (edit.first + edit.inserted < tokens_.size())
+        {
+            tokens_.relocate(tokens_.size() - 1, tokens_.size(), delta, oldText, oldCapacity, source_.data());
+        }
+    }
+
+    void IncrementalParser::parseSegments(std::size_t first, std::size_t last)
+    {
+        std::size_t begin = segments_[first].begin;
+        std::size_t end = segments_[last].end;
+        int lowest = 0;
+
+        while (true)
+        {
+            // "class" has been changed, the tokens belong to the class before.
+            if (first > 0 && !isClassStart(tokens_, begin))
+            {
+                begin = segments_[--first].begin;
+            }
+            // all before the next class has gone, so it holds the main class now.
+            else if (first == 0 && end == begin && last + 1 < segments_.size())
+            {
+                end = segments_[++last].end;
+            }
+            // the braces do not match any more, so the classes after are cut differently.
+            else if (last + 1 < segments_.size() && braceDepth(tokens_, begin, end, lowest) != 0)
+            {
+                end = segments_[++last].end;
+            }
+            else
+            {
+                break;
+            }
+        }
+
+        // the token at end is seen by the parser too.
+        for (std::size_t i = first; i <= last + 1 && i < segments_.size(); i++)
+        {
+            update(segments_[i]);
+        }
+
+        std::vector<std::size_t> classStarts = Parser::findClassStarts(tokens_, begin, end);
+        std::vector<std::size_t> cuts(1, begin);
+
+        // a class at begin already starts the first new segment, the first
+        // segment of the file starts at the first token and holds the main class.
+        for (std::size_t i = 0; i < classStarts.size(); i++)
+        {
+            if (classStarts[i] > begin)
+            {
+                cuts.push_back(classStarts[i]);
+            }
+        }
+
+        cuts.push_back(end);
+
+        std::vector<Segment> parsed;
+
+        // a class which has been deleted whole leaves no segment behind.
+        if (begin == end && first > 0)
+        {
+            cuts.pop_back();
+        }
+
+        for (std::size_t i = 0; i + 1 < cuts.size();)
+        {
+            Segment segment{cuts[i], cuts[i + 1], {}, {}, 0, false, source_.data(), source_.capacity(), 0};
+
+            if (parseSegment(segment, first == 0 && i == 0))
+            {
+                parsed.push_back(std::move(segment));
+                ++i;
+            }
+            // a broken class has gone on into the next class, which is parsed as a part of it.
+            else if (i + 2 < cuts.size())
+            {
+                cuts.erase(cuts.begin() + i + 1);
+            }
+            else
+            {
+                cuts.back() = segments_[++last].end;
+
+                if (last + 1 < segments_.size())
+                {
+                    update(segments_[last + 1]);
+                }
+            }
+        }
+
+        statistics_.classesParsed += parsed.size();
+
+        segments_.erase(segments_.begin() + first, segments_.begin() + last + 1);
+        segments_.insert(segments_.begin() + first,
+                         std::make_move_iterator(parsed.begin()), std::make_move_iterator(parsed.end()));
+    }
+
+    bool IncrementalParser::parseSegment(Segment& segment, bool mainClass)
+    {
+        Parser parser(tokens_, segment.begin, segment.end);
+        parser.arena_ = Arena(SEGMENT_CHUNK_SIZE);
+        // the errors are kept back until it is known that the segment is not overrun.
+        DiagnosticEngine::Options keepAll;
+        keepAll.deduplicate = false;
+        DiagnosticEngine diagnostics(std::string(), keepAll);
+
+        {
+            DiagnosticScope scope(diagnostics);
+
+            if (!mainClass)
+            {
+                parser.parseClassDeclarations(segment.classes);
+            }
+            else if (parser.currentToken().getTokenType() == TokenType::END_OF_FILE)
+            {
+                parser.errorReport("The file is empty.");
+            }
+            else
+            {
+                ExprASTPtr mainClassAST = parser.parseMainClass();
+
+                if (mainClassAST != nullptr)
+                {
+                    segment.classes.push_back(mainClassAST);
+                }
+                else
+                {
+                    parser.errorReport("Missing main class definition.");
+                }
+
+                // anything between the main class and the next class. without
+                // another class the rest is parsed as Parser::parse() does it.
+                if (!parser.isAtRangeEnd() || segment.end + 1 == tokens_.size())
+                {
+                    parser.parseClassDeclarations(segment.classes);
+                }
+            }
+        }
+
+        if (parser.overrun_)
+        {
+            return false;
+        }
+
+        for (const auto& diagnostic : diagnostics.getDiagnostics())
+        {
+            reportDiagnostic(diagnostic);
+        }
+
+        segment.errorFlag = parser.errorFlag_;
+        segment.parsedBytes = parser.arena_.getBytesUsed();
+        segment.arenas.push_back(std::move(parser.arena_));
+
+        return true;
+    }
+
+    bool IncrementalParser::parseMethod(Segment& segment, const TokenEdit& edit, std::size_t offset, std::ptrdiff_t delta)
+    {
+        if (segment.classes.size() != 1 || segment.classes[0]->getID() != ASTType::CLASSDECLARATION || segment.errorFlag)
+        {
+            return false;
+        }
+
+        std::size_t bytesUsed = 0;
+
+        for (const Arena& arena : segment.arenas)
+        {
+            bytesUsed += arena.getBytesUsed();
+        }
+
+        // the old methods are garbage in the arenas, parse the class again to drop them.
+        if (bytesUsed > 2 * segment.parsedBytes)
+        {
+            return false;
+        }
+
+        const ClassDeclarationAST* classAST = static_cast<const ClassDeclarationAST*>(segment.classes[0]);
+        ExprASTArray methods = classAST->getMemberMemthods();
+        std::size_t unchanged = edit.first + edit.inserted;
+        std::size_t segmentEnd = segment.end;
+
+        // the last method which starts before the changed tokens.
+        std::size_t method = methods.size();
+        std::size_t begin = 0;
+
+        while (method > 0)
+        {
+            std::uint32_t methodOffset = methods[method - 1]->getTokenLocation().getOffset();
+            begin = tokens_.lowerBound(methodOffset, segment.begin, edit.first);
+
+            if (begin < edit.first && tokens_.getOffset(begin) == methodOffset)
+            {
+                break;
+            }
+
+            --method;
+        }
+
+        if (method == 0)
+        {
+            return false;
+        }
+
+        --method;
+
+        // the method stops at the next method or at the "}" of the class,
+        // which must not have been changed.
+        std::size_t end = segmentEnd - 1;
+
+        if (method + 1 < methods.size())
+        {
+            std::uint32_t nextOffset = static_cast<std::uint32_t>(methods[method + 1]->getTokenLocation().getOffset() + delta);
+            end = tokens_.lowerBound(nextOffset, unchanged, segmentEnd);
+
+            if (end == segmentEnd || tokens_.getOffset(end) != nextOffset)
+            {
+                return false;
+            }
+        }
+        else if (end < unchanged || tokens_.getTokenValue(end) != TokenValue::RBRACE)
+        {
+            return false;
+        }
+
+        int lowest = 0;
+
+        if (braceDepth(tokens_, begin, end, lowest) != 0 || lowest < 0)
+        {
+            return false;
+        }
+
+        // errors are reported when the whole class is parsed again.
+        Parser parser(tokens_, begin, end);
+        parser.arena_ = Arena(SEGMENT_CHUNK_SIZE);
+        parser.quiet_ = true;
+        ExprASTPtr methodAST = parser.parseExpression();
+
+        if (methodAST == nullptr || methodAST->getID() != ASTType::METHODDECLARATION || parser.errorFlag_ ||
+            parser.overrun_ || !parser.isAtRangeEnd())
+        {
+            return false;
+        }
+
+        for (std::size_t i = method + 1; i < methods.size(); i++)
+        {
+            moveTree(methods[i], offset, delta);
+        }
+
+        VecExprASTPtr memberMethods(methods.begin(), methods.end());
+        memberMethods[method] = methodAST;
+
+        segment.classes[0] = parser.arena_.make<ClassDeclarationAST>(
+            classAST->getTokenLocation(), classAST->getClassName(), classAST->getBaseClassName(),
+            classAST->getMemberVariables(), parser.arena_.copyArray(memberMethods));
+        segment.arenas.push_back(std::move(parser.arena_));
+        statistics_.methodsParsed = 1;
+
+        return true;
+    }
+
+    void IncrementalParser::buildProgram()
+    {
+        VecExprASTPtr classes;
+
+        for (const Segment& segment : segments_)
+        {
+            classes.insert(classes.end(), segment.classes.begin(), segment.classes.end());
+        }
+
+        const VecExprASTPtr& mainSegment = segments_[0].classes;
+        TokenLocation loc = !mainSegment.empty() && mainSegment[0]->getID() == ASTType::MAINCLASS
+                          ? mainSegment[0]->getTokenLocation()
+                          : tokens_.at(0).getTokenLocation();
+
+        arena_.release();
+        program_ = arena_.make<ProgramAST>(loc, arena_.copyArray(classes));
+    }
+
+    std::size_t IncrementalParser::findSegment(std::size_t tokenIndex) const
+    {
+        auto iter = std::upper_bound(segments_.begin(), segments_.end(), tokenIndex,
+                                     [](std::size_t index, const Segment& segment) { return index < segment.begin; });
+
+        return static_cast<std::size_t>(iter - segments_.begin()) - 1;
+    }
+
+    void IncrementalParser::update(Segment& segment)
+    {
+        if (segment.moved == 0 && segment.text == source_.data())
+        {
+            return;
+        }
+
+        tokens_.relocate(segment.begin, segment.end, segment.moved, segment.text, segment.capacity, source_.data());
+
+        for (ExprASTPtr classAST : segment.classes)
+        {
+            moveTree(classAST, 0, segment.moved);
+        }
+
+        segment.text = source_.data();
+        segment.capacity = source_.capacity();
+        segment.moved = 0;
+    }
+
+    std::uint32_t IncrementalParser::getOffset(std::size_t index) const
+    {
+        if (index + 1 == tokens_.size())
+        {
+            return tokens_.getOffset(index);
+        }
+
+        return static_cast<std::uint32_t>(tokens_.getOffset(index) + segments_[findSegment(index)].moved);
+    }
+
+    std::size_t IncrementalParser::lowerBound(std::uint32_t offset, std::size_t begin) const
+    {
+        // the first segment from the one of begin on whose last token is not before offset.
+        auto iter = std::partition_point(segments_.begin() + findSegment(begin), segments_.end(),
+                                         [this, offset](const Segment& segment)
+                                         {
+                                             return segment.begin == segment.end ||
+                                                    tokens_.getOffset(segment.end - 1) + segment.moved < offset;
+                                         });
+
+        if (iter == segments_.end())
+        {
+            return std::max(begin, tokens_.size() - 1);
+        }
+
+        std::ptrdiff_t stored = std::max<std::ptrdiff_t>(static_cast<std::ptrdiff_t>(offset) - iter->moved, 0);
+        return tokens_.lowerBound(static_cast<std::uint32_t>(stored), std::max(begin, iter->begin), iter->end);
+    }
+
+    void IncrementalParser::moveTree(const ExprAST* ast, std::size_t from, std::ptrdiff_t delta)
+    {
+        if (delta != 0)
+        {
+            forEachNode(ast, [from, delta](const ExprAST* node)
+                        {
+                            if (node->getTokenLocation().getOffset() >= from)
+                            {
+                                // the nodes are only const to the readers of the tree.
+                                const_cast<ExprAST*>(node)->moveBy(delta);
+                            }
+                        });
+        }
+    }
+} // namespace MJava
@@ -0,0 +1,273 @@
+// THIS FILE IS PART OF MJava-Compiler PROJECT
+// jsonwriter.cpp - streaming json writer
+
+// Created by Li Taiji 2026-10-17
+// Copyright (c) 2026 Li Taiji All rights reserved
+
+#include "jsonwriter.h"
+#include <cstdio>
+
+namespace MJava
+{
+    JSONWriter::JSONWriter(std::ostream& out, bool pretty)
+        : out_(out), pretty_(pretty), afterKey_(false)
+    {
+        buffer_.reserve(BUFFER_SIZE + 1024);
+    }
+
+    JSONWriter::~JSONWriter()
+    {
+        flush();
+    }
+
+    void JSONWriter::flush()
+    {
+        out_.write(buffer_.data(), static_cast<std::streamsize>(buffer_.size()));
+        buffer_.clear();
+    }
+
+    void JSONWriter::beginObject()
+    {
+        separate();
+        buffer_ += '{';
+        counts_.push_back(0);
+    }
+
+    void JSONWriter::endObject()
+    {
+        close('}');
+    }
+
+    void JSONWriter::beginArray()
+    {
+        separate();
+        buffer_ += '[';
+        counts_.push_back(0);
+    }
+
+    void JSONWriter::endArray()
+    {
+        close(']');
+    }
+
+    void JSONWriter::key(std::string_view name)
+    {
+        separate();
+        writeString(name);
+        buffer_ += pretty_ ? ": " : ":";
+        afterKey_ = true;
+    }
+
+    void JSONWriter::value(std::string_view text)
+    {
+        separate();
+        writeString(text);
+    }
+
+    void JSONWriter::value(const char* text)
+    {
+        value(std::string_view(text));
+    }
+
+    void JSONWriter::value(int number)
+    {
+        separate();
+        char digits[16];
+        int length = std::snprintf(digits, sizeof(digits), "%d", number);
+        buffer_.append(digits, static_cast<std::size_t>(length));
+    }
+
+    void JSONWriter::value(std::uint64_t number)
+    {
+        separate();
+        char digits[24];
+        int length = std::snprintf(digits, sizeof(digits), "%llu", static_cast<unsigned long long>(number));
+        buffer_.append(digits, static_cast<std::size_t>(length));
+    }
+
+    void JSONWriter::value(double number)
+    {
+        separate();
+        // the same digits as std::to_string.
+        char digits[512];
+        int length = std::snprintf(digits, sizeof(digits), "%f", number);
+        buffer_.append(digits, static_cast<std::size_t>(length));
+    }
+
+    void JSONWriter::value(bool boolean)
+    {
+        separate();
+        buffer_ += boolean ? "true" : "false";
+    }
+
+    void JSONWriter::separate()
+    {
+        if (afterKey_)
+        {
+            afterKey_ = false;
+            return;
+        }
+
+        if (counts_.empty())
+        {
+            return;
+        }
+
+        if (counts_.back()++ > 0)
+        {
+            buffer_ += ',';
+        }
+
+        if (pretty_)
+        {
+            buffer_ += '\n';
+            writeIndent(counts_.size());
+        }
+
+        if (buffer_.size() >= BUFFER_SIZE)
+        {
+            flush();
+        }
+    }
+
+    void JSONWriter::close(char bracket)
+    {
+        std::size_t count = counts_.back();
+        counts_.pop_back();
+
+        if (pretty_ && count > 0)
+        {
+            buffer_ += '\n';
+            writeIndent(counts_.size());
+        }
+
+        buffer_ += bracket;
+    }
+
+    void JSONWriter::writeString(std::string_view text)
+    {
+        static const char HEX_DIGITS[] = "0123456789abcdef";
+
+        buffer_ += '\"';
+
+        for (std::size_t i = 0; i < text.size(); i++)
+        {
+            char c = text[i];
+
+            // a source is not always utf-8, and the end of the file is the
+            // byte 0xFF. json must be utf-8, so a byte which does not start
+            // a whole utf-8 character is replaced.
+            if (static_cast<unsigned char>(c) >= 0x80)
+            {
+                std::size_t length = getUTF8Length(text.substr(i));
+
+                if (length == 0)
+                {
+                    buffer_ += "\\ufffd";
+                }
+                else
+                {
+                    buffer_.append(text.data() + i, length);
+                    i += length - 1;
+                }
+
+                continue;
+            }
+
+            switch (c)
+            {
+                case '\"':
+                    buffer_ += "\\\"";
+                    break;
+
+                case '\\':
+                    buffer_ += "\\\\";
+                    break;
+
+                case '\n':
+                    buffer_ += "\\n";
+                    break;
+
+                case '\r':
+                    buffer_ += "\\r";
+                    break;
+
+                case '\t':
+                    buffer_ += "\\t";
+                    break;
+
+                default:
+                    if (static_cast<unsigned char>(c) < 0x20)
+                    {
+                        buffer_ += "\\u00";
+                        buffer_ += HEX_DIGITS[(c >> 4) & 0xF];
+                        buffer_ += HEX_DIGITS[c & 0xF];
+                    }
+                    else
+                    {
+                        buffer_ += c;
+                    }
+                    break;
+            }
+        }
+
+        buffer_ += '\"';
+    }
+
+    std::size_t JSONWriter::getUTF8Length(std::string_view text)
+    {
+        auto byte = [text](std::size_t i)
+        {
+            return i < text.size() ? static_cast<unsigned char>(text[i]) : 0;
+        };
+
+        unsigned char lead = byte(0);
+        std::size_t length = 0;
+        // the second byte is narrower than 0x80-0xBF for some leads, so that
+        // no character is encoded in more bytes than it needs, and no
+        // surrogate or character past U+10FFFF is encoded at all.
+        unsigned char low = 0x80;
+        unsigned char high = 0xBF;
+
+        if (lead >= 0xC2 && lead <= 0xDF)
+        {
+            length = 2;
+        }
+        else if (lead >= 0xE0 && lead <= 0xEF)
+        {
+            length = 3;
+            low = lead == 0xE0 ? 0xA0 : 0x80;
+            high = lead == 0xED ? 0x9F : 0xBF;
+        }
+        else if (lead >= 0xF0 && lead <= 0xF4)
+        {
+            length = 4;
+            low = lead == 0xF0 ? 0x90 : 0x80;
+            high = lead == 0xF4 ? 0x8F : 0xBF;
+        }
+        else
+        {
+            return 0;
+        }
+
+        if (byte(1) < low || byte(1) > high)
+        {
+            return 0;
+        }
+
+        for (std::size_t i = 2; i < length; i++)
+        {
+            if (byte(i) < 0x80 || byte(i) > 0xBF)
+            {
+                return 0;
+            }
+        }
+
+        return length;
+    }
+
+    void JSONWriter::writeIndent(std::size_t depth)
+    {
+        buffer_.append(depth * 4, ' ');
+    }
+} // namespace MJava
@@ -10,14 +10,61 @@
     #endif
 #endif
 
-#if defined(PARSER)
-    #include "parser.h"
-#endif
-
+#include "compileserver.h"
+#include "driver.h"
 #include "scanner.h"
-#include <fstream>
+#include <cstdlib>
 #include <iostream>
 #include <string>
+#include <vector>
+
+namespace
+{
+    void printUsage(const std::string& programName)
+    {
+        std::cout << "Usage: " << programName << " [--dfa] [--batch] [--compact] [--binary] [--parallel] [-j <Threads>] [--cache <Directory>] [--cache-size <MB>] [--cache-stats] [--stats] [--perf] [--trace <File>] [--max-errors <Count>] [--all-errors] [--error-format text|json] <Source File> [-o <Output File>] [<Source File> [-o <Output File>]]... [@<Response File>]...\n"
+                  << "       " << programName << " --serve [--socket <Socket>] [-j <Threads>] [--cache-size <MB>]\n"
+                  << "Source file is required. Output File is \"" << (programName == "Lexer" ? "tokenOut.txt" : "SyntaxOut.txt") << "\" by default for a single source file,\n"
+                  << "otherwise it is the source file name with \"" << (programName == "Lexer" ? ".lex" : ".ast") << "\" appended.\n"
+                  << "-o names the output file of the source file before it. \"<Source File> <Output File>\" alone is also read as before.\n"
+                  << "A response file lists one \"<Source File> [Output File]\" per line.\n"
+                  << "--dfa uses the table-driven scanner.\n"
+                  << "--batch scans the whole file before parsing.\n"
+                  << "--compact writes the syntax tree without spaces and newlines.\n"
+                  << "--binary writes the syntax tree in the binary format of binaryast.h.\n"
+                  << "--parallel parses the classes of a file on all the threads, one file after another.\n"
+                  << "-j compiles that many files at the same time, one per hardware thread by default.\n"
+                  << "--cache reuses the outputs of unchanged source files kept in the directory.\n"
+                  << "--cache-size limits the cache, 256 MB by default. the files used longest ago are removed first.\n"
+                  << "--cache-stats prints the hits and misses of the cache.\n"
+                  << "--stats prints the time, the allocations, the tokens and the nodes of every phase.\n"
+                  << "--perf adds the cycles, instructions, branch and cache misses and page faults of every phase, on Linux.\n"
+                  << "--trace writes every phase of every file to the file, in the chrome trace event format.\n"
+                  << "--max-errors reports that many errors of a file, and only counts the others. the whole file is still parsed.\n"
+                  << "--all-errors also reports an error at the same place as the one before it, which is mostly caused by it.\n"
+                  << "--error-format json writes the errors of every file as one line of json instead.\n"
+                  << "--serve answers the requests of ParserClient on a Unix domain socket, \"" << MJava::getDefaultServerSocket() << "\" by default,\n"
+                  << "keeping the outputs of the sources seen last in memory." << std::endl;
+    }
+
+    // the options which take the argument after them as their value.
+    bool takesValue(const std::string& argument)
+    {
+        static const char* const OPTIONS[] = {
+            "--cache", "--cache-size", "--trace", "--max-errors", "--error-format", "--socket", "-j", "-o",
+        };
+
+        for (const char* option : OPTIONS)
+        {
+            if (argument == option)
+            {
+                return true;
+            }
+        }
+
+        return false;
+    }
+} // namespace
 
 int main(int argc, char** argv)
 {
@@ -32,63 +79,227 @@ int main(int argc, char** argv)
     #error Please pass the macro definition "LEXER" or "PARSER" when compile.
 #endif
 
-    if (argc < 2)
+    // the options may be anywhere. the other arguments are source files,
+    // each may be followed by "-o <Output File>", or "@file" for a response
+    // file. an output file is only taken from a bare argument in the old
+    // form "<Source File> <Output File>", so a longer list of sources can not
+    // overwrite one of them.
+    std::vector<MJava::CompileJob> jobs;
+    std::vector<std::string> responseFiles;
+    MJava::Driver::Options options;
+    bool cacheStatistics = false;
+    bool serve = false;
+    std::string socketPath = MJava::getDefaultServerSocket();
+
+    for (int i = 1; i < argc; i++)
     {
-        std::cerr << "Missing source file!" << std::endl;
-        std::cout << "Usage: " << programName << " <Source File> [Output File]\nSource file is required. Output File is \"tokenOut.txt\" by default." << std::endl;
-        return 0;
+        std::string argument = argv[i];
+
+        // the value must not be missing, or the option would be lost without a word.
+        if (takesValue(argument) && i + 1 >= argc)
+        {
+            std::cerr << "Missing value for " << argument << std::endl;
+            printUsage(programName);
+            return 0;
+        }
+
+        if (argument == "--dfa")
+        {
+            options.engine = MJava::Scanner::Engine::TABLE_DRIVEN;
+        }
+        else if (argument == "--batch")
+        {
+            options.batch = true;
+        }
+        else if (argument == "--compact")
+        {
+            options.compact = true;
+        }
+        else if (argument == "--binary")
+        {
+            options.binary = true;
+        }
+        else if (argument == "--cache")
+        {
+            options.cacheDirectory = argv[++i];
+        }
+        else if (argument == "--cache-size")
+        {
+            std::string size = argv[++i];
+            long long megabytes = std::atoll(size.c_str());
+
+            if (megabytes <= 0)
+            {
+                std::cerr << "Bad cache size: " << size << std::endl;
+                printUsage(programName);
+                return 0;
+            }
+
+            options.cacheSize = static_cast<std::uintmax_t>(megabytes) * 1024 * 1024;
+        }
+        else if (argument == "--cache-stats")
+        {
+            cacheStatistics = true;
+        }
+        else if (argument == "--stats")
+        {
+            options.statistics = true;
+        }
+        else if (argument == "--perf")
+        {
+            options.statistics = true;
+            options.perfCounters = true;
+        }
+        else if (argument == "--trace")
+        {
+            options.traceFile = argv[++i];
+        }
+        else if (argument == "--max-errors")
+        {
+            std::string count = argv[++i];
+            long long maxErrors = std::atoll(count.c_str());
+
+            if (maxErrors <= 0)
+            {
+                std::cerr << "Bad error count: " << count << std::endl;
+                printUsage(programName);
+                return 0;
+            }
+
+            options.diagnostics.maxErrors = static_cast<std::size_t>(maxErrors);
+        }
+        else if (argument == "--all-errors")
+        {
+            options.diagnostics.deduplicate = false;
+        }
+        else if (argument == "--error-format")
+        {
+            std::string format = argv[++i];
+
+            if (format != "text" && format != "json")
+            {
+                std::cerr << "Bad error format: " << format << std::endl;
+                printUsage(programName);
+                return 0;
+            }
+
+            options.diagnostics.format = format == "json" ? MJava::DiagnosticEngine::Format::JSON
+                                                          : MJava::DiagnosticEngine::Format::TEXT;
+        }
+        else if (argument == "--serve")
+        {
+            serve = true;
+        }
+        else if (argument == "--socket")
+        {
+            socketPath = argv[++i];
+        }
+        else if (argument == "--parallel")
+        {
+            options.parallelClasses = true;
+        }
+        else if (argument.compare(0, 2, "-j") == 0)
+        {
+            std::string count = argument.size() > 2 ? argument.substr(2) : argv[++i];
+            int threads = std::atoi(count.c_str());
+
+            if (threads <= 0)
+            {
+                std::cerr << "Bad thread count: " << count << std::endl;
+                printUsage(programName);
+                return 0;
+            }
+
+            options.threads = static_cast<std::size_t>(threads);
+        }
+        else if (argument == "-o")
+        {
+            if (jobs.empty() || !jobs.back().outputFile.empty())
+            {
+                std::cerr << "-o must follow a source file: " << argv[i + 1] << std::endl;
+                printUsage(programName);
+                return 0;
+            }
+
+            jobs.back().outputFile = argv[++i];
+        }
+        else if (argument.size() > 1 && argument[0] == '@')
+        {
+            responseFiles.push_back(argument.substr(1));
+        }
+        else
+        {
+            jobs.push_back(MJava::CompileJob{argument, std::string()});
+        }
     }
 
-    if (argc > 3)
+    if (serve)
     {
-        std::cerr << "Too many Arguments!" << std::endl;
-        std::cout << "Usage: " << programName << " <Source File> [Output File]\nSource file is required. Output File is \"tokenOut.txt\" by default." << std::endl;
+        MJava::CompileServer::Options serverOptions;
+        serverOptions.socketPath = socketPath;
+        serverOptions.threads = options.threads;
+        serverOptions.cacheSize = options.cacheSize;
+
+        MJava::CompileServer server(serverOptions);
+        return server.run() ? 0 : 1;
+    }
+
+    if (jobs.empty() && responseFiles.empty())
+    {
+        std::cerr << "Missing source file!" << std::endl;
+        printUsage(programName);
         return 0;
     }
 
-    std::ofstream of;
+    MJava::Driver driver(options);
 
-    if (argc == 3)
+    // the form of the first versions, which lexer.bat and parser.bat callers still use.
+    if (jobs.size() == 2 && responseFiles.empty() && jobs[0].outputFile.empty() && jobs[1].outputFile.empty())
     {
-        of.open(argv[2]);
+        jobs[0].outputFile = jobs[1].sourceFile;
+        jobs.pop_back();
     }
-    else
+
+    if (jobs.size() == 1 && responseFiles.empty() && jobs[0].outputFile.empty())
     {
 #if defined(LEXER)
-        of.open("./tokenOut.txt");
+        jobs[0].outputFile = "./tokenOut.txt";
 
 #elif defined(PARSER)
-        of.open("./SyntaxOut.txt");
+        jobs[0].outputFile = "./SyntaxOut.txt";
 
 #else
     #error Please pass the macro definition "LEXER" or "PARSER" when compile.
 #endif
     }
-    
-    if (of.fail())
+
+    for (const MJava::CompileJob& job : jobs)
     {
-        std::cout << "Output file can not be created!" << std::endl;
-        return 0;
+        driver.addJob(job.sourceFile, !job.outputFile.empty() ? job.outputFile
+                                                              : MJava::Driver::defaultOutputFile(job.sourceFile));
     }
-    
-    MJava::Scanner scanner = MJava::Scanner(argv[1]);
 
-#if defined(LEXER)
-    while(scanner.getToken().getTokenType() != MJava::TokenType::END_OF_FILE)
+    for (const std::string& responseFile : responseFiles)
     {
-        of << scanner.getNextToken().toString() << std::endl;
+        if (!driver.readResponseFile(responseFile))
+        {
+            return 1;
+        }
     }
 
-#elif defined(PARSER)
-    MJava::Parser parser = MJava::Parser(scanner);
-    parser.parse();
-    of << parser.toString();
+    std::size_t failures = driver.run();
 
-#else
-    #error Please pass the macro definition "LEXER" or "PARSER" when compile.
-#endif
+    if (cacheStatistics)
+    {
+        MJava::CompileCache::Statistics statistics = driver.getCacheStatistics();
+        std::cout << "Cache: " << statistics.hits << " hits, " << statistics.misses << " misses, "
+                  << statistics.stores << " stored, " << statistics.evictions << " evicted." << std::endl;
+    }
+
+    if (options.statistics)
+    {
+        driver.getStatistics()->print(std::cout);
+    }
 
-    of.close();
-    
-    return 0;
-}
\ No newline at end of file
+    return failures == 0 ? 0 : 1;
+}
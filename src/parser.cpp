@@ -4,55 +4,141 @@
 // Created by Li Taiji 2020-03-28
 // Copyright (c) 2020 Li Taiji All rights reserved
 
+#include "astserializer.h"
+#include "binaryast.h"
+#include "diagnostic.h"
+#include "dictionary.h"
 #include "error.h"
-#include "jsonformatter.h"
+#include "flatast.h"
+#include "jsonwriter.h"
 #include "parser.h"
-#include <cstdlib>
+#include <algorithm>
+#include <cstdint>
 #include <memory>
 #include <sstream>
 
 namespace MJava
 {
-    bool Parser::errorFlag_ = false;
+    namespace
+    {
+        // how tightly an operator holds its operands, for the pratt parser of
+        // Parser::parseOperatorExpression(). an operator goes on while its
+        // left power is not less than the power the parser was given, and
+        // hands its right power to its right operand. left < right makes it
+        // left associative. 0 is not an operator of that kind.
+        struct BindingPower
+        {
+            std::uint8_t    prefix;
+            std::uint8_t    left;
+            std::uint8_t    right;
+            std::uint8_t    postfix;
+        };
+
+        struct BindingPowerTable
+        {
+            BindingPower    powers[TOKEN_VALUE_COUNT];
+        };
+
+        constexpr BindingPowerTable makeBindingPowers()
+        {
+            BindingPowerTable table{};
+
+            auto set = [&table](TokenValue value, BindingPower power)
+            {
+                table.powers[static_cast<std::size_t>(value)] = power;
+            };
+
+            // the lowest first. "=" is right associative, a = b = c is a = (b = c).
+            set(TokenValue::ASSIGN, {0, 2, 1, 0});
+            set(TokenValue::AND,    {0, 3, 4, 0});
+            set(TokenValue::LT,     {0, 5, 6, 0});
+            set(TokenValue::ADD,    {0, 7, 8, 0});
+            set(TokenValue::SUB,    {0, 7, 8, 0});
+            set(TokenValue::MULTI,  {0, 9, 10, 0});
+            set(TokenValue::NOT,    {11, 0, 0, 0});
+            set(TokenValue::DOT,    {0, 13, 14, 0});
+            // a[i] and f(x).
+            set(TokenValue::LBRACK, {0, 0, 0, 15});
+            set(TokenValue::LPAREN, {0, 0, 0, 15});
+
+            return table;
+        }
+
+        constexpr BindingPowerTable BINDING_POWERS = makeBindingPowers();
+
+        inline const BindingPower& getBindingPower(TokenValue value)
+        {
+            return BINDING_POWERS.powers[static_cast<std::size_t>(value)];
+        }
+    } // namespace
 
-    Parser::Parser(Scanner& scanner):scanner_(scanner)
+    Parser::Parser(Scanner& scanner)
+        : scanner_(&scanner), tokens_(nullptr), file_(scanner.getFileID()), tokenIndex_(0), overrun_(false), program_(nullptr), errorFlag_(false), quiet_(false)
     {
         // Eat the first token.
-        scanner_.getNextToken();
+        advance();
     }
 
-    Parser::~Parser()
+    Parser::Parser(const TokenBuffer& tokens)
+        : Parser(tokens, 0, tokens.empty() ? 0 : tokens.size() - 1)
+    {}
+
+    Parser::Parser(const TokenBuffer& tokens, std::size_t begin, std::size_t end)
+        : scanner_(nullptr), tokens_(&tokens), file_(tokens.getFileID()), tokenIndex_(begin), tokenEnd_(end), overrun_(false), program_(nullptr), errorFlag_(false), quiet_(false)
     {
-        if (program_ != nullptr)
+        setRange(begin, end);
+    }
+
+    void Parser::setRange(std::size_t begin, std::size_t end)
+    {
+        tokenIndex_ = begin;
+        tokenEnd_ = end;
+
+        if (end < tokens_->size())
         {
-            delete program_;
+            endToken_ = tokens_->at(end);
         }
+        else
+        {
+            // an empty buffer.
+            endToken_ = Token(TokenType::END_OF_FILE, TokenValue::UNRESERVED,
+                              TokenLocation(tokens_->getFileID(), 0), std::string_view("END_OF_FILE"), -1);
+        }
+
+        token_ = begin < end ? tokens_->at(begin) : endToken_;
     }
 
-    std::string Parser::toString()
+    void Parser::writeJSON(std::ostream& out, bool pretty) const
     {
         if (program_ != nullptr)
         {
-            return JSONFormatter::format(program_->toString());
+            JSONWriter writer(out, pretty);
+            ASTSerializer serializer(writer);
+            serializer.write(program_);
         }
-        else
+    }
+
+    void Parser::writeBinary(std::ostream& out) const
+    {
+        if (program_ != nullptr)
         {
-            return "";
+            FlatAST tree(program_);
+            BinaryAST::write(tree, out);
         }
     }
 
     // Goal ::= MainClass ( TypeDeclaration )* <EOF>
     ProgramASTPtr Parser::parse()
     {
-        TokenLocation loc = scanner_.getToken().getTokenLocation();
+        TokenLocation loc = currentToken().getTokenLocation();
 
         VecExprASTPtr classes;
 
-        if (scanner_.getToken().getTokenType() == TokenType::END_OF_FILE)
+        if (currentToken().getTokenType() == TokenType::END_OF_FILE)
         {
             errorReport("The file is empty.");
             classes.clear();
-            program_ = new ProgramAST(loc, classes);
+            program_ = arena_.make<ProgramAST>(loc, arena_.copyArray(classes));
             return program_;
         }
 
@@ -68,15 +154,196 @@ namespace MJava
             errorReport("Missing main class definition.");
         }
 
-        for (;;)
+        parseClassDeclarations(classes);
+
+        program_ = arena_.make<ProgramAST>(mainClass != nullptr ? mainClass->getTokenLocation() : loc,
+                                           arena_.copyArray(classes));
+        return program_;
+    }
+
+    ProgramASTPtr Parser::parseParallel(ThreadPool& pool)
+    {
+        if (tokens_ == nullptr)
+        {
+            return parse();
+        }
+
+        std::vector<std::size_t> classStarts = findClassStarts(*tokens_, tokenIndex_, tokenEnd_);
+
+        // the main class is all before the first class after the first token.
+        if (!classStarts.empty() && classStarts[0] == tokenIndex_)
+        {
+            classStarts.erase(classStarts.begin());
+        }
+
+        // only the main class, nothing to share out.
+        if (classStarts.empty())
+        {
+            return parse();
+        }
+
+        // every class is parsed up to the next one, as a segment of
+        // IncrementalParser is. a parser which is not overrun has done what
+        // parse() does with the same tokens, and parse() goes on from the
+        // next class as it would from the start of a class.
+        classStarts.push_back(tokenEnd_);
+
+        // cut the classes after the main class into groups of about the same
+        // number of tokens, a few groups per thread so that big classes even out.
+        // a cut is the index in classStarts of the first class of a group.
+        std::size_t firstClass = classStarts[0];
+        std::size_t groupCount = std::min(classStarts.size() - 1, pool.size() * 4);
+        std::size_t groupSize = (tokenEnd_ - firstClass) / groupCount + 1;
+        std::vector<std::size_t> cuts(1, 0);
+
+        for (std::size_t i = 1; i + 1 < classStarts.size(); i++)
+        {
+            if (classStarts[i] - classStarts[cuts.back()] >= groupSize)
+            {
+                cuts.push_back(i);
+            }
+        }
+
+        cuts.push_back(classStarts.size() - 1);
+
+        std::vector<std::unique_ptr<Parser>> parsers;
+        std::vector<VecExprASTPtr> groups(cuts.size() - 1);
+        // the errors of every group are kept apart and reported once all the
+        // groups are parsed, and none are if the file is parsed again. the
+        // engine of the caller drops the duplicates then, if it does.
+        std::vector<std::unique_ptr<DiagnosticEngine>> diagnostics;
+        DiagnosticEngine::Options keepAll;
+        keepAll.deduplicate = false;
+
+        for (std::size_t i = 0; i + 1 < cuts.size(); i++)
+        {
+            parsers.emplace_back(new Parser(*tokens_, classStarts[cuts[i]], classStarts[cuts[i + 1]]));
+            diagnostics.emplace_back(new DiagnosticEngine(std::string(), keepAll));
+            Parser* parser = parsers.back().get();
+            VecExprASTPtr* group = &groups[i];
+            DiagnosticEngine* engine = diagnostics.back().get();
+            const std::vector<std::size_t>* starts = &classStarts;
+            std::size_t first = cuts[i];
+            std::size_t last = cuts[i + 1];
+
+            pool.submit([parser, group, engine, starts, first, last]
+            {
+                DiagnosticScope scope(*engine);
+
+                for (std::size_t k = first; k < last && !parser->overrun_; k++)
+                {
+                    parser->setRange((*starts)[k], (*starts)[k + 1]);
+                    parser->parseClassDeclarations(*group);
+                }
+            });
+        }
+
+        // the main class is parsed here while the pool works on the others.
+        Parser mainParser(*tokens_, tokenIndex_, firstClass);
+        TokenLocation loc = mainParser.currentToken().getTokenLocation();
+        VecExprASTPtr classes;
+        ExprASTPtr mainClass = nullptr;
+        DiagnosticEngine mainDiagnostics(std::string(), keepAll);
+
+        {
+            DiagnosticScope scope(mainDiagnostics);
+            mainClass = mainParser.parseMainClass();
+
+            if (mainClass != nullptr)
+            {
+                classes.push_back(mainClass);
+            }
+            else
+            {
+                mainParser.errorReport("Missing main class definition.");
+            }
+
+            // anything between the main class and the next class.
+            if (!mainParser.isAtRangeEnd())
+            {
+                mainParser.parseClassDeclarations(classes);
+            }
+        }
+
+        pool.wait();
+
+        bool overrun = mainParser.overrun_ || std::any_of(parsers.begin(), parsers.end(),
+                                                          [](const std::unique_ptr<Parser>& parser) { return parser->overrun_; });
+
+        // a broken class has gone on into the next one, which parse() parses as a part of it.
+        if (overrun)
+        {
+            return parse();
+        }
+
+        errorFlag_ = errorFlag_ || mainParser.errorFlag_;
+        segmentArenas_.push_back(std::move(mainParser.arena_));
+
+        for (const auto& diagnostic : mainDiagnostics.getDiagnostics())
+        {
+            reportDiagnostic(diagnostic);
+        }
+
+        for (std::size_t i = 0; i < parsers.size(); i++)
+        {
+            classes.insert(classes.end(), groups[i].begin(), groups[i].end());
+            errorFlag_ = errorFlag_ || parsers[i]->errorFlag_;
+            segmentArenas_.push_back(std::move(parsers[i]->arena_));
+
+            for (const auto& diagnostic : diagnostics[i]->getDiagnostics())
+            {
+                reportDiagnostic(diagnostic);
+            }
+        }
+
+        program_ = arena_.make<ProgramAST>(mainClass != nullptr ? mainClass->getTokenLocation() : loc,
+                                           arena_.copyArray(classes));
+        return program_;
+    }
+
+    std::vector<std::size_t> Parser::findClassStarts(const TokenBuffer& tokens, std::size_t begin, std::size_t end)
+    {
+        std::vector<std::size_t> classStarts;
+        int depth = 0;
+
+        for (std::size_t i = begin; i < end; i++)
+        {
+            switch (tokens.getTokenValue(i))
+            {
+                case TokenValue::LBRACE:
+                    ++depth;
+                    break;
+
+                case TokenValue::RBRACE:
+                    --depth;
+                    break;
+
+                case TokenValue::CLASS:
+                    if (depth == 0 && tokens.getTokenType(i) == TokenType::KEYWORD)
+                    {
+                        classStarts.push_back(i);
+                    }
+                    break;
+
+                default:
+                    break;
+            }
+        }
+
+        return classStarts;
+    }
+
+    void Parser::parseClassDeclarations(VecExprASTPtr& classes)
+    {
+        do
         {
             ExprASTPtr currentASTPtr = nullptr;
 
-            switch (scanner_.getToken().getTokenValue())
+            switch (currentToken().getTokenValue())
             {
                 case TokenValue::SEMICOLON:
                 {
-                    scanner_.getNextToken();
+                    advance();
                     break;
                 }
 
@@ -95,19 +362,13 @@ namespace MJava
                     classes.push_back(currentASTPtr);
                 }
             }
-            
-            if (scanner_.getToken().getTokenType() == TokenType::END_OF_FILE)
-            {
-                program_ = new ProgramAST(mainClass->getTokenLocation(), classes);
-                return program_;
-            }
-        }
+        } while (currentToken().getTokenType() != TokenType::END_OF_FILE && !isAtRangeEnd());
     }
 
     // MainClass ::= "class" Identifier "{" "public" "static" "void" "main" "(" "String" "[" "]" Identifier ")" "{" ( VarDeclaration )* ( Statement )* "}" "}"
     ExprASTPtr Parser::parseMainClass()
     {
-        TokenLocation loc = scanner_.getToken().getTokenLocation();
+        TokenLocation loc = currentToken().getTokenLocation();
 
         if (!expectToken(TokenValue::CLASS, "class", true))
         {
@@ -119,9 +380,9 @@ namespace MJava
             return nullptr;
         }
 
-        std::string className = scanner_.getToken().getTokenName();
+        std::string_view className = currentToken().getTokenName();
 
-        scanner_.getNextToken();
+        advance();
 
         if (!expectToken(TokenValue::LBRACE, "{", true))
         {
@@ -142,19 +403,19 @@ namespace MJava
             return nullptr;
         }
 
-        return new MainClassAST(loc, className, mainMethod);
+        return arena_.make<MainClassAST>(loc, arena_.copyString(className), mainMethod);
     }
 
     ExprASTPtr Parser::parseMainMethod()
     {
-        TokenLocation loc = scanner_.getToken().getTokenLocation();
+        TokenLocation loc = currentToken().getTokenLocation();
 
         if (!expectToken(TokenValue::PUBLIC, "public", true))
         {
             return nullptr;
         }
 
-        std::vector<std::string> attributes;
+        std::vector<std::string_view> attributes;
         
         // push "public"
         attributes.push_back("public");
@@ -172,7 +433,7 @@ namespace MJava
             return nullptr;
         }
 
-        std::string returnType = "void";
+        std::string_view returnType = "void";
 
         // main method name should be "main"
         if (!expectToken(TokenValue::MAIN, "main", true))
@@ -180,7 +441,7 @@ namespace MJava
             return nullptr;
         }
 
-        std::string name = "main";
+        std::string_view name = "main";
 
         if (!expectToken(TokenValue::LPAREN, "(", true))
         {
@@ -189,7 +450,7 @@ namespace MJava
 
         VecExprASTPtr parameters;
 
-        TokenLocation parameterLoc = scanner_.getToken().getTokenLocation();
+        TokenLocation parameterLoc = currentToken().getTokenLocation();
 
         // parameter should be String[]
         if (!expectToken(TokenValue::STRING, "String", true))
@@ -212,9 +473,9 @@ namespace MJava
             return nullptr;
         }
 
-        parameters.push_back(new VariableDeclarationAST(parameterLoc, "String[]", scanner_.getToken().getTokenName()));
+        parameters.push_back(arena_.make<VariableDeclarationAST>(parameterLoc, "String[]", arena_.copyString(currentToken().getTokenName())));
 
-        scanner_.getNextToken();
+        advance();
 
         if (!expectToken(TokenValue::RPAREN, ")", true))
         {
@@ -229,12 +490,12 @@ namespace MJava
             return nullptr;
         }
 
-        return new MethodDeclarationAST(loc, attributes, returnType, name, parameters, body);
+        return arena_.make<MethodDeclarationAST>(loc, arena_.copyArray(attributes), arena_.copyString(returnType), arena_.copyString(name), arena_.copyArray(parameters), body);
     }
 
     ExprASTPtr Parser::parseMainMethodBody()
     {
-        TokenLocation loc = scanner_.getToken().getTokenLocation();
+        TokenLocation loc = currentToken().getTokenLocation();
 
         if (!expectToken(TokenValue::LBRACE, "{", true))
         {
@@ -282,7 +543,7 @@ namespace MJava
                 }
                 else
                 {
-                    errorReport(currentASTPtr, "Find unexpected " + currentASTPtr->getASTTypeDescription());
+                    errorReport(currentASTPtr, "Find unexpected " + std::string(currentASTPtr->getASTTypeDescription()));
                 }
             }
         }
@@ -293,7 +554,7 @@ namespace MJava
         }
 
         // main method don't have return statement.
-        return new MethodBodyAST(loc, localVariables, methodBody, nullptr);
+        return arena_.make<MethodBodyAST>(loc, arena_.copyArray(localVariables), arena_.copyArray(methodBody), nullptr);
     }
 
     VecExprASTPtr Parser::parseClassMemberVariables()
@@ -351,7 +612,7 @@ namespace MJava
     // ClassExtendsDeclaration ::= "class" Identifier "extends" Identifier "{" ( VarDeclaration )* ( MethodDeclaration )* "}"
     ExprASTPtr Parser::parseClassDeclaration()
     {
-        TokenLocation loc = scanner_.getToken().getTokenLocation();
+        TokenLocation loc = currentToken().getTokenLocation();
 
         if (!expectToken(TokenValue::CLASS, "class", true))
         {
@@ -363,10 +624,10 @@ namespace MJava
             return nullptr;
         }
 
-        std::string className = scanner_.getToken().getTokenName();
-        std::string baseClassName;
+        std::string_view className = currentToken().getTokenName();
+        std::string_view baseClassName;
 
-        scanner_.getNextToken();
+        advance();
 
         // if the current token is extend, then parse base class.
         if (validateToken(TokenValue::EXTENDS, true))
@@ -376,9 +637,9 @@ namespace MJava
                 return nullptr;
             }
 
-            baseClassName = scanner_.getToken().getTokenName();
+            baseClassName = currentToken().getTokenName();
 
-            scanner_.getNextToken();
+            advance();
         }
 
         if (!expectToken(TokenValue::LBRACE, "{", true))
@@ -396,13 +657,13 @@ namespace MJava
             return nullptr;
         }
 
-        return new ClassDeclarationAST(loc, className, baseClassName, memberVariables, memberMethods);
+        return arena_.make<ClassDeclarationAST>(loc, arena_.copyString(className), arena_.copyString(baseClassName), arena_.copyArray(memberVariables), arena_.copyArray(memberMethods));
     }
 
     // MethodBody := "{" ( VarDeclaration )* ( Statement )* "return" Expression ";" "}"
     ExprASTPtr Parser::parseMethodBody()
     {
-        TokenLocation loc = scanner_.getToken().getTokenLocation();
+        TokenLocation loc = currentToken().getTokenLocation();
 
         if (!expectToken(TokenValue::LBRACE, "{", true))
         {
@@ -450,7 +711,7 @@ namespace MJava
                 }
                 else
                 {
-                    errorReport(currentASTPtr, "Find unexpected " + currentASTPtr->getASTTypeDescription());
+                    errorReport(currentASTPtr, "Find unexpected " + std::string(currentASTPtr->getASTTypeDescription()));
                 }
             }
         }
@@ -475,20 +736,20 @@ namespace MJava
             return nullptr;
         }
         
-        return new MethodBodyAST(loc, localVariables, methodBody, returnStatement);
+        return arena_.make<MethodBodyAST>(loc, arena_.copyArray(localVariables), arena_.copyArray(methodBody), returnStatement);
     }
 
     // MethodDeclaration ::= "public" Type Identifier "(" ( FormalParameterList )? ")" "{" ( VarDeclaration )* ( Statement )* "return" Expression ";" "}"
     ExprASTPtr Parser::parseMethodDeclaration()
     {
-        TokenLocation loc = scanner_.getToken().getTokenLocation();
+        TokenLocation loc = currentToken().getTokenLocation();
 
         if (!expectToken(TokenValue::PUBLIC, "public", true))
         {
             return nullptr;
         }
 
-        std::vector<std::string> attributes;
+        std::vector<std::string_view> attributes;
         
         // push public
         attributes.push_back("public");
@@ -501,14 +762,14 @@ namespace MJava
                 return nullptr;
             }
             
-            attributes.push_back(scanner_.getToken().getTokenName());
+            attributes.push_back(arena_.copyString(currentToken().getTokenName()));
         
-            scanner_.getNextToken();
+            advance();
         }
 
-        std::string returnType = scanner_.getToken().getTokenName();
+        std::string returnType(currentToken().getTokenName());
         
-        scanner_.getNextToken();
+        advance();
 
         if (validateToken(TokenValue::LBRACK, true))
         {
@@ -525,9 +786,9 @@ namespace MJava
             return nullptr;
         }
 
-        std::string name = scanner_.getToken().getTokenName();
+        std::string_view name = currentToken().getTokenName();
 
-        scanner_.getNextToken();
+        advance();
 
         if (!expectToken(TokenValue::LPAREN, "(", true))
         {
@@ -543,6 +804,13 @@ namespace MJava
         // FormalParameterTerm ::= "," FormalParameter
         while (!validateToken(TokenValue::RPAREN, true))
         {
+            // every round takes a token, but END_OF_FILE can not be taken.
+            if (validateToken(TokenType::END_OF_FILE, false))
+            {
+                errorReport("Unexpected end of file in the parameter list");
+                return nullptr;
+            }
+
             ExprASTPtr parameter = parseMethodParameter();
 
             if (parameter != nullptr)
@@ -559,25 +827,25 @@ namespace MJava
             return nullptr;
         }
 
-        return new MethodDeclarationAST(loc, attributes, returnType, name, parameters, body);
+        return arena_.make<MethodDeclarationAST>(loc, arena_.copyArray(attributes), arena_.copyString(returnType), arena_.copyString(name), arena_.copyArray(parameters), body);
     }
 
     ExprASTPtr Parser::parseMethodParameter()
     {
         if (!validateToken(TokenValue::RPAREN, true))
         {
-            TokenLocation loc = scanner_.getToken().getTokenLocation();
+            TokenLocation loc = currentToken().getTokenLocation();
 
             if (!validateToken(TokenType::TYPE, false) && !validateToken(TokenType::IDENTIFIER, false))
             {
-                errorReport("Expected ' type or identifier ', but find " + scanner_.getToken().tokenTypeDescription() + " " + scanner_.getToken().getTokenName());
-                scanner_.getNextToken();
+                errorReport("Expected ' type or identifier ', but find " + currentToken().tokenTypeDescription() + " " + std::string(currentToken().getTokenName()));
+                advance();
                 return nullptr;
             }
 
-            std::string type = scanner_.getToken().getTokenName();
+            std::string type(currentToken().getTokenName());
 
-            scanner_.getNextToken();
+            advance();
 
             // if the current token is '[', the type will be array.
             if (validateToken(TokenValue::LBRACK, true))
@@ -595,13 +863,13 @@ namespace MJava
                 return nullptr;
             }
 
-            std::string name = scanner_.getToken().getTokenName();
+            std::string_view name = currentToken().getTokenName();
 
-            scanner_.getNextToken();
+            advance();
 
             if (validateToken(TokenValue::RPAREN, false))
             {
-                return new VariableDeclarationAST(loc, type, name);
+                return arena_.make<VariableDeclarationAST>(loc, arena_.copyString(type), arena_.copyString(name));
             }
 
             if (!expectToken(TokenValue::COMMA, ",", true))
@@ -609,16 +877,16 @@ namespace MJava
                 return nullptr;
             }
 
-            return new VariableDeclarationAST(loc, type, name);
+            return arena_.make<VariableDeclarationAST>(loc, arena_.copyString(type), arena_.copyString(name));
         }
 
         return nullptr;
     }
 
-    ExprASTPtr Parser::parseMethodCallStatement(const Token& token)
+    ExprASTPtr Parser::parseMethodCallStatement(const TokenLocation& loc, std::string_view name)
     {
         // consume '('
-        scanner_.getNextToken();
+        advance();
 
         VecExprASTPtr arguments;
 
@@ -648,12 +916,12 @@ namespace MJava
             }
         }
 
-        return new MethodCallAST(token.getTokenLocation(), token.getTokenName(), arguments);
+        return arena_.make<MethodCallAST>(loc, name, arena_.copyArray(arguments));
     }
 
     ExprASTPtr Parser::parseLengthStatement()
     {
-        TokenLocation loc = scanner_.getToken().getTokenLocation();
+        TokenLocation loc = currentToken().getTokenLocation();
 
         if (!expectToken(TokenValue::LENGTH, "length", true))
         {
@@ -662,13 +930,13 @@ namespace MJava
 
         VecExprASTPtr arguments;
 
-        return new MethodCallAST(loc, "length", arguments);
+        return arena_.make<MethodCallAST>(loc, "length", arena_.copyArray(arguments));
     }
 
     // PrintStatement ::= "System.out.println" "(" Expression ")" ";"
     ExprASTPtr Parser::parsePrintStatement()
     {
-        TokenLocation loc = scanner_.getToken().getTokenLocation();
+        TokenLocation loc = currentToken().getTokenLocation();
 
         if (!expectToken(TokenValue::PRINT, "System.out.println", true))
         {
@@ -698,13 +966,13 @@ namespace MJava
             return nullptr;
         }
 
-        return new PrintStatementAST(loc, printStatement);
+        return arena_.make<PrintStatementAST>(loc, printStatement);
     }
 
     // ReturnStatement ::= "return" Expression ";"
     ExprASTPtr Parser::parseReturnStatement()
     {
-        TokenLocation loc = scanner_.getToken().getTokenLocation();
+        TokenLocation loc = currentToken().getTokenLocation();
 
         if (!expectToken(TokenValue::RETURN, "return", true))
         {
@@ -724,7 +992,7 @@ namespace MJava
             return nullptr;
         }
 
-        return new ReturnStatementAST(loc, returnStatement);
+        return arena_.make<ReturnStatementAST>(loc, returnStatement);
     }
 
     // ArrayAllocationExpression ::= BooleanArrayAllocationExpression | IntegerArrayAllocationExpression
@@ -733,7 +1001,7 @@ namespace MJava
     // AllocationExpression ::= "new" Identifier "(" ")"
     ExprASTPtr Parser::parseNewStatement()
     {
-        TokenLocation loc = scanner_.getToken().getTokenLocation();
+        TokenLocation loc = currentToken().getTokenLocation();
 
         if (!expectToken(TokenValue::NEW, "new", true))
         {
@@ -742,20 +1010,20 @@ namespace MJava
 
         if (!validateToken(TokenType::TYPE, false) && !validateToken(TokenType::IDENTIFIER, false))
         {
-            errorReport("Expected ' type or identifier ', but find " + scanner_.getToken().tokenTypeDescription() + " " + scanner_.getToken().getTokenName());
+            errorReport("Expected ' type or identifier ', but find " + currentToken().tokenTypeDescription() + " " + std::string(currentToken().getTokenName()));
             return nullptr;
         }
 
-        Token token = scanner_.getToken();
-        std::string type = token.getTokenName();
+        Token token = currentToken();
+        std::string type(token.getTokenName());
 
-        scanner_.getNextToken();
+        advance();
 
         ExprASTPtr expression = nullptr;
 
         if (validateToken(TokenValue::LPAREN, false))
         {
-            expression = parseMethodCallStatement(token);
+            expression = parseMethodCallStatement(token.getTokenLocation(), arena_.copyString(token.getTokenName()));
         }
 
         if (validateToken(TokenValue::LBRACK, true))
@@ -777,7 +1045,7 @@ namespace MJava
             type += "[]";
         }
 
-        return new NewStatementAST(loc, type, expression);
+        return arena_.make<NewStatementAST>(loc, arena_.copyString(type), expression);
     }
 
     // VarDeclaration ::= Type Identifier ";"
@@ -788,16 +1056,16 @@ namespace MJava
     // IntegerType ::= "int"
     ExprASTPtr Parser::parseVariableDeclaration()
     {
-        TokenLocation loc = scanner_.getToken().getTokenLocation();
+        TokenLocation loc = currentToken().getTokenLocation();
 
         if (!expectToken(TokenType::TYPE, "type", false))
         {
             return nullptr;
         }
 
-        std::string type = scanner_.getToken().getTokenName();
+        std::string type(currentToken().getTokenName());
 
-        scanner_.getNextToken();
+        advance();
 
         // if the current token is '[', the type of variable will be array.
         if (validateToken(TokenValue::LBRACK, true))
@@ -814,21 +1082,21 @@ namespace MJava
             return nullptr;
         }
 
-        std::string name = scanner_.getToken().getTokenName();
+        std::string_view name = currentToken().getTokenName();
 
-        scanner_.getNextToken();
+        advance();
         
         if (!expectToken(TokenValue::SEMICOLON, ";", true))
         {
                 return nullptr;
         }
 
-        return new VariableDeclarationAST(loc, type, name);
+        return arena_.make<VariableDeclarationAST>(loc, arena_.copyString(type), arena_.copyString(name));
     }
 
     ExprASTPtr Parser::parseVariableDeclaration(const Token& token)
     {
-        std::string type = token.getTokenName();
+        std::string type(token.getTokenName());
 
         // if the current token is '[', the type of variable will be array.
         if (validateToken(TokenValue::LBRACK, true))
@@ -845,33 +1113,36 @@ namespace MJava
             return nullptr;
         }
 
-        std::string name = scanner_.getToken().getTokenName();
+        std::string_view name = currentToken().getTokenName();
 
-        scanner_.getNextToken();
+        advance();
         
         if (!expectToken(TokenValue::SEMICOLON, ";", true))
         {
             return nullptr;
         }
 
-        return new VariableDeclarationAST(token.getTokenLocation(), type, name);
+        return arena_.make<VariableDeclarationAST>(token.getTokenLocation(), arena_.copyString(type), arena_.copyString(name));
     }
 
     ExprASTPtr Parser::parseExpression()
     {
-        auto lhs = parsePrimary();
+        // nothing allocated by an expression which fails is used, give it back.
+        Arena::Mark mark = arena_.getMark();
 
-        if (lhs == nullptr)
+        ExprASTPtr currentASTPtr = parseOperatorExpression(0);
+
+        if (currentASTPtr == nullptr)
         {
+            arena_.rewind(mark);
             return nullptr;
         }
 
-        ExprASTPtr currentASTPtr = parseBinOpRHS(0, lhs);
-
-        if (currentASTPtr != nullptr && (currentASTPtr->getID() == ASTType::BINARYOPEXPRESSION && static_cast<BinaryOpExpressionAST*>(currentASTPtr)->getBinaryOp() == "="))
+        if (currentASTPtr->getID() == ASTType::BINARYOPEXPRESSION && static_cast<BinaryOpExpressionAST*>(currentASTPtr)->getBinaryOp() == TokenValue::ASSIGN)
         {
             if (!expectToken(TokenValue::SEMICOLON, ";", true))
             {
+                arena_.rewind(mark);
                 return nullptr;
             }
         }
@@ -882,7 +1153,7 @@ namespace MJava
     // parse all primary expression
     ExprASTPtr Parser::parsePrimary()
     {
-        Token token = scanner_.getToken();
+        const Token& token = currentToken();
         switch (token.getTokenType())
         {
             case TokenType::KEYWORD:
@@ -921,7 +1192,10 @@ namespace MJava
 
                     default:
                         errorReport("I have not completed parsePrimary part");
-                        std::exit(1);
+                        advance();
+                        synchronize();
+
+                        return nullptr;
                 }
             }
 
@@ -934,7 +1208,10 @@ namespace MJava
 
                     default:
                         errorReport("should not reach here, unexpected delimiter.");
-                        std::exit(1);
+                        advance();
+                        synchronize();
+
+                        return nullptr;
                 }
             }
 
@@ -947,7 +1224,10 @@ namespace MJava
 
                     default:
                         errorReport("should not reach here, unexpected operator.");
-                        std::exit(1);
+                        advance();
+                        synchronize();
+
+                        return nullptr;
                 }
             }
 
@@ -974,9 +1254,9 @@ namespace MJava
 
             default:
             {
-                errorReport("unknown token when expecting an expression: " + scanner_.getToken().getTokenName());
+                errorReport("unknown token when expecting an expression: " + std::string(currentToken().getTokenName()));
                 // skip the unknown token
-                scanner_.getNextToken();
+                advance();
 
                 return nullptr;
             }
@@ -985,17 +1265,17 @@ namespace MJava
 
     ExprASTPtr Parser::parseIdentifierExpression()
     {
-        TokenLocation loc = scanner_.getToken().getTokenLocation();
+        TokenLocation loc = currentToken().getTokenLocation();
 
         if (!validateToken(TokenType::IDENTIFIER, false) && !validateToken(TokenValue::THIS, false))
         {
-            errorReport("Expected ' identifier or this ', but find " + scanner_.getToken().tokenTypeDescription() + " " + scanner_.getToken().getTokenName());
+            errorReport("Expected ' identifier or this ', but find " + currentToken().tokenTypeDescription() + " " + std::string(currentToken().getTokenName()));
             return nullptr;
         }
 
-        Token token = scanner_.getToken();
+        Token token = currentToken();
 
-        scanner_.getNextToken();
+        advance();
 
         // if the current token is identifier, then parser variable declaration.
         if (validateToken(TokenType::IDENTIFIER, false))
@@ -1003,109 +1283,69 @@ namespace MJava
             return parseVariableDeclaration(token);
         }
 
-        // if the current token is '(', then parse method call statement.
-        if (validateToken(TokenValue::LPAREN, false))
-        {
-            return parseMethodCallStatement(token);
-        }
-
-        // if the current token is '[', then parse index of array or variable declaration.
-        if (validateToken(TokenValue::LBRACK, true))
-        {
-            if (validateToken(TokenValue::RBRACK, true))
-            {
-                std::string name = scanner_.getToken().getTokenName();
-
-                scanner_.getNextToken();
-
-                if (!expectToken(TokenValue::SEMICOLON, ";", true))
-                {
-                    return nullptr;
-                }
-
-                return new VariableDeclarationAST(loc, token.getTokenName() + "[]", name);                
-            }
-            else
-            {
-                ExprASTPtr index = parseExpression();
-
-                if (index == nullptr)
-                {
-                    errorReport("Missing index of array.");
-                    return nullptr;
-                }
-
-                if (!expectToken(TokenValue::RBRACK, "]",  true))
-                {
-                    return nullptr;
-                }
-
-                return new ArrayAST(loc, token.getTokenName(), index);
-            }
-        }
-
-        return new VariableAST(loc, token.getTokenName());
+        // a '(' or a '[' after the name is left to parsePostfixOp.
+        return arena_.make<VariableAST>(loc, arena_.copyString(token.getTokenName()));
     }
 
     // RealLiteral ::= <REALLITERAL>
     ExprASTPtr Parser::parseRealExpression()
     {
-        TokenLocation loc = scanner_.getToken().getTokenLocation();
+        TokenLocation loc = currentToken().getTokenLocation();
 
-        double real = scanner_.getToken().getRealValue();
+        double real = currentToken().getRealValue();
 
-        scanner_.getNextToken();
+        advance();
 
-        return new RealAST(loc, real);
+        return arena_.make<RealAST>(loc, real);
     }
 
     // IntegerLiteral ::= <INTEGER_LITERAL>
     ExprASTPtr Parser::parseIntegerExpression()
     {
-        TokenLocation loc = scanner_.getToken().getTokenLocation();
+        TokenLocation loc = currentToken().getTokenLocation();
 
-        int integer = scanner_.getToken().getIntValue();
+        int integer = currentToken().getIntValue();
 
-        scanner_.getNextToken();
+        advance();
 
-        return new IntegerAST(loc, integer);
+        return arena_.make<IntegerAST>(loc, integer);
     }
 
     // CharLiteral ::= <CHATLITERAL>
     ExprASTPtr Parser::parseCharExpression()
     {
-        TokenLocation loc = scanner_.getToken().getTokenLocation();
+        TokenLocation loc = currentToken().getTokenLocation();
 
-        char ch = scanner_.getToken().getIntValue();
+        char ch = currentToken().getIntValue();
 
-        scanner_.getNextToken();
+        advance();
 
-        return new CharAST(loc, ch);
+        return arena_.make<CharAST>(loc, ch);
     }
 
     // StringLiteral ::= <STRINGLITERAL>
     ExprASTPtr Parser::parseStringExpression()
     {
-        TokenLocation loc = scanner_.getToken().getTokenLocation();
+        TokenLocation loc = currentToken().getTokenLocation();
 
-        std::string string = scanner_.getToken().getStringValue();
+        std::string_view string = currentToken().getStringValue();
 
-        scanner_.getNextToken();
+        advance();
 
-        return new StringAST(loc, string);
+        return arena_.make<StringAST>(loc, arena_.copyString(string));
     }
 
     // TrueLiteral ::= "true"
     // FalseLiteral ::= "false"
     ExprASTPtr Parser::parseBooleanExpression()
     {
-        TokenLocation loc = scanner_.getToken().getTokenLocation();
+        TokenLocation loc = currentToken().getTokenLocation();
 
-        bool boolean = (scanner_.getToken().getTokenName() == "true");
+        bool boolean = (currentToken().getTokenValue() == TokenValue::TRUE);
 
-        scanner_.getNextToken();
+        advance();
 
-        return new BooleanAST(loc, boolean);
+        return arena_.make<BooleanAST>(loc, boolean);
     }
 
     // AssignmentStatement ::= Identifier "=" Expression ";"
@@ -1115,49 +1355,111 @@ namespace MJava
     // PlusExpression ::= PrimaryExpression "+" PrimaryExpression
     // MinusExpression ::= PrimaryExpression "-" PrimaryExpression
     // TimesExpression ::= PrimaryExpression "*" PrimaryExpression
-    ExprASTPtr Parser::parseBinOpRHS(int precedence, ExprASTPtr lhs)
+    // the operators are taken in a loop as long as they bind at least as
+    // tightly as bindingPower, see BINDING_POWERS. only a right operand
+    // recurses, so a chain of operators of one level is one loop.
+    ExprASTPtr Parser::parseOperatorExpression(int bindingPower)
     {
-        TokenLocation loc = scanner_.getToken().getTokenLocation();
+        ExprASTPtr expr = parsePrimary();
 
-        ExprASTPtr expr = lhs;
+        if (expr == nullptr)
+        {
+            return nullptr;
+        }
 
         while (true)
         {
-            int currentPrecedence = scanner_.getToken().getSymbolPrecedence();
+            TokenValue op = currentToken().getTokenValue();
+            const BindingPower& power = getBindingPower(op);
 
-            // if the precedence of current token less than the precedence of the last token, return current ast.
-            if (currentPrecedence < precedence)
+            if (power.postfix != 0)
+            {
+                if (power.postfix < bindingPower)
+                {
+                    return expr;
+                }
+
+                expr = parsePostfixOp(expr);
+
+                if (expr == nullptr)
+                {
+                    return nullptr;
+                }
+
+                continue;
+            }
+
+            if (power.left == 0 || power.left < bindingPower)
             {
                 return expr;
             }
 
-            std::string binOp = scanner_.getToken().getTokenName();
+            TokenLocation loc = currentToken().getTokenLocation();
 
-            scanner_.getNextToken();
+            advance();
 
-            ExprASTPtr rhs = parsePrimary();
+            ExprASTPtr rhs = parseOperatorExpression(power.right);
 
             if (rhs == nullptr)
             {
                 return nullptr;
             }
 
-            int nextPrecedence = scanner_.getToken().getSymbolPrecedence();
-            // if the precedence of current token less than the precedence of the next token, continue to parse.
-            if (currentPrecedence < nextPrecedence)
+            expr = arena_.make<BinaryOpExpressionAST>(loc, op, expr, rhs);
+        }
+    }
+
+    // ArrayLookup ::= PrimaryExpression "[" PrimaryExpression "]"
+    // MessageSend ::= PrimaryExpression "." Identifier "(" ( ExpressionList )? ")"
+    // only a name can be indexed or called. a name followed by "[" "]" is
+    // the type of a variable declaration.
+    ExprASTPtr Parser::parsePostfixOp(ExprASTPtr operand)
+    {
+        if (!validateAST(ASTType::VARIABLE, operand))
+        {
+            errorReport("Expected ' identifier ' before " + std::string(currentToken().getTokenName()) + ", but find " + std::string(operand->getASTTypeDescription()));
+            return nullptr;
+        }
+
+        TokenLocation loc = operand->getTokenLocation();
+        std::string_view name = static_cast<VariableAST*>(operand)->getName();
+
+        if (validateToken(TokenValue::LPAREN, false))
+        {
+            return parseMethodCallStatement(loc, name);
+        }
+
+        // consume '['
+        advance();
+
+        if (validateToken(TokenValue::RBRACK, true))
+        {
+            std::string_view variableName = currentToken().getTokenName();
+
+            advance();
+
+            if (!expectToken(TokenValue::SEMICOLON, ";", true))
             {
-                rhs = parseBinOpRHS(currentPrecedence + 1, rhs);
-                
-                if (rhs == nullptr)
-                {
-                    return nullptr;
-                }
+                return nullptr;
             }
 
-            expr = new BinaryOpExpressionAST(loc, binOp, expr, rhs);
+            return arena_.make<VariableDeclarationAST>(loc, arena_.copyString(std::string(name) + "[]"), arena_.copyString(variableName));
         }
 
-        return nullptr;
+        ExprASTPtr index = parseExpression();
+
+        if (index == nullptr)
+        {
+            errorReport("Missing index of array.");
+            return nullptr;
+        }
+
+        if (!expectToken(TokenValue::RBRACK, "]",  true))
+        {
+            return nullptr;
+        }
+
+        return arena_.make<ArrayAST>(loc, name, index);
     }
 
     // NotExpression ::= "!" Clause
@@ -1165,13 +1467,13 @@ namespace MJava
     // MJava have only one unary operator "!", but we can add other unary operators.
     ExprASTPtr Parser::parseUnaryOp()
     {
-        TokenLocation loc = scanner_.getToken().getTokenLocation();
+        TokenLocation loc = currentToken().getTokenLocation();
 
-        std::string unaryOp = scanner_.getToken().getTokenName();
+        TokenValue unaryOp = currentToken().getTokenValue();
 
-        scanner_.getNextToken();
+        advance();
 
-        auto currentASTPtr = parsePrimary();
+        auto currentASTPtr = parseOperatorExpression(getBindingPower(unaryOp).prefix);
 
         if (currentASTPtr == nullptr)
         {
@@ -1179,14 +1481,14 @@ namespace MJava
             return nullptr;
         }
 
-        return new UnaryOpExpressionAST(loc, unaryOp, currentASTPtr);
+        return arena_.make<UnaryOpExpressionAST>(loc, unaryOp, currentASTPtr);
     }
 
     // BracketExpression ::= "(" Expression ")"
     ExprASTPtr Parser::parseParenExpression()
     {
         // consume '('
-        scanner_.getNextToken();
+        advance();
 
         // parse main expression
         ExprASTPtr currentASTPtr = parseExpression();
@@ -1208,7 +1510,7 @@ namespace MJava
     // Block ::= "{" ( Statement )* "}"
     ExprASTPtr Parser::parseBlockOrStatement()
     {
-        TokenLocation loc = scanner_.getToken().getTokenLocation();
+        TokenLocation loc = currentToken().getTokenLocation();
 
         // if do not have '{' , then there can be only one statement.
         if (!validateToken(TokenValue::LBRACE, false))
@@ -1217,7 +1519,7 @@ namespace MJava
         }
 
         // consume '{'
-        scanner_.getNextToken();
+        advance();
 
         VecExprASTPtr stmts;
 
@@ -1233,7 +1535,7 @@ namespace MJava
                 }
                 else
                 {
-                    errorReport(currentASTPtr, "Find unexpected " + currentASTPtr->getASTTypeDescription());
+                    errorReport(currentASTPtr, "Find unexpected " + std::string(currentASTPtr->getASTTypeDescription()));
                 }
             }
         }
@@ -1243,13 +1545,13 @@ namespace MJava
             return nullptr;
         }
 
-        return new BlockAST(loc, stmts);
+        return arena_.make<BlockAST>(loc, arena_.copyArray(stmts));
     }
 
     // IfStatement ::= "if" "(" Expression ")" Statement "else" Statement
     ExprASTPtr Parser::parseIfStatement()
     {
-        TokenLocation loc = scanner_.getToken().getTokenLocation();
+        TokenLocation loc = currentToken().getTokenLocation();
 
         // current token is keyword if.
         if (!expectToken(TokenValue::IF, "if", true))
@@ -1297,13 +1599,13 @@ namespace MJava
             return nullptr;
         }
 
-        return new IfStatementAST(loc, condition, thenPart, elsePart);
+        return arena_.make<IfStatementAST>(loc, condition, thenPart, elsePart);
     }
 
     // WhileStatement ::= "while" "(" Expression ")" Statement
     ExprASTPtr Parser::parseWhileStatement()
     {
-        TokenLocation loc = scanner_.getToken().getTokenLocation();
+        TokenLocation loc = currentToken().getTokenLocation();
 
         // current token is keyword while.
         if (!expectToken(TokenValue::WHILE, "while", true))
@@ -1337,12 +1639,12 @@ namespace MJava
             return nullptr;
         }
 
-        return new WhileStatementAST(loc, condition, body);
+        return arena_.make<WhileStatementAST>(loc, condition, body);
     }
 
     ExprASTPtr Parser::parseForStatement()
     {
-        TokenLocation loc = scanner_.getToken().getTokenLocation();
+        TokenLocation loc = currentToken().getTokenLocation();
 
         if (!expectToken(TokenValue::FOR, "for", true))
         {
@@ -1374,7 +1676,7 @@ namespace MJava
             return nullptr;
         }
 
-        return new ForStatementAST(loc, variable, condition, action, body);
+        return arena_.make<ForStatementAST>(loc, variable, condition, action, body);
     }
 
     // Helper Functions.
@@ -1383,7 +1685,7 @@ namespace MJava
     {
         if (ast->getID() != type)
         {
-            errorSyntax(ast->getTokenLocation().toString() + "Expected ' " + astName + " ', but find " + ast->getASTTypeDescription());
+            errorReport(ast, "Expected ' " + astName + " ', but find " + std::string(ast->getASTTypeDescription()));
             return false;
         }
 
@@ -1392,15 +1694,15 @@ namespace MJava
 
     bool Parser::expectToken(TokenValue value, const std::string& tokenName, bool advanceToNextToken)
     {
-        if (scanner_.getToken().getTokenValue() != value)
+        if (currentToken().getTokenValue() != value)
         {
-            errorReport("Expected ' " + tokenName + " ', but find " + scanner_.getToken().getTokenName());
+            errorReport("Expected ' " + tokenName + " ', but find " + std::string(currentToken().getTokenName()));
             return false;
         }
 
         if (advanceToNextToken)
         {
-            scanner_.getNextToken();
+            advance();
         }
 
         return true;
@@ -1408,15 +1710,15 @@ namespace MJava
 
     bool Parser::expectToken(TokenType type, const std::string& tokenTypeDescription, bool advanceToNextToken)
     {
-        if (scanner_.getToken().getTokenType() != type)
+        if (currentToken().getTokenType() != type)
         {
-            errorReport("Expected ' " + tokenTypeDescription + " ', but find " + scanner_.getToken().tokenTypeDescription() + " " + scanner_.getToken().getTokenName());
+            errorReport("Expected ' " + tokenTypeDescription + " ', but find " + currentToken().tokenTypeDescription() + " " + std::string(currentToken().getTokenName()));
             return false;
         }
 
         if (advanceToNextToken)
         {
-            scanner_.getNextToken();
+            advance();
         }
 
         return true;
@@ -1427,6 +1729,36 @@ namespace MJava
         errorFlag_ = flag;
     }
 
+    // panic mode: skip the tokens up to the end of the statement, or to a
+    // token which starts or ends a class or a method, and go on from there.
+    // a ';' is skipped too, the others are left to the caller.
+    void Parser::synchronize()
+    {
+        while (true)
+        {
+            switch (currentToken().getTokenValue())
+            {
+                case TokenValue::SEMICOLON:
+                    advance();
+                    return;
+
+                case TokenValue::RBRACE:
+                case TokenValue::CLASS:
+                case TokenValue::PUBLIC:
+                    return;
+
+                default:
+                    if (currentToken().getTokenType() == TokenType::END_OF_FILE)
+                    {
+                        return;
+                    }
+
+                    advance();
+                    break;
+            }
+        }
+    }
+
     bool Parser::validateAST(ASTType type, ExprASTPtr ast)
     {
         if (ast->getID() != type)
@@ -1448,14 +1780,14 @@ namespace MJava
 
     bool Parser::validateToken(TokenValue value, bool advanceToNextToken)
     {
-        if (scanner_.getToken().getTokenValue() != value)
+        if (currentToken().getTokenValue() != value)
         {
             return false;
         }
 
         if (advanceToNextToken)
         {
-            scanner_.getNextToken();
+            advance();
         }
 
         return true;
@@ -1463,14 +1795,14 @@ namespace MJava
 
     bool Parser::validateToken(TokenType type, bool advanceToNextToken)
     {
-        if (scanner_.getToken().getTokenType() != type)
+        if (currentToken().getTokenType() != type)
         {
             return false;
         }
 
         if (advanceToNextToken)
         {
-            scanner_.getNextToken();
+            advance();
         }
 
         return true;
@@ -1478,12 +1810,22 @@ namespace MJava
 
     void Parser::errorReport(const std::string& msg)
     {
-        errorSyntax(scanner_.getToken().getTokenLocation().toString() + msg);
+        if (!quiet_)
+        {
+            errorSyntax(currentToken().getTokenLocation(), msg);
+        }
+
+        errorFlag_ = true;
     }
 
     void Parser::errorReport(ExprASTPtr ast, const std::string& msg)
     {
-        errorSyntax(ast->getTokenLocation().toString() + msg);
+        if (!quiet_)
+        {
+            errorSyntax(ast->getTokenLocation(), msg);
+        }
+
+        errorFlag_ = true;
     }
 
 } // namespace MJava
\ No newline at end of file
@@ -6,107 +6,110 @@
 
 #include "error.h"
 #include "scanner.h"
+#include "simd.h"
 #include <algorithm>
 #include <cctype>
+#include <climits>
 #include <stdexcept>
+#include <utility>
 
 namespace MJava
 {
-    bool Scanner::errorFlag_ = false;
-
-    Scanner::Scanner(const std::string& srcFileName)
-        : fileName_(srcFileName), line_(1), column_(0),
-          currentChar_(0), state_(State::NONE)
+    Scanner::Scanner(const std::string& srcFileName, Engine engine)
+        : fileName_(srcFileName), fileId_(0), offset_(0), lexemeStart_(0),
+          currentChar_(0), state_(State::NONE), engine_(engine),
+          errorFlag_(false), errorCount_(0), tokenCount_(0)
     {
-        input_.open(fileName_);
+        bool opened = input_.open(fileName_);
 
-        if (input_.fail())
-        {
-            errorReport("When trying to open file " + fileName_ + ", occurred error.");
-        }
-    }
+        fileId_ = SourceManager::instance().addFile(fileName_, input_.data(), input_.size());
 
-    void Scanner::getNextChar()
-    {
-        currentChar_ = input_.get();
-
-        // record the location of token
-        if (currentChar_ == '\n')
+        if (!opened)
         {
-            line_++;
-            column_ = 0;
+            errorReport("When trying to open file " + fileName_ + ", occurred error.");
         }
         else
         {
-            column_++;
+            // the scanner only keeps offsets, line and column come from this index.
+            SourceManager::instance().buildLineIndex(fileId_);
         }
     }
 
-    char Scanner::peekChar()
+    Scanner::Scanner(const std::string& fileName, SourceBuffer&& source, Engine engine)
+        : fileName_(fileName), fileId_(0), input_(std::move(source)), offset_(0), lexemeStart_(0),
+          currentChar_(0), state_(State::NONE), engine_(engine),
+          errorFlag_(false), errorCount_(0), tokenCount_(0)
     {
-        char c = input_.peek();
-        return c;
+        fileId_ = SourceManager::instance().addFile(fileName_, input_.data(), input_.size());
+        SourceManager::instance().buildLineIndex(fileId_);
     }
 
-    void Scanner::addToBuffer(char c)
+    Scanner::Scanner(const std::string& fileName, std::string_view source, Engine engine)
+        : fileName_(fileName), fileId_(0), offset_(0), lexemeStart_(0),
+          currentChar_(0), state_(State::NONE), engine_(engine),
+          errorFlag_(false), errorCount_(0), tokenCount_(0)
     {
-        buffer_.push_back(c);
+        input_.view(source);
+        fileId_ = SourceManager::instance().addFile(fileName_, input_.data(), input_.size());
     }
 
-
-    void Scanner::reduceBuffer()
+    Scanner::~Scanner()
     {
-        buffer_.pop_back();
+        SourceManager::instance().removeFile(fileId_);
     }
 
-
+    void Scanner::getNextChar()
+    {
+        if (offset_ < input_.size())
+        {
+            currentChar_ = input_.data()[offset_++];
+        }
+        else
+        {
+            currentChar_ = static_cast<char>(EOF);
+            // stop at one past the end, so that isEOF() is true from now on.
+            offset_ = input_.size() + 1;
+        }
+    }
 
     void Scanner::makeToken(TokenType tt, TokenValue tv,
-                            const TokenLocation& loc, const std::string& name, int symbolPrecedence)
+                            const TokenLocation& loc, std::string_view name, int symbolPrecedence)
     {
         token_ = Token(tt, tv, loc, name, symbolPrecedence);
-        buffer_.clear();
         state_ = State::NONE;
     }
 
     void Scanner::makeToken(TokenType tt, TokenValue tv,
-                            const TokenLocation& loc, int intValue, const std::string& name)
+                            const TokenLocation& loc, int intValue, std::string_view name)
     {
         token_ = Token(tt, tv, loc, intValue, name);
-        buffer_.clear();
         state_ = State::NONE;
     }
 
     void Scanner::makeToken(TokenType tt, TokenValue tv,
-                            const TokenLocation& loc, double realValue, const std::string& name)
+                            const TokenLocation& loc, double realValue, std::string_view name)
     {
         token_ = Token(tt, tv, loc, realValue, name);
-        buffer_.clear();
         state_ = State::NONE;
     }
 
-    void Scanner::makeToken(TokenType tt, TokenValue tv,
-                            const TokenLocation& loc, const std::string& strValue, const std::string& name)
-    {
-        token_ = Token(tt, tv, loc, strValue, name);
-        buffer_.clear();
-        state_ = State::NONE;
-    }
 
 
     void Scanner::preprocess()
     {
         do
         {
-            // eat spaces
-            while (std::isspace(currentChar_))
+            // eat spaces, the whole run at once.
+            if (std::isspace(currentChar_))
             {
+                offset_ = skipWhitespace(input_.data(), input_.size(), offset_);
                 getNextChar();
             }
 
             handleLineComment();
             handleBlockComment();
-        } while (std::isspace(currentChar_) || currentChar_ == '/'); // eat spaces and comment
+        } while (std::isspace(currentChar_) ||
+                 (currentChar_ == '/' && (peekChar() == '/' || peekChar() == '*'))); // eat spaces and comment
     }
 
     void Scanner::handleLineComment()
@@ -115,18 +118,11 @@ namespace MJava
 
         if (currentChar_ == '/' && peekChar() == '/')
         {
-            // currenChar is / and eat /, update currentChar_ to /
-            getNextChar();
-            // currentChar is / and eat it, update currentChar_ to the next char.
+            // skip "//" and the comment content, stop at '\n' or EOF.
+            offset_ = findNewline(input_.data(), input_.size(), offset_ + 1);
             getNextChar();
 
-            while (currentChar_ != '\n' && !input_.eof())
-            {
-                // skip comment content
-                getNextChar();
-            }
-
-            if (!input_.eof())
+            if (!isEOF())
             {
                 // skip '\n'
                 getNextChar();
@@ -140,25 +136,16 @@ namespace MJava
 
         if (currentChar_ == '/' && peekChar() == '*')
         {
-            // currenChar is / and eat /, update currentChar_ to *
-            getNextChar();
-            // currentChar is * and eat it, update currentChar_ to the next char.
+            // skip "/*" and the comment content, stop at "*/" or EOF.
+            offset_ = findBlockCommentEnd(input_.data(), input_.size(), offset_ + 1);
             getNextChar();
 
-            while (!(currentChar_ == '*' && peekChar() == '/'))
+            // accident EOF
+            if (isEOF())
             {
-                // skip comment content
-                getNextChar();
-
-                // accident EOF
-                if (input_.eof())
-                {
-                    errorReport(std::string("end of file happended in comment, */ is expected!, but find ") + currentChar_);
-                    break;
-                }
+                errorReport(std::string("end of file happended in comment, */ is expected!, but find ") + currentChar_);
             }
-
-            if (!input_.eof())
+            else
             {
                 // eat * and update currentChar_ to /
                 getNextChar();
@@ -168,14 +155,14 @@ namespace MJava
         }
     }
 
-    Token Scanner::getNextToken()
+    const Token& Scanner::getNextToken()
     {
         bool matched = false;
 
         do
         {
             // restore error flag at each time invoke getNextToken()
-            Scanner::errorFlag_ = false;
+            errorFlag_ = false;
 
             if (state_ != State::NONE)
             {
@@ -212,6 +199,10 @@ namespace MJava
                     handleOperationState();
                     break;
 
+                case State::TABLE_DRIVEN:
+                    handleTableDrivenState();
+                    break;
+
                 default:
                     errorReport("Match token state error.");
                     break;
@@ -221,10 +212,14 @@ namespace MJava
             {
                 preprocess();
 
-                if (input_.eof())
+                if (isEOF())
                 {
                     state_ = State::END_OF_FILE;
                 }
+                else if (engine_ == Engine::TABLE_DRIVEN)
+                {
+                    state_ = State::TABLE_DRIVEN;
+                }
                 else
                 {
                     if (std::isalpha(currentChar_))
@@ -252,16 +247,42 @@ namespace MJava
             }
         } while (!matched || getErrorFlag());
 
+        ++tokenCount_;
         return token_;
     }
 
+    TokenBuffer Scanner::tokenizeAll()
+    {
+        TokenBuffer tokens(fileId_);
+        // a token every 8 bytes is about what real sources have.
+        tokens.reserve(input_.size() / 8 + 1);
+
+        do
+        {
+            tokens.push(getNextToken());
+        } while (token_.getTokenType() != TokenType::END_OF_FILE);
+
+        return tokens;
+    }
+
+    void Scanner::rescan(std::string_view source, std::size_t offset)
+    {
+        // the text may be changed in place, so the line index is always dropped.
+        input_.view(source);
+        SourceManager::instance().updateFile(fileId_, input_.data(), input_.size());
+
+        // the next getNextToken() reads the char at offset first.
+        offset_ = offset;
+        currentChar_ = 0;
+        state_ = State::NONE;
+        errorFlag_ = false;
+    }
+
     void Scanner::handleEOFState()
     {
         loc_ = getTokenLocation();
         makeToken(TokenType::END_OF_FILE, TokenValue::UNRESERVED,
-                  loc_, std::string("END_OF_FILE"), -1);
-        // close the file
-        input_.close();
+                  loc_, std::string_view("END_OF_FILE"), -1);
     }
 
 
@@ -291,6 +312,9 @@ namespace MJava
             getNextChar();
         }
 
+        // the prefix 0x or 0 is not a part of the number.
+        lexemeStart_ = currentOffset();
+
         enum class NumberState
         {
             INTERGER,
@@ -385,23 +409,25 @@ namespace MJava
 
         if (!getErrorFlag())
         {
+            std::string_view text = lexeme();
+            // std::stod and std::stoi need a null-terminated string.
+            std::string buffer(text);
+
             if (isFloat || isExponent)
             {
                 try
                 {
                     makeToken(TokenType::REAL, TokenValue::UNRESERVED, loc_,
-                        std::stod(buffer_), buffer_);
+                        std::stod(buffer), text);
                 }
                 catch(std::out_of_range& e)
                 {
-                    errorReport("Floating-point number literal: " + buffer_ + " is outside the range of the \"double\".");
-                    buffer_.clear();
+                    errorReport("Floating-point number literal: " + buffer + " is outside the range of the \"double\".");
                     state_ = State::NONE;
                 }
                 catch(std::invalid_argument& e)
                 {
-                    errorReport("Floating-point number literal: " + buffer_ + " can not be converted to the \"double\".");
-                    buffer_.clear();
+                    errorReport("Floating-point number literal: " + buffer + " can not be converted to the \"double\".");
                     state_ = State::NONE;
                 }    
             }
@@ -410,26 +436,23 @@ namespace MJava
                 try
                 {
                     makeToken(TokenType::INTEGER, TokenValue::UNRESERVED, loc_,
-                        std::stoi(buffer_, nullptr, numberBase), buffer_);
+                        std::stoi(buffer, nullptr, numberBase), text);
                 }
                 catch(std::out_of_range& e)
                 {
-                    errorReport("Integer literal: " + buffer_ + " is outside the range of the \"int\".");
-                    buffer_.clear();
+                    errorReport("Integer literal: " + buffer + " is outside the range of the \"int\".");
                     state_ = State::NONE;
                 }
                 catch(std::invalid_argument& e)
                 {
-                    errorReport("Integer literal: " + buffer_ + " can not be converted to the \"int\".");
-                    buffer_.clear();
+                    errorReport("Integer literal: " + buffer + " can not be converted to the \"int\".");
                     state_ = State::NONE;
                 }               
             }
         }
         else
         {
-            // just clear buffer_ and set the state to State::NONE
-            buffer_.clear();
+            // just set the state to State::NONE
             state_ = State::NONE;
         }
     }
@@ -440,27 +463,31 @@ namespace MJava
         // eat ' and NOT update currentChar_
         // because we don't want ' (single quote).
         getNextChar();
+        lexemeStart_ = currentOffset();
+        bool endOfFile = false;
 
         while (true)
         {
             // skip escape character \'
             if (currentChar_ != '\\' && peekChar() == '\'')
             {
-                addToBuffer(currentChar_);
                 break;
             }
 
-            if (input_.eof())
+            if (isLastChar())
             {
                 errorReport(std::string("end of file happended in string, \' is expected!, but find ") + currentChar_);
+                endOfFile = true;
                 break;
             }
 
-            addToBuffer(currentChar_);
             getNextChar();
         }
 
-        if (!input_.eof())
+        // currentChar_ is the last char before the end ', or the last char of the file.
+        std::string_view buffer = lexeme(endOfFile ? currentOffset() : currentOffset() + 1);
+
+        if (!endOfFile)
         {
             // eat end ' and update currentChar_ .
             getNextChar();
@@ -468,18 +495,22 @@ namespace MJava
         }
 
         // just one char
-        if (!getErrorFlag() && buffer_.length() == 1)
+        if (!getErrorFlag() && buffer.length() == 1)
         {
             makeToken(TokenType::CHAR_LITERAL, TokenValue::UNRESERVED, loc_,
-                      static_cast<int>(buffer_.at(0)), buffer_);
+                      static_cast<int>(buffer.at(0)), buffer);
         }
         else
         {
             errorReport("Char can contain only one character!");
-            // just clear buffer_ and set the state to State::NONE
-            buffer_.clear();
+            // just set the state to State::NONE
             state_ = State::NONE;
         }
+
+        if (endOfFile)
+        {
+            stopAtEndOfFile();
+        }
     }
 
     void Scanner::handleStringState()
@@ -488,27 +519,31 @@ namespace MJava
         // eat " and NOT update currentChar_
         // because we don't want " (double quote).
         getNextChar();
+        lexemeStart_ = currentOffset();
+        bool endOfFile = false;
 
         while (true)
         {
             // skip escape character \"
             if (currentChar_ != '\\' && peekChar() == '\"')
             {
-                addToBuffer(currentChar_);
                 break;
             }
 
-            if (input_.eof())
+            if (isLastChar())
             {
                 errorReport(std::string("end of file happended in string, \" is expected!, but find ") + currentChar_);
+                endOfFile = true;
                 break;
             }
 
-            addToBuffer(currentChar_);
             getNextChar();
         }
 
-        if (!input_.eof())
+        // currentChar_ is the last char before the end ", or the last char of the file.
+        std::string_view buffer = lexeme(endOfFile ? currentOffset() : currentOffset() + 1);
+
+        if (!endOfFile)
         {
             // eat end " and update currentChar_ .
             getNextChar();
@@ -518,92 +553,218 @@ namespace MJava
         if (!getErrorFlag())
         {
             makeToken(TokenType::STRING_LITERAL, TokenValue::UNRESERVED,
-                    loc_, buffer_, buffer_); 
+                    loc_, buffer, -1);
         }
         else
         {
-            // just clear buffer_ and set the state to State::NONE
-            buffer_.clear();
+            // just set the state to State::NONE
             state_ = State::NONE;
         }
+
+        if (endOfFile)
+        {
+            stopAtEndOfFile();
+        }
+    }
+
+    void Scanner::stopAtEndOfFile()
+    {
+        // the spaces at the end are skipped as usual, then END_OF_FILE is
+        // one past the end. otherwise it is at the last char, where the
+        // error is.
+        state_ = std::isspace(currentChar_) ? State::NONE : State::END_OF_FILE;
     }
 
     void Scanner::handleIdentifierState()
     {
         loc_ = getTokenLocation();
-        // add first char
-        addToBuffer(currentChar_);
+        lexemeStart_ = currentOffset();
+        // eat first char
         getNextChar();
 
         while (std::isalnum(currentChar_) || currentChar_ == '_')
         {
-            addToBuffer(currentChar_);
             getNextChar();
         }
         // end while. currentChar_ is not alpha, number and _.
 
-        std::string copy = buffer_;
         // match "System.out.println"
-        if (buffer_ == "System")
+        if (lexeme() == "System")
         {
             // length of "System.out.println" from the first '.' to the end
             int length = 12;
-            // set current location of input stream.
-            std::streampos index = input_.tellg();
+            // remember current location of input.
+            std::size_t offset = offset_;
+            char currentChar = currentChar_;
 
             while (length > 0)
             {
-                addToBuffer(currentChar_);
                 getNextChar();
                 --length;
             }
 
             // if does not match "System.out.println", roll back to the original location.
-            if (buffer_ != "System.out.println")
+            if (lexeme() != "System.out.println")
             {
-                buffer_ = copy;
-                input_.seekg(index);
+                offset_ = offset;
+                currentChar_ = currentChar;
             }
         }
 
+        std::string_view buffer = lexeme();
         // use dictionary to judge it is keyword or not
-        auto tokenMeta = dictionary_.lookup(buffer_);
-        makeToken(std::get<0>(tokenMeta), std::get<1>(tokenMeta), loc_, buffer_, std::get<2>(tokenMeta));
+        auto tokenMeta = dictionary_.lookup(buffer);
+        makeToken(std::get<0>(tokenMeta), std::get<1>(tokenMeta), loc_, buffer, std::get<2>(tokenMeta));
     }
 
     void Scanner::handleOperationState()
     {
         loc_ = getTokenLocation();
-        // add current symbol char
-        addToBuffer(currentChar_);
-        // add next one symbol char
-        addToBuffer(peekChar());
+        lexemeStart_ = currentOffset();
+        std::string_view buffer = lexeme(offset_);
+        const DictionaryEntry* entry = nullptr;
+
+        // current symbol char and next one symbol char
+        if (offset_ < input_.size())
+        {
+            entry = Dictionary::find(lexeme(offset_ + 1));
+        }
 
-        if (dictionary_.haveToken(buffer_))
+        if (entry != nullptr)
         {
+            buffer = lexeme(offset_ + 1);
             getNextChar();
         }
         else
         {
-            reduceBuffer();
+            entry = Dictionary::find(buffer);
         }
 
-        auto tokenMeta = dictionary_.lookup(buffer_);
         // token type, token value, name, symbol precedence
-        makeToken(std::get<0>(tokenMeta), std::get<1>(tokenMeta), loc_, buffer_, std::get<2>(tokenMeta));
+        if (entry != nullptr)
+        {
+            makeToken(entry->type, entry->value, loc_, buffer, entry->precedence);
+        }
+        else
+        {
+            makeToken(TokenType::IDENTIFIER, TokenValue::UNRESERVED, loc_, buffer, -1);
+        }
+
         // update currentChar_
         getNextChar();
     }
 
+    void Scanner::handleTableDrivenState()
+    {
+        loc_ = getTokenLocation();
+        lexemeStart_ = currentOffset();
+        DFAState dfaState = DFAState::START;
+
+        // eat chars until the DFA reaches a final state.
+        while (true)
+        {
+            CharClass charClass = CHAR_CLASS_TABLE[static_cast<unsigned char>(currentChar_)];
+            dfaState = DFA_TRANSITION_TABLE[static_cast<std::size_t>(dfaState)][static_cast<std::size_t>(charClass)];
+
+            if (static_cast<std::uint8_t>(dfaState) >= DFA_FIRST_FINAL_STATE)
+            {
+                break;
+            }
+
+            getNextChar();
+        }
+
+        if (dfaStateEatsChar(dfaState))
+        {
+            getNextChar();
+        }
+
+        switch (dfaState)
+        {
+            case DFAState::IDENTIFIER_DONE:
+            {
+                // "System.out.println" needs to look ahead more than one char.
+                if (lexeme() == "System")
+                {
+                    rewindToLexemeStart();
+                    handleIdentifierState();
+                    break;
+                }
+
+                std::string_view buffer = lexeme();
+                auto tokenMeta = dictionary_.lookup(buffer);
+                makeToken(std::get<0>(tokenMeta), std::get<1>(tokenMeta), loc_, buffer, std::get<2>(tokenMeta));
+                break;
+            }
+
+            case DFAState::INTEGER_DONE:
+            {
+                std::string_view buffer = lexeme();
+                long long value = 0;
+
+                for (char c : buffer)
+                {
+                    value = value * 10 + (c - '0');
+
+                    if (value > INT_MAX)
+                    {
+                        break;
+                    }
+                }
+
+                // let the hand-written one report the error.
+                if (value > INT_MAX)
+                {
+                    rewindToLexemeStart();
+                    handleNumberState();
+                    break;
+                }
+
+                makeToken(TokenType::INTEGER, TokenValue::UNRESERVED, loc_, static_cast<int>(value), buffer);
+                break;
+            }
+
+            case DFAState::NUMBER_FALLBACK:
+                rewindToLexemeStart();
+                handleNumberState();
+                break;
+
+            case DFAState::CHAR_FALLBACK:
+                rewindToLexemeStart();
+                handleCharState();
+                break;
+
+            case DFAState::STRING_FALLBACK:
+                rewindToLexemeStart();
+                handleStringState();
+                break;
+
+            default:
+            {
+                // operators, delimiters and unknown chars
+                std::string_view buffer = lexeme();
+                const DictionaryEntry* entry = Dictionary::find(buffer);
+
+                if (entry != nullptr)
+                {
+                    makeToken(entry->type, entry->value, loc_, buffer, entry->precedence);
+                }
+                else
+                {
+                    makeToken(TokenType::IDENTIFIER, TokenValue::UNRESERVED, loc_, buffer, -1);
+                }
+                break;
+            }
+        }
+    }
+
     void Scanner::handleDigit()
     {
-        // add first number of integer
-        addToBuffer(currentChar_);
+        // eat first number of integer
         getNextChar();
 
         while (std::isdigit(currentChar_))
         {
-            addToBuffer(currentChar_);
             getNextChar();
         }
         // end while. currentChar_ is not digit.
@@ -624,7 +785,6 @@ namespace MJava
         while (std::isxdigit(currentChar_))
         {
             readFlag = true;
-            addToBuffer(currentChar_);
             getNextChar();
         }
 
@@ -645,7 +805,6 @@ namespace MJava
         while (currentChar_ >= '0' && currentChar_ <= '7')
         {
             readFlag = true;
-            addToBuffer(currentChar_);
             getNextChar();
         }
 
@@ -672,12 +831,10 @@ namespace MJava
         }
 
         // eat .
-        addToBuffer(currentChar_);
         getNextChar();
 
         while (std::isdigit(currentChar_))
         {
-            addToBuffer(currentChar_);
             getNextChar();
         }
     }
@@ -685,7 +842,6 @@ namespace MJava
     void Scanner::handleExponent()
     {
         // eat E/e
-        addToBuffer(currentChar_);
         getNextChar();
 
         // next char will be [sign] | digital-sequence
@@ -697,21 +853,21 @@ namespace MJava
         // if number has +/-
         if (currentChar_ == '+' || currentChar_ == '-')
         {
-            addToBuffer(currentChar_);
             getNextChar();
         }
 
         // next will only be digits
         while (std::isdigit(currentChar_))
         {
-            addToBuffer(currentChar_);
             getNextChar();
         }
     }
 
     void Scanner::errorReport(const std::string& msg)
     {
-        errorToken(getTokenLocation().toString() + msg);
+        errorToken(getTokenLocation(), msg);
+        errorFlag_ = true;
+        ++errorCount_;
     }
 
     void Scanner::setErrorFlag(bool flag)
@@ -0,0 +1,403 @@
+// THIS FILE IS PART OF MJava-Compiler PROJECT
+// serverprotocol.cpp - messages between the compile server and its clients
+
+// Created by Li Taiji 2026-10-17
+// Copyright (c) 2026 Li Taiji All rights reserved
+
+#include "serverprotocol.h"
+#include <cstdlib>
+#include <limits>
+
+#if !defined(_WIN32)
+    #include <cerrno>
+    #include <cstring>
+    #include <sys/socket.h>
+    #include <sys/time.h>
+    #include <sys/un.h>
+    #include <unistd.h>
+#endif
+
+namespace MJava
+{
+    namespace
+    {
+        // a header longer than this is not a message of ours.
+        const std::size_t MAX_HEADER_SIZE = 64 * 1024;
+    } // namespace
+
+    std::string getDefaultServerSocket()
+    {
+        const char* runtimeDirectory = std::getenv("XDG_RUNTIME_DIR");
+
+        if (runtimeDirectory != nullptr && runtimeDirectory[0] != '\0')
+        {
+            return std::string(runtimeDirectory) + "/mjava-compiler.sock";
+        }
+
+#if defined(_WIN32)
+        return "mjava-compiler.sock";
+
+#else
+        return "/tmp/mjava-compiler-" + std::to_string(::getuid()) + ".sock";
+#endif
+    }
+
+    void Message::setField(const std::string& name, const std::string& value)
+    {
+        for (auto& field : fields_)
+        {
+            if (field.first == name)
+            {
+                field.second = value;
+                return;
+            }
+        }
+
+        fields_.emplace_back(name, value);
+    }
+
+    std::string Message::getField(const std::string& name, const std::string& defaultValue) const
+    {
+        for (const auto& field : fields_)
+        {
+            if (field.first == name)
+            {
+                return field.second;
+            }
+        }
+
+        return defaultValue;
+    }
+
+    bool Message::hasField(const std::string& name) const
+    {
+        for (const auto& field : fields_)
+        {
+            if (field.first == name)
+            {
+                return true;
+            }
+        }
+
+        return false;
+    }
+
+    void Message::setBody(std::string body)
+    {
+        body_ = std::move(body);
+    }
+
+    std::string Message::encode() const
+    {
+        std::string text;
+
+        for (const auto& field : fields_)
+        {
+            if (field.first != "length")
+            {
+                text += field.first + ' ' + field.second + '\n';
+            }
+        }
+
+        text += "length " + std::to_string(body_.size()) + "\n\n";
+        text += body_;
+
+        return text;
+    }
+
+    Connection::Connection(int fd) : fd_(fd), maxBodySize_(std::numeric_limits<std::size_t>::max())
+    {}
+
+    Connection::~Connection()
+    {
+        close();
+    }
+
+    bool Connection::hasMessage() const
+    {
+        Message message;
+        std::size_t headerEnd = 0;
+
+        if (!readHeader(message, headerEnd))
+        {
+            return buffer_.size() > MAX_HEADER_SIZE;
+        }
+
+        std::size_t length = getBodyLength(message);
+        return length > maxBodySize_ || buffer_.size() - headerEnd >= length;
+    }
+
+    void Connection::setMaxBodySize(std::size_t size)
+    {
+        maxBodySize_ = size;
+    }
+
+    bool Connection::readHeader(Message& message, std::size_t& headerEnd) const
+    {
+        message = Message();
+
+        // the header ends at the first empty line.
+        if (buffer_.compare(0, 1, "\n") == 0)
+        {
+            headerEnd = 1;
+        }
+        else
+        {
+            std::size_t position = buffer_.find("\n\n");
+
+            if (position == std::string::npos)
+            {
+                return false;
+            }
+
+            headerEnd = position + 2;
+        }
+
+        std::size_t lineStart = 0;
+
+        while (lineStart + 1 < headerEnd)
+        {
+            std::size_t lineEnd = buffer_.find('\n', lineStart);
+            std::size_t space = buffer_.find(' ', lineStart);
+
+            if (space == std::string::npos || space > lineEnd)
+            {
+                space = lineEnd;
+            }
+
+            message.setField(buffer_.substr(lineStart, space - lineStart),
+                             space < lineEnd ? buffer_.substr(space + 1, lineEnd - space - 1) : std::string());
+            lineStart = lineEnd + 1;
+        }
+
+        return true;
+    }
+
+    std::size_t Connection::getBodyLength(const Message& message)
+    {
+        return static_cast<std::size_t>(std::strtoull(message.getField("length", "0").c_str(), nullptr, 10));
+    }
+
+#if defined(_WIN32)
+    bool Connection::open(const std::string& /* socketPath */)
+    {
+        return false;
+    }
+
+    void Connection::close()
+    {
+        fd_ = -1;
+    }
+
+    bool Connection::read(Message& /* message */)
+    {
+        return false;
+    }
+
+    bool Connection::write(const Message& /* message */)
+    {
+        return false;
+    }
+
+    bool Connection::fill()
+    {
+        return false;
+    }
+
+    bool Connection::receive()
+    {
+        return false;
+    }
+
+    void Connection::setTimeout(int /* seconds */)
+    {}
+
+    bool Connection::isSameUser() const
+    {
+        return false;
+    }
+
+#else
+    bool Connection::open(const std::string& socketPath)
+    {
+        close();
+
+        sockaddr_un address;
+        std::memset(&address, 0, sizeof(address));
+        address.sun_family = AF_UNIX;
+
+        if (socketPath.size() >= sizeof(address.sun_path))
+        {
+            return false;
+        }
+
+        std::memcpy(address.sun_path, socketPath.c_str(), socketPath.size() + 1);
+
+        fd_ = ::socket(AF_UNIX, SOCK_STREAM, 0);
+
+        if (fd_ < 0)
+        {
+            return false;
+        }
+
+        if (::connect(fd_, reinterpret_cast<sockaddr*>(&address), sizeof(address)) != 0)
+        {
+            close();
+            return false;
+        }
+
+        return true;
+    }
+
+    void Connection::close()
+    {
+        if (fd_ >= 0)
+        {
+            ::close(fd_);
+            fd_ = -1;
+        }
+
+        buffer_.clear();
+    }
+
+    bool Connection::read(Message& message)
+    {
+        std::size_t headerEnd = 0;
+
+        while (!readHeader(message, headerEnd))
+        {
+            if (buffer_.size() > MAX_HEADER_SIZE || !fill())
+            {
+                return false;
+            }
+        }
+
+        std::size_t length = getBodyLength(message);
+
+        if (length > maxBodySize_)
+        {
+            return false;
+        }
+
+        while (buffer_.size() - headerEnd < length)
+        {
+            if (!fill())
+            {
+                return false;
+            }
+        }
+
+        message.setBody(buffer_.substr(headerEnd, length));
+        buffer_.erase(0, headerEnd + length);
+
+        return true;
+    }
+
+    bool Connection::write(const Message& message)
+    {
+        std::string text = message.encode();
+        std::size_t written = 0;
+
+        while (written < text.size())
+        {
+            // a client which has gone away must not kill the server with SIGPIPE.
+            ssize_t count = ::send(fd_, text.data() + written, text.size() - written, MSG_NOSIGNAL);
+
+            if (count < 0)
+            {
+                if (errno == EINTR)
+                {
+                    continue;
+                }
+
+                return false;
+            }
+
+            written += static_cast<std::size_t>(count);
+        }
+
+        return true;
+    }
+
+    bool Connection::receive()
+    {
+        char chunk[64 * 1024];
+
+        while (true)
+        {
+            ssize_t count = ::recv(fd_, chunk, sizeof(chunk), MSG_DONTWAIT);
+
+            if (count < 0 && (errno == EAGAIN || errno == EWOULDBLOCK))
+            {
+                return true;
+            }
+
+            if (count < 0 && errno == EINTR)
+            {
+                continue;
+            }
+
+            if (count <= 0)
+            {
+                return false;
+            }
+
+            buffer_.append(chunk, static_cast<std::size_t>(count));
+
+            if (static_cast<std::size_t>(count) < sizeof(chunk))
+            {
+                return true;
+            }
+        }
+    }
+
+    void Connection::setTimeout(int seconds)
+    {
+        timeval timeout;
+        timeout.tv_sec = seconds;
+        timeout.tv_usec = 0;
+
+        ::setsockopt(fd_, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout));
+        ::setsockopt(fd_, SOL_SOCKET, SO_SNDTIMEO, &timeout, sizeof(timeout));
+    }
+
+    bool Connection::isSameUser() const
+    {
+#if defined(SO_PEERCRED)
+        ucred credentials;
+        socklen_t size = sizeof(credentials);
+
+        return ::getsockopt(fd_, SOL_SOCKET, SO_PEERCRED, &credentials, &size) == 0 && credentials.uid == ::geteuid();
+
+#else
+        uid_t uid = 0;
+        gid_t gid = 0;
+
+        return ::getpeereid(fd_, &uid, &gid) == 0 && uid == ::geteuid();
+#endif
+    }
+
+    bool Connection::fill()
+    {
+        char chunk[64 * 1024];
+
+        while (true)
+        {
+            ssize_t count = ::recv(fd_, chunk, sizeof(chunk), 0);
+
+            if (count < 0 && errno == EINTR)
+            {
+                continue;
+            }
+
+            if (count <= 0)
+            {
+                return false;
+            }
+
+            buffer_.append(chunk, static_cast<std::size_t>(count));
+            return true;
+        }
+    }
+#endif
+} // namespace MJava
@@ -0,0 +1,335 @@
+// THIS FILE IS PART OF MJava-Compiler PROJECT
+// simd.cpp - vectorized search in the source text
+
+// Created by Li Taiji 2026-10-17
+// Copyright (c) 2026 Li Taiji All rights reserved
+
+#include "simd.h"
+#include <cstring>
+
+#if (defined(__x86_64__) || defined(__i386__)) && (defined(__GNUC__) || defined(__clang__))
+    #define MJAVA_SIMD_X86 1
+    #include <immintrin.h>
+#endif
+
+namespace MJava
+{
+    namespace
+    {
+        using SearchFunction = std::size_t (*)(const char*, std::size_t, std::size_t);
+        using IndexFunction = void (*)(const char*, std::size_t, std::vector<std::uint32_t>&);
+
+        struct SearchFunctions
+        {
+            SearchFunction  skipWhitespace;
+            SearchFunction  findNewline;
+            SearchFunction  findBlockCommentEnd;
+            IndexFunction   appendLineStarts;
+            const char*     name;
+        };
+
+        inline bool isSpace(char c)
+        {
+            return c == ' ' || (c >= '\t' && c <= '\r');
+        }
+
+        std::size_t skipWhitespaceScalar(const char* data, std::size_t size, std::size_t offset)
+        {
+            while (offset < size && isSpace(data[offset]))
+            {
+                offset++;
+            }
+
+            return offset < size ? offset : size;
+        }
+
+        std::size_t findNewlineScalar(const char* data, std::size_t size, std::size_t offset)
+        {
+            if (offset >= size)
+            {
+                return size;
+            }
+
+            const void* found = std::memchr(data + offset, '\n', size - offset);
+
+            return found != nullptr ? static_cast<const char*>(found) - data : size;
+        }
+
+        std::size_t findBlockCommentEndScalar(const char* data, std::size_t size, std::size_t offset)
+        {
+            while (offset + 1 < size)
+            {
+                if (data[offset] == '*' && data[offset + 1] == '/')
+                {
+                    return offset;
+                }
+
+                offset++;
+            }
+
+            return size;
+        }
+
+        void appendLineStartsScalar(const char* data, std::size_t size, std::vector<std::uint32_t>& lineStarts)
+        {
+            for (std::size_t offset = findNewlineScalar(data, size, 0); offset < size;
+                 offset = findNewlineScalar(data, size, offset + 1))
+            {
+                lineStarts.push_back(static_cast<std::uint32_t>(offset + 1));
+            }
+        }
+
+#if defined(MJAVA_SIMD_X86)
+        // a byte is a space if it is ' ' or in ['\t', '\r']. bytes >= 0x80 are
+        // negative, so the signed compare keeps them out of the range.
+        __attribute__((target("sse2")))
+        inline __m128i spaceMask128(__m128i chars)
+        {
+            __m128i blank = _mm_cmpeq_epi8(chars, _mm_set1_epi8(' '));
+            __m128i control = _mm_and_si128(_mm_cmpgt_epi8(chars, _mm_set1_epi8('\t' - 1)),
+                                            _mm_cmplt_epi8(chars, _mm_set1_epi8('\r' + 1)));
+            return _mm_or_si128(blank, control);
+        }
+
+        __attribute__((target("sse2")))
+        std::size_t skipWhitespaceSSE2(const char* data, std::size_t size, std::size_t offset)
+        {
+            while (offset + 16 <= size)
+            {
+                __m128i chars = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + offset));
+                unsigned mask = ~static_cast<unsigned>(_mm_movemask_epi8(spaceMask128(chars))) & 0xFFFFu;
+
+                if (mask != 0)
+                {
+                    return offset + __builtin_ctz(mask);
+                }
+
+                offset += 16;
+            }
+
+            return skipWhitespaceScalar(data, size, offset);
+        }
+
+        __attribute__((target("sse2")))
+        std::size_t findNewlineSSE2(const char* data, std::size_t size, std::size_t offset)
+        {
+            __m128i newline = _mm_set1_epi8('\n');
+
+            while (offset + 16 <= size)
+            {
+                __m128i chars = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + offset));
+                unsigned mask = static_cast<unsigned>(_mm_movemask_epi8(_mm_cmpeq_epi8(chars, newline)));
+
+                if (mask != 0)
+                {
+                    return offset + __builtin_ctz(mask);
+                }
+
+                offset += 16;
+            }
+
+            return findNewlineScalar(data, size, offset);
+        }
+
+        // compare the chunk with '*' and the chunk one byte later with '/'.
+        __attribute__((target("sse2")))
+        std::size_t findBlockCommentEndSSE2(const char* data, std::size_t size, std::size_t offset)
+        {
+            __m128i star = _mm_set1_epi8('*');
+            __m128i slash = _mm_set1_epi8('/');
+
+            while (offset + 17 <= size)
+            {
+                __m128i first = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + offset));
+                __m128i second = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + offset + 1));
+                __m128i match = _mm_and_si128(_mm_cmpeq_epi8(first, star), _mm_cmpeq_epi8(second, slash));
+                unsigned mask = static_cast<unsigned>(_mm_movemask_epi8(match));
+
+                if (mask != 0)
+                {
+                    return offset + __builtin_ctz(mask);
+                }
+
+                offset += 16;
+            }
+
+            return findBlockCommentEndScalar(data, size, offset);
+        }
+
+        // every set bit of the mask is a '\n' at base + bit.
+        inline void appendMaskedLineStarts(std::size_t base, unsigned mask, std::vector<std::uint32_t>& lineStarts)
+        {
+            while (mask != 0)
+            {
+                lineStarts.push_back(static_cast<std::uint32_t>(base + __builtin_ctz(mask) + 1));
+                mask &= mask - 1;
+            }
+        }
+
+        __attribute__((target("sse2")))
+        void appendLineStartsSSE2(const char* data, std::size_t size, std::vector<std::uint32_t>& lineStarts)
+        {
+            __m128i newline = _mm_set1_epi8('\n');
+            std::size_t offset = 0;
+
+            for (; offset + 16 <= size; offset += 16)
+            {
+                __m128i chars = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + offset));
+                appendMaskedLineStarts(offset, static_cast<unsigned>(_mm_movemask_epi8(_mm_cmpeq_epi8(chars, newline))), lineStarts);
+            }
+
+            for (; offset < size; offset++)
+            {
+                if (data[offset] == '\n')
+                {
+                    lineStarts.push_back(static_cast<std::uint32_t>(offset + 1));
+                }
+            }
+        }
+
+        __attribute__((target("avx2")))
+        inline __m256i spaceMask256(__m256i chars)
+        {
+            __m256i blank = _mm256_cmpeq_epi8(chars, _mm256_set1_epi8(' '));
+            __m256i control = _mm256_and_si256(_mm256_cmpgt_epi8(chars, _mm256_set1_epi8('\t' - 1)),
+                                               _mm256_cmpgt_epi8(_mm256_set1_epi8('\r' + 1), chars));
+            return _mm256_or_si256(blank, control);
+        }
+
+        __attribute__((target("avx2")))
+        std::size_t skipWhitespaceAVX2(const char* data, std::size_t size, std::size_t offset)
+        {
+            while (offset + 32 <= size)
+            {
+                __m256i chars = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + offset));
+                unsigned mask = ~static_cast<unsigned>(_mm256_movemask_epi8(spaceMask256(chars)));
+
+                if (mask != 0)
+                {
+                    return offset + __builtin_ctz(mask);
+                }
+
+                offset += 32;
+            }
+
+            return skipWhitespaceSSE2(data, size, offset);
+        }
+
+        __attribute__((target("avx2")))
+        std::size_t findNewlineAVX2(const char* data, std::size_t size, std::size_t offset)
+        {
+            __m256i newline = _mm256_set1_epi8('\n');
+
+            while (offset + 32 <= size)
+            {
+                __m256i chars = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + offset));
+                unsigned mask = static_cast<unsigned>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(chars, newline)));
+
+                if (mask != 0)
+                {
+                    return offset + __builtin_ctz(mask);
+                }
+
+                offset += 32;
+            }
+
+            return findNewlineSSE2(data, size, offset);
+        }
+
+        __attribute__((target("avx2")))
+        std::size_t findBlockCommentEndAVX2(const char* data, std::size_t size, std::size_t offset)
+        {
+            __m256i star = _mm256_set1_epi8('*');
+            __m256i slash = _mm256_set1_epi8('/');
+
+            while (offset + 33 <= size)
+            {
+                __m256i first = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + offset));
+                __m256i second = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + offset + 1));
+                __m256i match = _mm256_and_si256(_mm256_cmpeq_epi8(first, star), _mm256_cmpeq_epi8(second, slash));
+                unsigned mask = static_cast<unsigned>(_mm256_movemask_epi8(match));
+
+                if (mask != 0)
+                {
+                    return offset + __builtin_ctz(mask);
+                }
+
+                offset += 32;
+            }
+
+            return findBlockCommentEndSSE2(data, size, offset);
+        }
+
+        __attribute__((target("avx2")))
+        void appendLineStartsAVX2(const char* data, std::size_t size, std::vector<std::uint32_t>& lineStarts)
+        {
+            __m256i newline = _mm256_set1_epi8('\n');
+            std::size_t offset = 0;
+
+            for (; offset + 32 <= size; offset += 32)
+            {
+                __m256i chars = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + offset));
+                appendMaskedLineStarts(offset, static_cast<unsigned>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(chars, newline))), lineStarts);
+            }
+
+            for (; offset < size; offset++)
+            {
+                if (data[offset] == '\n')
+                {
+                    lineStarts.push_back(static_cast<std::uint32_t>(offset + 1));
+                }
+            }
+        }
+#endif
+
+        SearchFunctions selectSearchFunctions()
+        {
+#if defined(MJAVA_SIMD_X86)
+            __builtin_cpu_init();
+
+            if (__builtin_cpu_supports("avx2"))
+            {
+                return {skipWhitespaceAVX2, findNewlineAVX2, findBlockCommentEndAVX2, appendLineStartsAVX2, "avx2"};
+            }
+
+            if (__builtin_cpu_supports("sse2"))
+            {
+                return {skipWhitespaceSSE2, findNewlineSSE2, findBlockCommentEndSSE2, appendLineStartsSSE2, "sse2"};
+            }
+#endif
+
+            return {skipWhitespaceScalar, findNewlineScalar, findBlockCommentEndScalar, appendLineStartsScalar, "scalar"};
+        }
+
+        const SearchFunctions& searchFunctions()
+        {
+            static const SearchFunctions functions = selectSearchFunctions();
+            return functions;
+        }
+    } // namespace
+
+    std::size_t skipWhitespace(const char* data, std::size_t size, std::size_t offset)
+    {
+        return searchFunctions().skipWhitespace(data, size, offset);
+    }
+
+    std::size_t findNewline(const char* data, std::size_t size, std::size_t offset)
+    {
+        return searchFunctions().findNewline(data, size, offset);
+    }
+
+    std::size_t findBlockCommentEnd(const char* data, std::size_t size, std::size_t offset)
+    {
+        return searchFunctions().findBlockCommentEnd(data, size, offset);
+    }
+
+    void appendLineStarts(const char* data, std::size_t size, std::vector<std::uint32_t>& lineStarts)
+    {
+        searchFunctions().appendLineStarts(data, size, lineStarts);
+    }
+
+    const char* simdLevelName()
+    {
+        return searchFunctions().name;
+    }
+} // namespace MJava
@@ -0,0 +1,187 @@
+// THIS FILE IS PART OF MJava-Compiler PROJECT
+// sourcebuffer.cpp - read-only view of the whole source file
+
+// Created by Li Taiji 2026-10-17
+// Copyright (c) 2026 Li Taiji All rights reserved
+
+#include "sourcebuffer.h"
+
+#if defined(_WIN32)
+    #include <fstream>
+    #include <iterator>
+#else
+    #include <cerrno>
+    #include <fcntl.h>
+    #include <sys/mman.h>
+    #include <sys/stat.h>
+    #include <unistd.h>
+#endif
+
+namespace MJava
+{
+    SourceBuffer::SourceBuffer() : data_(nullptr), size_(0), mapped_(false)
+    {}
+
+    SourceBuffer::~SourceBuffer()
+    {
+        close();
+    }
+
+    SourceBuffer::SourceBuffer(SourceBuffer&& other) noexcept
+        : data_(other.data_), size_(other.size_), mapped_(other.mapped_),
+          storage_(std::move(other.storage_))
+    {
+        other.data_ = nullptr;
+        other.size_ = 0;
+        other.mapped_ = false;
+    }
+
+    SourceBuffer& SourceBuffer::operator=(SourceBuffer&& other) noexcept
+    {
+        if (this != &other)
+        {
+            close();
+            data_ = other.data_;
+            size_ = other.size_;
+            mapped_ = other.mapped_;
+            storage_ = std::move(other.storage_);
+            other.data_ = nullptr;
+            other.size_ = 0;
+            other.mapped_ = false;
+        }
+
+        return *this;
+    }
+
+    void SourceBuffer::view(std::string_view text)
+    {
+        close();
+
+        data_ = text.data();
+        size_ = text.size();
+    }
+
+#if defined(_WIN32)
+    bool SourceBuffer::open(const std::string& fileName)
+    {
+        close();
+
+        std::ifstream input(fileName, std::ios::in | std::ios::binary);
+
+        if (input.fail())
+        {
+            return false;
+        }
+
+        storage_.assign(std::istreambuf_iterator<char>(input), std::istreambuf_iterator<char>());
+        data_ = storage_.data();
+        size_ = storage_.size();
+
+        return true;
+    }
+
+    bool SourceBuffer::readAll(int /* fd */)
+    {
+        return false;
+    }
+
+    void SourceBuffer::close()
+    {
+        storage_.clear();
+        data_ = nullptr;
+        size_ = 0;
+        mapped_ = false;
+    }
+
+#else
+    bool SourceBuffer::open(const std::string& fileName)
+    {
+        close();
+
+        int fd = ::open(fileName.c_str(), O_RDONLY);
+
+        if (fd < 0)
+        {
+            return false;
+        }
+
+        struct stat status;
+        bool succeeded = false;
+
+        if (::fstat(fd, &status) == 0 && S_ISREG(status.st_mode) && status.st_size > 0)
+        {
+            void* address = ::mmap(nullptr, static_cast<std::size_t>(status.st_size),
+                                   PROT_READ, MAP_PRIVATE, fd, 0);
+
+            if (address != MAP_FAILED)
+            {
+                // the scanner reads the file from the beginning to the end only once.
+                ::madvise(address, static_cast<std::size_t>(status.st_size), MADV_SEQUENTIAL);
+                data_ = static_cast<const char*>(address);
+                size_ = static_cast<std::size_t>(status.st_size);
+                mapped_ = true;
+                succeeded = true;
+            }
+        }
+
+        // empty files, pipes and devices can not be mapped, read them instead.
+        if (!succeeded)
+        {
+            succeeded = readAll(fd);
+        }
+
+        ::close(fd);
+
+        return succeeded;
+    }
+
+    bool SourceBuffer::readAll(int fd)
+    {
+        const std::size_t chunkSize = 64 * 1024;
+        std::size_t length = 0;
+
+        while (true)
+        {
+            storage_.resize(length + chunkSize);
+            ssize_t count = ::read(fd, storage_.data() + length, chunkSize);
+
+            if (count < 0)
+            {
+                if (errno == EINTR)
+                {
+                    continue;
+                }
+
+                storage_.clear();
+                return false;
+            }
+
+            if (count == 0)
+            {
+                break;
+            }
+
+            length += static_cast<std::size_t>(count);
+        }
+
+        storage_.resize(length);
+        data_ = storage_.data();
+        size_ = length;
+
+        return true;
+    }
+
+    void SourceBuffer::close()
+    {
+        if (mapped_)
+        {
+            ::munmap(const_cast<char*>(data_), size_);
+        }
+
+        storage_.clear();
+        data_ = nullptr;
+        size_ = 0;
+        mapped_ = false;
+    }
+#endif
+} // namespace MJava
@@ -0,0 +1,211 @@
+// THIS FILE IS PART OF MJava-Compiler PROJECT
+// sourcemanager.cpp - table of source files and their line index
+
+// Created by Li Taiji 2026-10-17
+// Copyright (c) 2026 Li Taiji All rights reserved
+
+#include "sourcemanager.h"
+#include "simd.h"
+#include <algorithm>
+#include <utility>
+
+namespace MJava
+{
+    SourceManager::SourceManager()
+    {
+        // file 0, locations without file.
+        files_.emplace_back(new SourceFile{"", nullptr, 0, nullptr, 1});
+    }
+
+    SourceManager& SourceManager::instance()
+    {
+        static SourceManager manager;
+        return manager;
+    }
+
+    FileID SourceManager::addFile(const std::string& fileName, const char* data, std::size_t size)
+    {
+        std::unique_lock<std::shared_mutex> lock(mutex_);
+        std::unique_ptr<SourceFile> file(new SourceFile{fileName, data, size, nullptr, 1});
+
+        if (!freeIds_.empty())
+        {
+            FileID fileId = freeIds_.back();
+            freeIds_.pop_back();
+            files_[fileId] = std::move(file);
+            return fileId;
+        }
+
+        files_.push_back(std::move(file));
+
+        return static_cast<FileID>(files_.size() - 1);
+    }
+
+    void SourceManager::removeFile(FileID fileId)
+    {
+        std::unique_lock<std::shared_mutex> lock(mutex_);
+        SourceFile* file = getFile(fileId);
+
+        if (fileId == 0 || file == nullptr)
+        {
+            return;
+        }
+
+        // the locations of the trees still holding the file are printed
+        // from the line index, the text is not read any more.
+        if (file->references > 1)
+        {
+            if (!file->lineStarts && file->data != nullptr)
+            {
+                file->lineStarts = makeLineIndex(file->data, file->size);
+            }
+
+            file->data = nullptr;
+            file->size = 0;
+        }
+
+        release(fileId);
+    }
+
+    void SourceManager::retainFile(FileID fileId)
+    {
+        std::unique_lock<std::shared_mutex> lock(mutex_);
+        SourceFile* file = getFile(fileId);
+
+        if (fileId != 0 && file != nullptr)
+        {
+            ++file->references;
+        }
+    }
+
+    void SourceManager::releaseFile(FileID fileId)
+    {
+        std::unique_lock<std::shared_mutex> lock(mutex_);
+        release(fileId);
+    }
+
+    void SourceManager::release(FileID fileId)
+    {
+        SourceFile* file = getFile(fileId);
+
+        if (fileId != 0 && file != nullptr && --file->references == 0)
+        {
+            files_[fileId].reset();
+            freeIds_.push_back(fileId);
+        }
+    }
+
+    void SourceManager::updateFile(FileID fileId, const char* data, std::size_t size)
+    {
+        std::unique_lock<std::shared_mutex> lock(mutex_);
+        SourceFile* file = getFile(fileId);
+
+        if (file != nullptr)
+        {
+            file->data = data;
+            file->size = size;
+            file->lineStarts.reset();
+        }
+    }
+
+    SourceManager::SourceFile* SourceManager::getFile(FileID fileId) const
+    {
+        if (fileId < files_.size())
+        {
+            return files_[fileId].get();
+        }
+
+        return nullptr;
+    }
+
+    std::string SourceManager::getFileName(FileID fileId) const
+    {
+        std::shared_lock<std::shared_mutex> lock(mutex_);
+        SourceFile* file = getFile(fileId);
+
+        return file != nullptr ? file->name : std::string();
+    }
+
+    void SourceManager::buildLineIndex(FileID fileId) const
+    {
+        const char* data = nullptr;
+        std::size_t size = 0;
+
+        {
+            std::shared_lock<std::shared_mutex> lock(mutex_);
+            SourceFile* file = getFile(fileId);
+
+            if (file == nullptr || file->data == nullptr || file->lineStarts)
+            {
+                return;
+            }
+
+            data = file->data;
+            size = file->size;
+        }
+
+        std::unique_ptr<const LineIndex> lineStarts = makeLineIndex(data, size);
+
+        std::unique_lock<std::shared_mutex> lock(mutex_);
+        SourceFile* file = getFile(fileId);
+
+        // somebody may have built it or changed the text meanwhile.
+        if (file != nullptr && !file->lineStarts && file->data == data && file->size == size)
+        {
+            file->lineStarts = std::move(lineStarts);
+        }
+    }
+
+    std::unique_ptr<const SourceManager::LineIndex> SourceManager::makeLineIndex(const char* data, std::size_t size)
+    {
+        std::unique_ptr<LineIndex> lineStarts(new LineIndex(1, 0));
+        appendLineStarts(data, size, *lineStarts);
+        return std::unique_ptr<const LineIndex>(std::move(lineStarts));
+    }
+
+    void SourceManager::getLineAndColumn(FileID fileId, std::uint32_t offset,
+                                         int& line, int& column) const
+    {
+        // the position just after the char, it wraps to 0 for offset -1.
+        std::uint32_t position = offset + 1;
+
+        for (;;)
+        {
+            {
+                std::shared_lock<std::shared_mutex> lock(mutex_);
+                SourceFile* file = getFile(fileId);
+
+                if (file == nullptr || (file->data == nullptr && !file->lineStarts))
+                {
+                    line = 1;
+                    column = static_cast<int>(position);
+                    return;
+                }
+
+                if (file->lineStarts)
+                {
+                    const LineIndex& lineStarts = *file->lineStarts;
+                    // the last line which starts at or before the position.
+                    auto iter = std::upper_bound(lineStarts.begin(), lineStarts.end(), position);
+
+                    line = static_cast<int>(iter - lineStarts.begin());
+                    column = static_cast<int>(position - *(iter - 1));
+                    return;
+                }
+            }
+
+            // the first query of the file builds the index, then it looks again.
+            buildLineIndex(fileId);
+        }
+    }
+
+    SourceFileReference::SourceFileReference(FileID fileId) : fileId_(fileId)
+    {
+        SourceManager::instance().retainFile(fileId_);
+    }
+
+    SourceFileReference::~SourceFileReference()
+    {
+        SourceManager::instance().releaseFile(fileId_);
+    }
+} // namespace MJava
\ No newline at end of file
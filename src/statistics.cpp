@@ -0,0 +1,579 @@
+// THIS FILE IS PART OF MJava-Compiler PROJECT
+// statistics.cpp - time, allocations and sizes of every compile phase
+
+// Created by Li Taiji 2026-10-17
+// Copyright (c) 2026 Li Taiji All rights reserved
+
+#include "jsonwriter.h"
+#include "statistics.h"
+#include <algorithm>
+#include <atomic>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <ctime>
+#include <new>
+
+#if !defined(_WIN32)
+    #include <sys/resource.h>
+    #include <time.h>
+#endif
+
+#if defined(__linux__)
+    #include <cerrno>
+    #include <linux/perf_event.h>
+    #include <sys/syscall.h>
+    #include <unistd.h>
+#endif
+
+namespace MJava
+{
+    namespace
+    {
+        // plain thread local integers, an allocation costs two additions more.
+        thread_local std::uint64_t allocationCount = 0;
+        thread_local std::uint64_t allocationBytes = 0;
+
+        // small numbers for the threads of the trace, in the order they first finish a phase.
+        std::atomic<unsigned> threadCount(0);
+        thread_local unsigned threadNumber = 0;
+
+        unsigned getThreadNumber()
+        {
+            if (threadNumber == 0)
+            {
+                threadNumber = ++threadCount;
+            }
+
+            return threadNumber;
+        }
+
+        double getThreadCPUSeconds()
+        {
+#if defined(_WIN32)
+            // the whole process, there is no cheap time of one thread.
+            return static_cast<double>(std::clock()) / CLOCKS_PER_SEC;
+
+#else
+            timespec time;
+            clock_gettime(CLOCK_THREAD_CPUTIME_ID, &time);
+            return static_cast<double>(time.tv_sec) + static_cast<double>(time.tv_nsec) / 1e9;
+#endif
+        }
+
+#if defined(__linux__)
+        // the perf_event_open counters of one thread, opened when the thread
+        // first takes a sample and closed when it ends.
+        class PerfEvents
+        {
+          public:
+            PerfEvents()
+            {
+                for (std::size_t i = 0; i < PERF_COUNTER_COUNT; i++)
+                {
+                    fds_[i] = open(static_cast<PerfCounter>(i));
+                    errors_[i] = fds_[i] < 0 ? errno : 0;
+                }
+            }
+
+            ~PerfEvents()
+            {
+                for (int fd : fds_)
+                {
+                    if (fd >= 0)
+                    {
+                        ::close(fd);
+                    }
+                }
+            }
+
+            PerfEvents(const PerfEvents&) = delete;
+            PerfEvents& operator=(const PerfEvents&) = delete;
+
+            // zero for a counter which could not be opened.
+            std::uint64_t read(std::size_t counter) const
+            {
+                // the value, and the times the counter was enabled and running.
+                std::uint64_t values[3];
+
+                if (fds_[counter] < 0 || ::read(fds_[counter], values, sizeof(values)) != sizeof(values))
+                {
+                    return 0;
+                }
+
+                // the kernel shares the hardware counters out in turns when
+                // there are more events than counters.
+                if (values[2] != 0 && values[2] < values[1])
+                {
+                    return static_cast<std::uint64_t>(static_cast<double>(values[0]) * values[1] / values[2]);
+                }
+
+                return values[0];
+            }
+
+            int getError(std::size_t counter) const
+            {
+                return errors_[counter];
+            }
+
+          private:
+            static int open(PerfCounter counter)
+            {
+                perf_event_attr attribute;
+                std::memset(&attribute, 0, sizeof(attribute));
+                attribute.size = sizeof(attribute);
+                attribute.type = PERF_TYPE_HARDWARE;
+                // user mode only, which needs no privileges with the default perf_event_paranoid.
+                attribute.exclude_kernel = 1;
+                attribute.exclude_hv = 1;
+                attribute.read_format = PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+
+                switch (counter)
+                {
+                    case PerfCounter::CYCLES:
+                        attribute.config = PERF_COUNT_HW_CPU_CYCLES;
+                        break;
+
+                    case PerfCounter::INSTRUCTIONS:
+                        attribute.config = PERF_COUNT_HW_INSTRUCTIONS;
+                        break;
+
+                    case PerfCounter::BRANCH_MISSES:
+                        attribute.config = PERF_COUNT_HW_BRANCH_MISSES;
+                        break;
+
+                    case PerfCounter::L1D_MISSES:
+                        attribute.type = PERF_TYPE_HW_CACHE;
+                        attribute.config = PERF_COUNT_HW_CACHE_L1D | (PERF_COUNT_HW_CACHE_OP_READ << 8) |
+                                           (PERF_COUNT_HW_CACHE_RESULT_MISS << 16);
+                        break;
+
+                    case PerfCounter::LLC_MISSES:
+                        attribute.config = PERF_COUNT_HW_CACHE_MISSES;
+                        break;
+
+                    default:
+                        attribute.type = PERF_TYPE_SOFTWARE;
+                        attribute.config = PERF_COUNT_SW_PAGE_FAULTS;
+                        break;
+                }
+
+                // this thread, on any processor.
+                return static_cast<int>(::syscall(SYS_perf_event_open, &attribute, 0, -1, -1, 0));
+            }
+
+          private:
+            int         fds_[PERF_COUNTER_COUNT];
+            int         errors_[PERF_COUNTER_COUNT];
+        };
+
+        const PerfEvents& getPerfEvents()
+        {
+            static thread_local PerfEvents events;
+            return events;
+        }
+#endif
+
+        std::uint64_t getPeakKilobytes()
+        {
+#if defined(_WIN32)
+            return 0;
+
+#else
+            rusage usage;
+            getrusage(RUSAGE_SELF, &usage);
+            return static_cast<std::uint64_t>(usage.ru_maxrss);
+#endif
+        }
+    } // namespace
+
+    AllocationCounters getAllocationCounters()
+    {
+        return AllocationCounters{allocationCount, allocationBytes};
+    }
+
+    CompileStatistics::CompileStatistics(bool trace, bool perfCounters)
+        : trace_(trace), perfCounters_(perfCounters), perfAvailable_(),
+          startTime_(std::chrono::steady_clock::now()), totals_()
+    {
+        if (!perfCounters_)
+        {
+            return;
+        }
+
+#if defined(__linux__)
+        // the counters this thread can open, the others can open the same.
+        const PerfEvents& events = getPerfEvents();
+
+        for (std::size_t i = 0; i < PERF_COUNTER_COUNT; i++)
+        {
+            perfAvailable_[i] = events.getError(i) == 0;
+
+            if (!perfAvailable_[i] && perfError_.empty())
+            {
+                perfError_ = std::strerror(events.getError(i));
+            }
+        }
+
+#else
+        perfError_ = "perf_event_open is only on Linux";
+#endif
+    }
+
+    CompileStatistics::Sample CompileStatistics::takeSample() const
+    {
+        Sample sample{std::chrono::steady_clock::now(), getThreadCPUSeconds(), getAllocationCounters(), getPeakKilobytes(), {}};
+
+#if defined(__linux__)
+        if (perfCounters_)
+        {
+            const PerfEvents& events = getPerfEvents();
+
+            for (std::size_t i = 0; i < PERF_COUNTER_COUNT; i++)
+            {
+                sample.perfCounters[i] = perfAvailable_[i] ? events.read(i) : 0;
+            }
+        }
+#endif
+
+        return sample;
+    }
+
+    void CompileStatistics::add(Phase phase, const std::string& file, const Sample& start, const Sample& stop,
+                                std::uint64_t tokens, std::uint64_t nodes)
+    {
+        double wallSeconds = std::chrono::duration<double>(stop.wallTime - start.wallTime).count();
+        std::uint64_t allocations = stop.allocations.count - start.allocations.count;
+        std::uint64_t allocatedBytes = stop.allocations.bytes - start.allocations.bytes;
+        unsigned thread = getThreadNumber();
+
+        std::lock_guard<std::mutex> lock(mutex_);
+        Totals& totals = totals_[static_cast<std::size_t>(phase)];
+        totals.files++;
+        totals.wallSeconds += wallSeconds;
+        totals.cpuSeconds += stop.cpuSeconds - start.cpuSeconds;
+        totals.allocations += allocations;
+        totals.allocatedBytes += allocatedBytes;
+        totals.tokens += tokens;
+        totals.nodes += nodes;
+        totals.peakKilobytes = std::max(totals.peakKilobytes, stop.peakKilobytes);
+
+        std::uint64_t perfCounters[PERF_COUNTER_COUNT];
+
+        for (std::size_t i = 0; i < PERF_COUNTER_COUNT; i++)
+        {
+            // a thread which could not open a counter reads zero at both ends.
+            perfCounters[i] = stop.perfCounters[i] >= start.perfCounters[i] ? stop.perfCounters[i] - start.perfCounters[i] : 0;
+            totals.perfCounters[i] += perfCounters[i];
+        }
+
+        if (trace_)
+        {
+            double startMicroseconds = std::chrono::duration<double, std::micro>(start.wallTime - startTime_).count();
+            events_.push_back(Event{phase, file, thread, startMicroseconds, wallSeconds * 1e6,
+                                    allocations, allocatedBytes, tokens, nodes, {}});
+            std::memcpy(events_.back().perfCounters, perfCounters, sizeof(perfCounters));
+        }
+    }
+
+    CompileStatistics::Totals CompileStatistics::getTotals(Phase phase) const
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return totals_[static_cast<std::size_t>(phase)];
+    }
+
+    const char* CompileStatistics::getPhaseName(Phase phase)
+    {
+        switch (phase)
+        {
+            case Phase::COMPILE:
+                return "compile";
+
+            case Phase::SCAN:
+                return "scan";
+
+            case Phase::PARSE:
+                return "parse";
+
+            case Phase::SCAN_AND_PARSE:
+                return "scan+parse";
+
+            case Phase::SCAN_AND_WRITE:
+                return "scan+write";
+
+            case Phase::WRITE:
+                return "write";
+
+            default:
+                return "unknown";
+        }
+    }
+
+    const char* CompileStatistics::getPerfCounterName(PerfCounter counter)
+    {
+        switch (counter)
+        {
+            case PerfCounter::CYCLES:
+                return "cycles";
+
+            case PerfCounter::INSTRUCTIONS:
+                return "instructions";
+
+            case PerfCounter::BRANCH_MISSES:
+                return "branch-misses";
+
+            case PerfCounter::L1D_MISSES:
+                return "L1-dcache-load-misses";
+
+            case PerfCounter::LLC_MISSES:
+                return "LLC-misses";
+
+            case PerfCounter::PAGE_FAULTS:
+                return "page-faults";
+
+            default:
+                return "unknown";
+        }
+    }
+
+    bool CompileStatistics::isPerfCounterAvailable(PerfCounter counter) const
+    {
+        return perfAvailable_[static_cast<std::size_t>(counter)];
+    }
+
+    void CompileStatistics::print(std::ostream& out) const
+    {
+        double runSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - startTime_).count();
+        char line[256];
+
+        std::snprintf(line, sizeof(line), "%-12s %6s %10s %10s %12s %14s %10s %10s %10s\n",
+                      "Phase", "Files", "Wall ms", "CPU ms", "Allocations", "Alloc bytes", "Tokens", "Nodes", "Peak KB");
+        out << line;
+
+        for (std::size_t i = 0; i < static_cast<std::size_t>(Phase::PHASE_COUNT); i++)
+        {
+            Totals totals = getTotals(static_cast<Phase>(i));
+
+            if (totals.files == 0)
+            {
+                continue;
+            }
+
+            std::snprintf(line, sizeof(line), "%-12s %6zu %10.2f %10.2f %12llu %14llu %10llu %10llu %10llu\n",
+                          getPhaseName(static_cast<Phase>(i)), totals.files,
+                          totals.wallSeconds * 1000, totals.cpuSeconds * 1000,
+                          static_cast<unsigned long long>(totals.allocations),
+                          static_cast<unsigned long long>(totals.allocatedBytes),
+                          static_cast<unsigned long long>(totals.tokens),
+                          static_cast<unsigned long long>(totals.nodes),
+                          static_cast<unsigned long long>(totals.peakKilobytes));
+            out << line;
+        }
+
+        std::snprintf(line, sizeof(line), "Run: %.2f ms wall, peak resident set %llu KB.\n",
+                      runSeconds * 1000, static_cast<unsigned long long>(getPeakKilobytes()));
+        out << line;
+
+        if (perfCounters_)
+        {
+            printPerfCounters(out);
+        }
+    }
+
+    void CompileStatistics::printPerfCounters(std::ostream& out) const
+    {
+        const char* headers[PERF_COUNTER_COUNT] = {"Cycles", "Instructions", "Branch misses",
+                                                   "L1D misses", "LLC misses", "Page faults"};
+        char cell[32];
+
+        out << "\n";
+        std::snprintf(cell, sizeof(cell), "%-12s", "Phase");
+        out << cell;
+
+        for (const char* header : headers)
+        {
+            std::snprintf(cell, sizeof(cell), " %14s", header);
+            out << cell;
+        }
+
+        out << "    IPC\n";
+
+        for (std::size_t i = 0; i < static_cast<std::size_t>(Phase::PHASE_COUNT); i++)
+        {
+            Totals totals = getTotals(static_cast<Phase>(i));
+
+            if (totals.files == 0)
+            {
+                continue;
+            }
+
+            std::snprintf(cell, sizeof(cell), "%-12s", getPhaseName(static_cast<Phase>(i)));
+            out << cell;
+
+            for (std::size_t counter = 0; counter < PERF_COUNTER_COUNT; counter++)
+            {
+                if (perfAvailable_[counter])
+                {
+                    std::snprintf(cell, sizeof(cell), " %14llu", static_cast<unsigned long long>(totals.perfCounters[counter]));
+                }
+                else
+                {
+                    std::snprintf(cell, sizeof(cell), " %14s", "-");
+                }
+
+                out << cell;
+            }
+
+            std::uint64_t cycles = totals.perfCounters[static_cast<std::size_t>(PerfCounter::CYCLES)];
+            std::uint64_t instructions = totals.perfCounters[static_cast<std::size_t>(PerfCounter::INSTRUCTIONS)];
+
+            if (perfAvailable_[static_cast<std::size_t>(PerfCounter::CYCLES)] &&
+                perfAvailable_[static_cast<std::size_t>(PerfCounter::INSTRUCTIONS)] && cycles != 0)
+            {
+                std::snprintf(cell, sizeof(cell), " %6.2f\n", static_cast<double>(instructions) / static_cast<double>(cycles));
+            }
+            else
+            {
+                std::snprintf(cell, sizeof(cell), " %6s\n", "-");
+            }
+
+            out << cell;
+        }
+
+        if (!perfError_.empty())
+        {
+            out << "The counters shown as - can not be read here: " << perfError_ << ".\n";
+        }
+    }
+
+    void CompileStatistics::writeTrace(std::ostream& out) const
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        JSONWriter writer(out, false);
+
+        writer.beginObject();
+        writer.key("displayTimeUnit");
+        writer.value("ms");
+        writer.key("traceEvents");
+        writer.beginArray();
+
+        for (const Event& event : events_)
+        {
+            writer.beginObject();
+            writer.key("name");
+            writer.value(getPhaseName(event.phase));
+            writer.key("cat");
+            writer.value("MJava");
+            writer.key("ph");
+            writer.value("X");
+            writer.key("ts");
+            writer.value(event.startMicroseconds);
+            writer.key("dur");
+            writer.value(event.durationMicroseconds);
+            writer.key("pid");
+            writer.value(1);
+            writer.key("tid");
+            writer.value(static_cast<int>(event.thread));
+            writer.key("args");
+            writer.beginObject();
+            writer.key("file");
+            writer.value(event.file);
+            writer.key("allocations");
+            writer.value(event.allocations);
+            writer.key("allocatedBytes");
+            writer.value(event.allocatedBytes);
+            writer.key("tokens");
+            writer.value(event.tokens);
+            writer.key("nodes");
+            writer.value(event.nodes);
+
+            for (std::size_t counter = 0; counter < PERF_COUNTER_COUNT; counter++)
+            {
+                if (perfAvailable_[counter])
+                {
+                    writer.key(getPerfCounterName(static_cast<PerfCounter>(counter)));
+                    writer.value(event.perfCounters[counter]);
+                }
+            }
+
+            writer.endObject();
+            writer.endObject();
+        }
+
+        writer.endArray();
+        writer.endObject();
+        writer.flush();
+    }
+
+    PhaseTimer::PhaseTimer(CompileStatistics* statistics, CompileStatistics::Phase phase, const std::string& file)
+        : statistics_(statistics), phase_(phase), file_(file), stopped_(false),
+          start_(statistics != nullptr ? statistics->takeSample() : CompileStatistics::Sample()),
+          stop_(), tokens_(0), nodes_(0)
+    {}
+
+    PhaseTimer::~PhaseTimer()
+    {
+        if (statistics_ != nullptr)
+        {
+            stop();
+            statistics_->add(phase_, file_, start_, stop_, tokens_, nodes_);
+        }
+    }
+
+    void PhaseTimer::stop()
+    {
+        if (statistics_ != nullptr && !stopped_)
+        {
+            stop_ = statistics_->takeSample();
+            stopped_ = true;
+        }
+    }
+
+    void PhaseTimer::setSizes(std::uint64_t tokens, std::uint64_t nodes)
+    {
+        tokens_ = tokens;
+        nodes_ = nodes;
+    }
+} // namespace MJava
+
+// every allocation of the program is counted for the statistics. the memory
+// still comes from malloc.
+void* operator new(std::size_t size)
+{
+    MJava::allocationCount++;
+    MJava::allocationBytes += size;
+
+    void* pointer = std::malloc(size != 0 ? size : 1);
+
+    if (pointer == nullptr)
+    {
+        throw std::bad_alloc();
+    }
+
+    return pointer;
+}
+
+void* operator new[](std::size_t size)
+{
+    return operator new(size);
+}
+
+void operator delete(void* pointer) noexcept
+{
+    std::free(pointer);
+}
+
+void operator delete[](void* pointer) noexcept
+{
+    std::free(pointer);
+}
+
+void operator delete(void* pointer, std::size_t) noexcept
+{
+    std::free(pointer);
+}
+
+void operator delete[](void* pointer, std::size_t) noexcept
+{
+    std::free(pointer);
+}
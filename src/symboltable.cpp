@@ -0,0 +1,57 @@
+// THIS FILE IS PART OF MJava-Compiler PROJECT
+// symboltable.cpp - interned identifiers and literals
+
+// Created by Li Taiji 2026-10-17
+// Copyright (c) 2026 Li Taiji All rights reserved
+
+#include "symboltable.h"
+#include <cstring>
+
+namespace MJava
+{
+    SymbolTable::SymbolTable() : current_(nullptr), available_(0)
+    {
+        // symbol 0 is the empty string.
+        names_.push_back(std::string_view());
+        symbols_.emplace(std::string_view(), 0);
+    }
+
+    Symbol SymbolTable::intern(std::string_view name)
+    {
+        auto iter = symbols_.find(name);
+
+        if (iter != symbols_.end())
+        {
+            return iter->second;
+        }
+
+        std::string_view stored = store(name);
+        Symbol symbol = static_cast<Symbol>(names_.size());
+
+        names_.push_back(stored);
+        symbols_.emplace(stored, symbol);
+
+        return symbol;
+    }
+
+    std::string_view SymbolTable::store(std::string_view name)
+    {
+        if (name.size() > available_)
+        {
+            // a very long literal gets a chunk of its own.
+            std::size_t size = name.size() > CHUNK_SIZE ? name.size() : CHUNK_SIZE;
+
+            chunks_.emplace_back(new char[size]);
+            current_ = chunks_.back().get();
+            available_ = size;
+        }
+
+        std::memcpy(current_, name.data(), name.size());
+        std::string_view stored(current_, name.size());
+
+        current_ += name.size();
+        available_ -= name.size();
+
+        return stored;
+    }
+} // namespace MJava
@@ -0,0 +1,94 @@
+// THIS FILE IS PART OF MJava-Compiler PROJECT
+// threadpool.cpp - fixed number of worker threads
+
+// Created by Li Taiji 2026-10-17
+// Copyright (c) 2026 Li Taiji All rights reserved
+
+#include "threadpool.h"
+#include <utility>
+
+namespace MJava
+{
+    ThreadPool::ThreadPool(std::size_t threadCount) : running_(0), stopping_(false)
+    {
+        if (threadCount == 0)
+        {
+            threadCount = 1;
+        }
+
+        workers_.reserve(threadCount);
+
+        for (std::size_t i = 0; i < threadCount; i++)
+        {
+            workers_.emplace_back(&ThreadPool::workerLoop, this);
+        }
+    }
+
+    ThreadPool::~ThreadPool()
+    {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            stopping_ = true;
+        }
+
+        taskReady_.notify_all();
+
+        for (std::thread& worker : workers_)
+        {
+            worker.join();
+        }
+    }
+
+    void ThreadPool::submit(std::function<void()> task)
+    {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            tasks_.push_back(std::move(task));
+        }
+
+        taskReady_.notify_one();
+    }
+
+    void ThreadPool::wait()
+    {
+        std::unique_lock<std::mutex> lock(mutex_);
+        allDone_.wait(lock, [this] { return tasks_.empty() && running_ == 0; });
+    }
+
+    std::size_t ThreadPool::defaultThreadCount()
+    {
+        unsigned int count = std::thread::hardware_concurrency();
+        return count == 0 ? 1 : count;
+    }
+
+    void ThreadPool::workerLoop()
+    {
+        std::unique_lock<std::mutex> lock(mutex_);
+
+        for (;;)
+        {
+            taskReady_.wait(lock, [this] { return stopping_ || !tasks_.empty(); });
+
+            // the queue is drained before the threads stop.
+            if (tasks_.empty())
+            {
+                return;
+            }
+
+            std::function<void()> task = std::move(tasks_.front());
+            tasks_.pop_front();
+            ++running_;
+
+            lock.unlock();
+            task();
+            lock.lock();
+
+            --running_;
+
+            if (tasks_.empty() && running_ == 0)
+            {
+                allDone_.notify_all();
+            }
+        }
+    }
+} // namespace MJava
@@ -9,48 +9,63 @@
 namespace MJava
 {
 
-    TokenLocation::TokenLocation(const std::string& fileName, int line, int column)
-        : fileName_(fileName), line_(line), column_(column)
+    TokenLocation::TokenLocation(FileID fileId, std::uint32_t offset)
+        : fileId_(fileId), offset_(offset)
     {}
 
-    TokenLocation::TokenLocation() : fileName_(""), line_(1), column_(0)
+    // no file, line 1 and column 0.
+    TokenLocation::TokenLocation() : fileId_(0), offset_(static_cast<std::uint32_t>(-1))
     {}
 
+    int TokenLocation::getLine() const
+    {
+        int line = 0;
+        int column = 0;
+        SourceManager::instance().getLineAndColumn(fileId_, offset_, line, column);
+        return line;
+    }
+
+    int TokenLocation::getColumn() const
+    {
+        int line = 0;
+        int column = 0;
+        SourceManager::instance().getLineAndColumn(fileId_, offset_, line, column);
+        return column;
+    }
 
     std::string TokenLocation::toString() const
     {
-        return fileName_ + ":" + std::to_string(line_) + ":" + std::to_string(column_) + ":";
+        int line = 0;
+        int column = 0;
+        SourceManager& sourceManager = SourceManager::instance();
+        sourceManager.getLineAndColumn(fileId_, offset_, line, column);
+
+        return sourceManager.getFileName(fileId_) + ":" + std::to_string(line) + ":" + std::to_string(column) + ":";
     }
 
     // End TokenLocation
 
 
-    Token::Token() : type_(TokenType::UNKNOWN), value_(TokenValue::UNRESERVED),
-        location_(std::string(""), 0, 0), name_(""), symbolPrecedence_(-1)
-    {}
-
-    Token::Token(TokenType type, TokenValue value, const TokenLocation& location,
-                 const std::string& name, int symbolPrecedence)
-        : type_(type), value_(value), location_(location), name_(name),
-          symbolPrecedence_(symbolPrecedence)
+    Token::Token() : location_(), name_(""), realValue_(0.0),
+        symbolPrecedence_(-1), type_(TokenType::UNKNOWN), value_(TokenValue::UNRESERVED)
     {}
 
     Token::Token(TokenType type, TokenValue value, const TokenLocation& location,
-                 const std::string& strValue, const std::string& name)
-        : type_(type), value_(value), location_(location),
-          name_(name), symbolPrecedence_(-1), strValue_(strValue)
+                 std::string_view name, int symbolPrecedence)
+        : location_(location), name_(name), realValue_(0.0),
+          symbolPrecedence_(static_cast<std::int16_t>(symbolPrecedence)), type_(type), value_(value)
     {}
 
     Token::Token(TokenType type, TokenValue value, const TokenLocation& location,
-                 int intValue, const std::string& name)
-        : type_(type), value_(value), location_(location),
-          name_(name), symbolPrecedence_(-1), intValue_(intValue)
+                 int intValue, std::string_view name)
+        : location_(location), name_(name), intValue_(intValue),
+          symbolPrecedence_(-1), type_(type), value_(value)
     {}
 
     Token::Token(TokenType type, TokenValue value, const TokenLocation& location,
-                 double realValue, const std::string& name)
-        : type_(type), value_(value), location_(location),
-          name_(name), symbolPrecedence_(-1), realValue_(realValue)
+                 double realValue, std::string_view name)
+        : location_(location), name_(name), realValue_(realValue),
+          symbolPrecedence_(-1), type_(type), value_(value)
     {}
 
     std::string Token::tokenTypeDescription() const
@@ -116,7 +131,7 @@ namespace MJava
 
     std::string Token::toString() const
     {
-        return std::string(location_.toString() + " Token Type:\t " + tokenTypeDescription() + "\t" + "Token Name:\t" + name_);
+        return std::string(location_.toString() + " Token Type:\t " + tokenTypeDescription() + "\t" + "Token Name:\t").append(name_);
     }
 
     void Token::dump(std::ostream& out /* = std::cout */) const
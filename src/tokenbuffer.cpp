@@ -0,0 +1,126 @@
+// THIS FILE IS PART OF MJava-Compiler PROJECT
+// tokenbuffer.cpp - all the tokens of a file, one array per field
+
+// Created by Li Taiji 2026-10-17
+// Copyright (c) 2026 Li Taiji All rights reserved
+
+#include "tokenbuffer.h"
+#include <algorithm>
+
+namespace MJava
+{
+    namespace
+    {
+        // overwrite the elements both ranges have, so the tail is moved at
+        // most once, and not at all if the sizes are the same.
+        template <typename T>
+        void replaceRange(std::vector<T>& values, std::size_t begin, std::size_t end, const std::vector<T>& other)
+        {
+            std::size_t common = std::min(end - begin, other.size());
+            std::copy(other.begin(), other.begin() + common, values.begin() + begin);
+
+            if (other.size() > common)
+            {
+                values.insert(values.begin() + end, other.begin() + common, other.end());
+            }
+            else
+            {
+                values.erase(values.begin() + begin + common, values.begin() + end);
+            }
+        }
+    }
+
+    TokenBuffer::TokenBuffer(FileID fileId) : fileId_(fileId)
+    {}
+
+    void TokenBuffer::reserve(std::size_t count)
+    {
+        types_.reserve(count);
+        values_.reserve(count);
+        offsets_.reserve(count);
+        names_.reserve(count);
+        literals_.reserve(count);
+        precedences_.reserve(count);
+    }
+
+    void TokenBuffer::push(const Token& token)
+    {
+        Literal literal;
+
+        switch (token.getTokenType())
+        {
+            case TokenType::INTEGER:
+            case TokenType::CHAR_LITERAL:
+                literal.intValue = token.getIntValue();
+                break;
+
+            case TokenType::REAL:
+                literal.realValue = token.getRealValue();
+                break;
+
+            default:
+                literal.intValue = 0;
+                break;
+        }
+
+        types_.push_back(token.getTokenType());
+        values_.push_back(token.getTokenValue());
+        offsets_.push_back(token.getTokenLocation().getOffset());
+        names_.push_back(token.getTokenName());
+        literals_.push_back(literal);
+        precedences_.push_back(static_cast<std::int16_t>(token.getSymbolPrecedence()));
+    }
+
+    Token TokenBuffer::at(std::size_t index) const
+    {
+        TokenLocation location(fileId_, offsets_[index]);
+
+        switch (types_[index])
+        {
+            case TokenType::INTEGER:
+            case TokenType::CHAR_LITERAL:
+                return Token(types_[index], values_[index], location, literals_[index].intValue, names_[index]);
+
+            case TokenType::REAL:
+                return Token(types_[index], values_[index], location, literals_[index].realValue, names_[index]);
+
+            default:
+                return Token(types_[index], values_[index], location, names_[index], precedences_[index]);
+        }
+    }
+
+    std::size_t TokenBuffer::lowerBound(std::uint32_t offset, std::size_t begin, std::size_t end) const
+    {
+        return std::lower_bound(offsets_.begin() + begin, offsets_.begin() + end, offset) - offsets_.begin();
+    }
+
+    void TokenBuffer::splice(std::size_t begin, std::size_t end, const TokenBuffer& other)
+    {
+        replaceRange(types_, begin, end, other.types_);
+        replaceRange(values_, begin, end, other.values_);
+        replaceRange(offsets_, begin, end, other.offsets_);
+        replaceRange(names_, begin, end, other.names_);
+        replaceRange(literals_, begin, end, other.literals_);
+        replaceRange(precedences_, begin, end, other.precedences_);
+    }
+
+    void TokenBuffer::relocate(std::size_t begin, std::size_t end, std::ptrdiff_t delta,
+                               const char* from, std::size_t size, const char* to)
+    {
+        // the old text may be freed already, so its addresses are only compared as numbers.
+        std::uintptr_t oldBase = reinterpret_cast<std::uintptr_t>(from);
+
+        for (std::size_t i = begin; i < end; i++)
+        {
+            offsets_[i] = static_cast<std::uint32_t>(offsets_[i] + delta);
+
+            std::uintptr_t name = reinterpret_cast<std::uintptr_t>(names_[i].data());
+
+            // END_OF_FILE and the like are not in the text.
+            if (name >= oldBase && name - oldBase <= size)
+            {
+                names_[i] = std::string_view(to + (name - oldBase) + delta, names_[i].size());
+            }
+        }
+    }
+} // namespace MJava
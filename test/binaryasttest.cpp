@@ -0,0 +1,419 @@
+// THIS FILE IS PART OF MJava-Compiler PROJECT
+// binaryasttest.cpp - write a binary ast, map it and walk it
+
+// Created by Li Taiji 2026-10-18
+// Copyright (c) 2026 Li Taiji All rights reserved
+
+#include "binaryast.h"
+#include "dictionary.h"
+#include "jsonwriter.h"
+#include "parser.h"
+#include "scanner.h"
+#include "test.h"
+#include <cstddef>
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+#include <string>
+
+namespace
+{
+    // a node of every type the parser makes.
+    const std::string PROGRAM =
+        "class Main {\n"
+        "    public static void main(String[] a) {\n"
+        "        System.out.println(new B().run(3, 4));\n"
+        "    }\n"
+        "}\n"
+        "class A {\n"
+        "    int x;\n"
+        "    public int get() {\n"
+        "        return x;\n"
+        "    }\n"
+        "}\n"
+        "class B extends A {\n"
+        "    int[] values;\n"
+        "    double ratio;\n"
+        "    public int run(int n, int m) {\n"
+        "        int i;\n"
+        "        boolean done;\n"
+        "        char c;\n"
+        "        String s;\n"
+        "        values = new int[n + m];\n"
+        "        i = 0;\n"
+        "        ratio = 1.5;\n"
+        "        c = 'q';\n"
+        "        s = \"text \\\"quoted\\\"\";\n"
+        "        done = false;\n"
+        "        while (i < values.length && !done) {\n"
+        "            values[i] = i * 2 - 1;\n"
+        "            i = i + 1;\n"
+        "        }\n"
+        "        i = 0;\n"
+        "        while (i < n) {\n"
+        "            if (values[i] < m) {\n"
+        "                System.out.println(values[i]);\n"
+        "            } else {\n"
+        "                done = true;\n"
+        "            }\n"
+        "            i = i + 1;\n"
+        "        }\n"
+        "        return this.get() + values[0];\n"
+        "    }\n"
+        "}\n";
+
+    const char* const FILE_NAME = "binaryasttest.mjab";
+
+    // writes a mapped tree as json, member by member as ASTSerializer does
+    // for the nodes of the parser.
+    class BinaryJSONWriter
+    {
+      public:
+        BinaryJSONWriter(const MJava::BinaryAST& tree, MJava::JSONWriter& writer)
+            : tree_(tree), writer_(writer)
+        {}
+
+        void write(MJava::FlatIndex index)
+        {
+            if (index == MJava::FLAT_NULL)
+            {
+                writer_.beginObject();
+                writer_.endObject();
+                return;
+            }
+
+            const MJava::FlatNode& node = tree_.getNode(index);
+
+            switch (node.getType())
+            {
+                case MJava::ASTType::BLOCK:
+                    writeStatementArray(index);
+                    return;
+
+                case MJava::ASTType::METHODBODY:
+                    writer_.beginObject();
+                    writeList("local variables", node.slots[0]);
+                    writeList("method body", node.slots[1]);
+                    writeChild("return statement", node.slots[2]);
+                    writer_.endObject();
+                    return;
+
+                case MJava::ASTType::BASE:
+                    writer_.beginObject();
+                    writer_.endObject();
+                    return;
+
+                default:
+                    break;
+            }
+
+            writer_.beginObject();
+            writer_.key("id");
+            writer_.value(static_cast<int>(node.type));
+            writer_.key("type");
+            writer_.value(MJava::ExprAST(MJava::TokenLocation(), node.getType()).getASTTypeDescription());
+
+            switch (node.getType())
+            {
+                case MJava::ASTType::PROGRAM:
+                    writeList("classes", node.slots[0]);
+                    break;
+
+                case MJava::ASTType::CLASSDECLARATION:
+                    writeName("class name", node.names[0]);
+                    writeName("base class", node.names[1]);
+                    writeList("member variables", node.slots[0]);
+                    writeList("member methods", node.slots[1]);
+                    break;
+
+                case MJava::ASTType::MAINCLASS:
+                    writeName("class name", node.names[0]);
+                    writeChild("main method", node.slots[0]);
+                    break;
+
+                case MJava::ASTType::METHODDECLARATION:
+                    writer_.key("attributes");
+                    writer_.beginArray();
+
+                    for (MJava::Symbol attribute : tree_.getList(node.slots[0]))
+                    {
+                        writer_.value(tree_.getName(attribute));
+                    }
+
+                    writer_.endArray();
+                    writeName("return type", node.names[0]);
+                    writeName("method name", node.names[1]);
+                    writeList("parameters", node.slots[1]);
+                    writeChild("body", node.slots[2]);
+                    break;
+
+                case MJava::ASTType::METHODCALL:
+                    writeName("method name", node.names[0]);
+                    writeList("parameters", node.slots[0]);
+                    break;
+
+                case MJava::ASTType::VARIABLEDECLARATION:
+                    writeName("variable type", node.names[0]);
+                    writeName("variable name", node.names[1]);
+                    break;
+
+                case MJava::ASTType::VARIABLE:
+                    writeName("name", node.names[0]);
+                    break;
+
+                case MJava::ASTType::ARRAY:
+                    writeName("name", node.names[0]);
+                    writeChild("index", node.slots[0]);
+                    break;
+
+                case MJava::ASTType::IFSTATEMENT:
+                    writeChild("condition", node.slots[0]);
+                    writer_.key("then part");
+                    writeStatementArray(node.slots[1]);
+                    writer_.key("else part");
+                    writeStatementArray(node.slots[2]);
+                    break;
+
+                case MJava::ASTType::WHILESTATEMENT:
+                    writeChild("condition", node.slots[0]);
+                    writer_.key("while body");
+                    writeStatementArray(node.slots[1]);
+                    break;
+
+                case MJava::ASTType::FORSTATEMENT:
+                    writeChild("variable", node.slots[0]);
+                    writeChild("condition", node.slots[1]);
+                    writeChild("action", node.slots[2]);
+                    writer_.key("body");
+                    writeStatementArray(node.slots[3]);
+                    break;
+
+                case MJava::ASTType::RETURNSTATEMENT:
+                    writeChild("return expression", node.slots[0]);
+                    break;
+
+                case MJava::ASTType::PRINTSTATEMENT:
+                    writeChild("print expression", node.slots[0]);
+                    break;
+
+                case MJava::ASTType::NEWSTATEMENT:
+                {
+                    MJava::FlatIndex expression = node.slots[0];
+                    bool call = expression != MJava::FLAT_NULL &&
+                                tree_.getNode(expression).getType() == MJava::ASTType::METHODCALL;
+                    writeName("variable type", node.names[0]);
+                    writeChild(call ? "expression" : "length", expression);
+                    break;
+                }
+
+                case MJava::ASTType::BINARYOPEXPRESSION:
+                    writer_.key("binary operator");
+                    writer_.value(MJava::Dictionary::spell(node.getOperator()));
+                    writeChild("lhs", node.slots[0]);
+                    writeChild("rhs", node.slots[1]);
+                    break;
+
+                case MJava::ASTType::UNARYOPEXPRESSION:
+                    writer_.key("unary operator");
+                    writer_.value(MJava::Dictionary::spell(node.getOperator()));
+                    writeChild("expression", node.slots[0]);
+                    break;
+
+                case MJava::ASTType::REAL:
+                    writer_.key("real");
+                    writer_.value(node.getReal());
+                    break;
+
+                case MJava::ASTType::INTEGER:
+                    writer_.key("integer");
+                    writer_.value(node.getInteger());
+                    break;
+
+                case MJava::ASTType::CHAR:
+                {
+                    char ch = node.getChar();
+                    writer_.key("char");
+                    writer_.value(std::string_view(&ch, 1));
+                    break;
+                }
+
+                case MJava::ASTType::STRING:
+                    writeName("string", node.names[0]);
+                    break;
+
+                case MJava::ASTType::BOOLEAN:
+                    writer_.key("boolean");
+                    writer_.value(node.getBoolean());
+                    break;
+
+                default:
+                    break;
+            }
+
+            writer_.endObject();
+        }
+
+      private:
+        void writeName(const char* key, MJava::Symbol symbol)
+        {
+            writer_.key(key);
+            writer_.value(tree_.getName(symbol));
+        }
+
+        void writeChild(const char* key, MJava::FlatIndex index)
+        {
+            writer_.key(key);
+            write(index);
+        }
+
+        void writeList(const char* key, std::uint32_t slot)
+        {
+            writer_.key(key);
+            writer_.beginArray();
+
+            for (MJava::FlatIndex index : tree_.getList(slot))
+            {
+                writeStatements(index);
+            }
+
+            writer_.endArray();
+        }
+
+        // a block adds its statements to the list it is in.
+        void writeStatements(MJava::FlatIndex index)
+        {
+            if (index != MJava::FLAT_NULL && tree_.getNode(index).getType() == MJava::ASTType::BLOCK)
+            {
+                for (MJava::FlatIndex statement : tree_.getList(tree_.getNode(index).slots[0]))
+                {
+                    writeStatements(statement);
+                }
+            }
+            else
+            {
+                write(index);
+            }
+        }
+
+        void writeStatementArray(MJava::FlatIndex index)
+        {
+            writer_.beginArray();
+
+            if (index != MJava::FLAT_NULL)
+            {
+                writeStatements(index);
+            }
+
+            writer_.endArray();
+        }
+
+      private:
+        const MJava::BinaryAST&     tree_;
+        MJava::JSONWriter&          writer_;
+    };
+
+    std::string writeFile(const MJava::Parser& parser)
+    {
+        std::ostringstream out;
+        parser.writeBinary(out);
+        std::ofstream(FILE_NAME, std::ios::out | std::ios::binary) << out.str();
+        return out.str();
+    }
+
+    bool openBytes(const std::string& bytes)
+    {
+        std::ofstream(FILE_NAME, std::ios::out | std::ios::binary) << bytes;
+        MJava::BinaryAST tree;
+        return tree.open(FILE_NAME);
+    }
+
+    void putWord(std::string& bytes, std::size_t offset, std::uint32_t word)
+    {
+        bytes.replace(offset, sizeof(word), reinterpret_cast<const char*>(&word), sizeof(word));
+    }
+} // namespace
+
+TEST(BinaryASTRoundTrip)
+{
+    MJava::Scanner scanner("b.java", PROGRAM);
+    MJava::TokenBuffer tokens = scanner.tokenizeAll();
+    MJava::Parser parser(tokens);
+    parser.parse();
+    CHECK(!parser.getErrorFlag());
+
+    std::ostringstream expected;
+    parser.writeJSON(expected);
+    writeFile(parser);
+
+    MJava::BinaryAST tree;
+    CHECK(tree.open(FILE_NAME));
+    CHECK(!tree.empty());
+
+    if (!tree.empty())
+    {
+        std::ostringstream actual;
+
+        {
+            MJava::JSONWriter writer(actual);
+            BinaryJSONWriter(tree, writer).write(0);
+        }
+
+        CHECK_EQUAL(expected.str(), actual.str());
+    }
+
+    std::remove(FILE_NAME);
+}
+
+TEST(BinaryASTRefusesCorruptFiles)
+{
+    MJava::Scanner scanner("b.java", PROGRAM);
+    MJava::TokenBuffer tokens = scanner.tokenizeAll();
+    MJava::Parser parser(tokens);
+    parser.parse();
+
+    const std::string bytes = writeFile(parser);
+    MJava::BinaryASTHeader header;
+    bytes.copy(reinterpret_cast<char*>(&header), sizeof(header));
+
+    std::size_t nodes = sizeof(MJava::BinaryASTHeader);
+    std::size_t lists = nodes + header.nodeCount * sizeof(MJava::FlatNode);
+    std::size_t offsets = lists + header.listCount * sizeof(std::uint32_t);
+    // slot 0 of the root is the list of classes, the main class is its first item.
+    std::size_t rootSlot0 = nodes + offsetof(MJava::FlatNode, slots);
+    std::uint32_t classes = 0;
+    bytes.copy(reinterpret_cast<char*>(&classes), sizeof(classes), rootSlot0);
+
+    CHECK(openBytes(bytes));
+
+    // cut in the middle of the nodes.
+    CHECK(!openBytes(bytes.substr(0, lists - 16)));
+
+    std::string corrupt = bytes;
+    putWord(corrupt, rootSlot0, header.listCount);
+    CHECK(!openBytes(corrupt));
+
+    // a list item out of the nodes, and one pointing back at the root.
+    corrupt = bytes;
+    putWord(corrupt, lists + (classes + 1) * sizeof(std::uint32_t), header.nodeCount);
+    CHECK(!openBytes(corrupt));
+    corrupt = bytes;
+    putWord(corrupt, lists + (classes + 1) * sizeof(std::uint32_t), 0);
+    CHECK(!openBytes(corrupt));
+
+    // a list longer than the list section.
+    corrupt = bytes;
+    putWord(corrupt, lists + classes * sizeof(std::uint32_t), header.listCount);
+    CHECK(!openBytes(corrupt));
+
+    // a name out of the strings.
+    corrupt = bytes;
+    putWord(corrupt, nodes + offsetof(MJava::FlatNode, names), header.stringCount);
+    CHECK(!openBytes(corrupt));
+
+    // string offsets going back.
+    corrupt = bytes;
+    putWord(corrupt, offsets + sizeof(std::uint32_t), header.stringBytes + 1);
+    CHECK(!openBytes(corrupt));
+
+    std::remove(FILE_NAME);
+}
@@ -0,0 +1,53 @@
+// THIS FILE IS PART OF MJava-Compiler PROJECT
+// compilecachetest.cpp - eviction only removes the entries of the cache
+
+// Created by Li Taiji 2026-10-18
+// Copyright (c) 2026 Li Taiji All rights reserved
+
+#include "compilecache.h"
+#include "test.h"
+#include <filesystem>
+#include <fstream>
+#include <string>
+
+namespace
+{
+    void writeFile(const std::filesystem::path& path, std::size_t size)
+    {
+        std::ofstream out(path, std::ios::out | std::ios::binary);
+        out << std::string(size, 'x');
+    }
+}
+
+TEST(CompileCacheEvictsOnlyEntries)
+{
+    std::filesystem::path directory = std::filesystem::temp_directory_path() / "mjava-compilecache-test";
+    std::filesystem::remove_all(directory);
+
+    {
+        MJava::CompileCache cache(directory.string(), 1);
+
+        // the files of the user, and the temporary file of another writer.
+        writeFile(directory / "a.java", 100);
+        writeFile(directory / "notes.txt", 100);
+        writeFile(directory / "0123456789abcdef0123456789abcdef", 100);
+        writeFile(directory / "0123456789abcdef0123456789abcdef.mjc.tmp1-2", 100);
+
+        writeFile(directory / "a.lex", 100);
+        std::string key = MJava::CompileCache::makeKey("a", 1, "Lexer a.java");
+        cache.store(key, (directory / "a.lex").string());
+        CHECK(cache.fetch(key, (directory / "b.lex").string()));
+
+        cache.evict();
+        CHECK_EQUAL(std::size_t(1), cache.getStatistics().evictions);
+        CHECK(!cache.fetch(key, (directory / "b.lex").string()));
+    }
+
+    CHECK(std::filesystem::exists(directory / "a.java"));
+    CHECK(std::filesystem::exists(directory / "notes.txt"));
+    CHECK(std::filesystem::exists(directory / "a.lex"));
+    CHECK(std::filesystem::exists(directory / "0123456789abcdef0123456789abcdef"));
+    CHECK(std::filesystem::exists(directory / "0123456789abcdef0123456789abcdef.mjc.tmp1-2"));
+
+    std::filesystem::remove_all(directory);
+}
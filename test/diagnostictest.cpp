@@ -0,0 +1,92 @@
+// THIS FILE IS PART OF MJava-Compiler PROJECT
+// diagnostictest.cpp - the errors of a file in source order and as valid json
+
+// Created by Li Taiji 2026-10-18
+// Copyright (c) 2026 Li Taiji All rights reserved
+
+#include "diagnostic.h"
+#include "jsonwriter.h"
+#include "test.h"
+#include <sstream>
+#include <string>
+
+namespace
+{
+    MJava::Diagnostic makeError(int line, int column, const std::string& message)
+    {
+        return MJava::Diagnostic{MJava::Severity::ERROR, MJava::DiagnosticKind::SYNTAX, "d.java", line, column, message};
+    }
+
+    std::string writeString(const std::string& text)
+    {
+        std::ostringstream out;
+
+        {
+            MJava::JSONWriter writer(out, false);
+            writer.value(text);
+        }
+
+        return out.str();
+    }
+}
+
+TEST(DiagnosticsInSourceOrder)
+{
+    MJava::DiagnosticEngine engine("d.java", MJava::DiagnosticEngine::Options());
+
+    // the token errors of a scanned file come before its syntax errors.
+    engine.report(makeError(3, 1, "c"));
+    engine.report(makeError(1, 5, "a"));
+    engine.report(makeError(2, 1, "b"));
+    engine.report(makeError(1, 5, "a again"));
+    engine.report(makeError(1, 1, "first"));
+
+    const auto& diagnostics = engine.getDiagnostics();
+    CHECK_EQUAL(std::size_t(4), diagnostics.size());
+    CHECK_EQUAL(std::size_t(1), engine.getDuplicateCount());
+
+    if (diagnostics.size() == 4)
+    {
+        CHECK_EQUAL(std::string("first"), diagnostics[0].message);
+        CHECK_EQUAL(std::string("a"), diagnostics[1].message);
+        CHECK_EQUAL(std::string("b"), diagnostics[2].message);
+        CHECK_EQUAL(std::string("c"), diagnostics[3].message);
+    }
+}
+
+TEST(DiagnosticsKeepFirstInSource)
+{
+    MJava::DiagnosticEngine::Options options;
+    options.maxErrors = 2;
+    options.deduplicate = false;
+    MJava::DiagnosticEngine engine("d.java", options);
+
+    engine.report(makeError(5, 1, "e"));
+    engine.report(makeError(4, 1, "d"));
+    engine.report(makeError(1, 1, "a"));
+    engine.report(makeError(9, 1, "i"));
+    engine.report(makeError(1, 1, "a again"));
+
+    const auto& diagnostics = engine.getDiagnostics();
+    CHECK_EQUAL(std::size_t(2), diagnostics.size());
+    CHECK_EQUAL(std::size_t(3), engine.getOmittedCount());
+
+    if (diagnostics.size() == 2)
+    {
+        CHECK_EQUAL(std::string("a"), diagnostics[0].message);
+        CHECK_EQUAL(std::string("a again"), diagnostics[1].message);
+    }
+}
+
+TEST(DiagnosticsJsonReplacesInvalidUTF8)
+{
+    // the end of the file.
+    CHECK_EQUAL(std::string("\"a\\ufffdb\""), writeString("a\xFF" "b"));
+    // whole characters of two, three and four bytes are kept.
+    CHECK_EQUAL(std::string("\"\xC3\xA9\xE4\xB8\xAD\xF0\x9F\x98\x80\""), writeString("\xC3\xA9\xE4\xB8\xAD\xF0\x9F\x98\x80"));
+    // a cut character, a lone continuation byte, an overlong form and a surrogate.
+    CHECK_EQUAL(std::string("\"\\ufffd\\ufffd\""), writeString("\xE4\xB8"));
+    CHECK_EQUAL(std::string("\"\\ufffd\""), writeString("\x80"));
+    CHECK_EQUAL(std::string("\"\\ufffd\\ufffd\""), writeString("\xC0\xAF"));
+    CHECK_EQUAL(std::string("\"\\ufffd\\ufffd\\ufffd\""), writeString("\xED\xA0\x80"));
+}
@@ -0,0 +1,196 @@
+// THIS FILE IS PART OF MJava-Compiler PROJECT
+// incrementalparsertest.cpp - the incremental parse is the same as a fresh one
+
+// Created by Li Taiji 2026-10-18
+// Copyright (c) 2026 Li Taiji All rights reserved
+
+#include "diagnostic.h"
+#include "incrementalparser.h"
+#include "parser.h"
+#include "scanner.h"
+#include "test.h"
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace
+{
+    const std::string PROGRAM =
+        "class Main {\n"
+        "    public static void main(String[] a) {\n"
+        "        System.out.printl(1);\n"
+        "    }\n"
+        "}\n"
+        "class A {\n"
+        "    int x;\n"
+        "    public int f(int a) {\n"
+        "        System.out.println(a);\n"
+        "        return a + 1;\n"
+        "    }\n"
+        "    public int g() {\n"
+        "        return x;\n"
+        "    }\n"
+        "}\n";
+
+    // the pieces the random edits insert, most of them change how the tokens around are cut.
+    const std::vector<std::string> FRAGMENTS = {
+        "n", ".", " ", "\n", "{", "}", "(", ")", ";", "x", "1", "\"", "/*", "*/", "//",
+        "System", "System.out.println", ".out", "class", "class B { }", "int y;",
+    };
+
+    std::string incrementalJSON(MJava::IncrementalParser& parser)
+    {
+        std::ostringstream out;
+        parser.writeJSON(out);
+        return out.str();
+    }
+
+    // parse the text again from the start, return the json of the tree.
+    std::string freshJSON(const std::string& source, bool& errorFlag)
+    {
+        MJava::Scanner scanner("i.java", source);
+        MJava::TokenBuffer tokens = scanner.tokenizeAll();
+        MJava::Parser parser(tokens);
+        parser.parse();
+        errorFlag = parser.getErrorFlag();
+
+        std::ostringstream out;
+        parser.writeJSON(out);
+        return out.str();
+    }
+
+    void checkSameAsFresh(MJava::IncrementalParser& parser)
+    {
+        bool errorFlag = false;
+        std::string expected = freshJSON(std::string(parser.getSource()), errorFlag);
+
+        CHECK_EQUAL(expected, incrementalJSON(parser));
+        CHECK_EQUAL(errorFlag, parser.getErrorFlag());
+    }
+
+    struct Edit
+    {
+        std::size_t     offset;
+        std::size_t     length;
+        std::string     text;
+    };
+}
+
+TEST(IncrementalParserCompletesSystemOutPrintln)
+{
+    MJava::DiagnosticEngine diagnostics("i.java", MJava::DiagnosticEngine::Options());
+    MJava::DiagnosticScope scope(diagnostics);
+    MJava::IncrementalParser parser("i.java", PROGRAM);
+    CHECK(parser.getErrorFlag());
+
+    // "System" has looked at "printl(" and found no "System.out.println".
+    std::size_t offset = PROGRAM.find("(1)");
+    parser.edit(offset, 0, "n");
+    CHECK(!parser.getErrorFlag());
+    checkSameAsFresh(parser);
+
+    parser.edit(offset, 1, "");
+    CHECK(parser.getErrorFlag());
+    checkSameAsFresh(parser);
+}
+
+TEST(IncrementalParserEditsAtFileStart)
+{
+    MJava::DiagnosticEngine diagnostics("i.java", MJava::DiagnosticEngine::Options());
+    MJava::DiagnosticScope scope(diagnostics);
+    MJava::IncrementalParser parser("i.java", PROGRAM);
+
+    // the whole file is a comment, only END_OF_FILE is left after it.
+    parser.edit(0, 0, "/*");
+    checkSameAsFresh(parser);
+    parser.edit(0, 2, "");
+    checkSameAsFresh(parser);
+
+    // the main class is taken by the first segment again.
+    parser.edit(0, 0, "(");
+    checkSameAsFresh(parser);
+    parser.edit(0, 1, "");
+    checkSameAsFresh(parser);
+}
+
+TEST(IncrementalParserRandomEditsAndUndo)
+{
+    MJava::DiagnosticEngine diagnostics("i.java", MJava::DiagnosticEngine::Options());
+    MJava::DiagnosticScope scope(diagnostics);
+
+    for (unsigned seed = 0; seed < 300; seed++)
+    {
+        std::mt19937 random(seed);
+        MJava::IncrementalParser parser("i.java", PROGRAM);
+        std::vector<Edit> undo;
+
+        for (int i = 0; i < 8; i++)
+        {
+            std::string source(parser.getSource());
+            std::size_t offset = random() % (source.size() + 1);
+            std::size_t length = std::min<std::size_t>(random() % 4, source.size() - offset);
+            const std::string& text = FRAGMENTS[random() % FRAGMENTS.size()];
+
+            undo.push_back(Edit{offset, text.size(), source.substr(offset, length)});
+            parser.edit(offset, length, text);
+            checkSameAsFresh(parser);
+        }
+
+        while (!undo.empty())
+        {
+            parser.edit(undo.back().offset, undo.back().length, undo.back().text);
+            undo.pop_back();
+            checkSameAsFresh(parser);
+        }
+
+        CHECK_EQUAL(PROGRAM, std::string(parser.getSource()));
+    }
+}
+
+TEST(IncrementalParserMovesClassesWhenRead)
+{
+    MJava::DiagnosticEngine diagnostics("i.java", MJava::DiagnosticEngine::Options());
+    MJava::DiagnosticScope scope(diagnostics);
+
+    std::string program = PROGRAM;
+
+    for (int i = 0; i < 6; i++)
+    {
+        program += "class B" + std::to_string(i) + " {\n    public int h() {\n        return " + std::to_string(i) + ";\n    }\n}\n";
+    }
+
+    // long texts make the text grow out of its place.
+    std::vector<std::string> fragments = FRAGMENTS;
+    fragments.push_back(std::string(300, ' '));
+    fragments.push_back("class C {\n" + std::string(500, ' ') + "}\n");
+
+    for (unsigned seed = 0; seed < 200; seed++)
+    {
+        std::mt19937 random(seed);
+        MJava::IncrementalParser parser("i.java", program);
+
+        // the classes after an edit are only moved when the tree is read.
+        for (int i = 0; i < 6; i++)
+        {
+            std::string source(parser.getSource());
+            std::size_t offset = random() % (source.size() + 1);
+            std::size_t length = std::min<std::size_t>(random() % 4, source.size() - offset);
+            parser.edit(offset, length, fragments[random() % fragments.size()]);
+        }
+
+        checkSameAsFresh(parser);
+
+        std::string source(parser.getSource());
+        MJava::Scanner scanner("i.java", source);
+        MJava::TokenBuffer fresh = scanner.tokenizeAll();
+        const MJava::TokenBuffer& tokens = parser.getTokens();
+        CHECK_EQUAL(fresh.size(), tokens.size());
+
+        for (std::size_t i = 0; i < fresh.size() && i < tokens.size(); i++)
+        {
+            CHECK_EQUAL(fresh.getOffset(i), tokens.getOffset(i));
+            CHECK(fresh.getTokenName(i) == tokens.getTokenName(i));
+        }
+    }
+}
@@ -0,0 +1,198 @@
+// THIS FILE IS PART OF MJava-Compiler PROJECT
+// parsertest.cpp - the parser stops on every broken input
+
+// Created by Li Taiji 2026-10-18
+// Copyright (c) 2026 Li Taiji All rights reserved
+
+#include "astvisitor.h"
+#include "diagnostic.h"
+#include "flatast.h"
+#include "parser.h"
+#include "scanner.h"
+#include "test.h"
+#include "threadpool.h"
+#include <algorithm>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace
+{
+    const std::string MAIN_CLASS =
+        "class Main { public static void main(String[] a) { System.out.println(1); } }\n";
+
+    // one input for every loop of the parser, each ends inside the loop.
+    const std::vector<std::string> BROKEN_INPUTS = {
+        // the classes after the main class.
+        MAIN_CLASS + "} class",
+        // the local variables and the statements of the main method.
+        "class Main { public static void main(String[] a) { int x;",
+        "class Main { public static void main(String[] a) { x = ; } }\nclass A { public int f(int a",
+        "class Main { public static void main(String[] a) { x = 1;",
+        // the member variables and the methods of a class.
+        MAIN_CLASS + "class A { int x;",
+        MAIN_CLASS + "class A { public int f() { return 1; }",
+        // the attributes and the parameters of a method.
+        MAIN_CLASS + "class A { public static",
+        MAIN_CLASS + "class A { public int f(int a",
+        MAIN_CLASS + "class A { public int f(int a,",
+        MAIN_CLASS + "class A { public int f(int[",
+        MAIN_CLASS + "class A { public int f(int a {",
+        MAIN_CLASS + "class A { public int f(+",
+        // the local variables and the statements of a method.
+        MAIN_CLASS + "class A { public int f() { int y;",
+        MAIN_CLASS + "class A { public int f() { y = 1;",
+        // the arguments of a call, a block and the operators.
+        MAIN_CLASS + "class A { public int f() { y = this.g(1,",
+        MAIN_CLASS + "class A { public int f() { while (true) { y = 1;",
+        MAIN_CLASS + "class A { public int f() { y = 1 +",
+    };
+
+    const std::string PROGRAM =
+        MAIN_CLASS +
+        "class A extends B {\n"
+        "    int x;\n"
+        "    int[] y;\n"
+        "    public int f(int a, int[] b, A c) {\n"
+        "        int z;\n"
+        "        z = a + b[0] * 2 - c.g(a, 1);\n"
+        "        if (!(z < 1) && true) { x = b.length; } else y = new int[3];\n"
+        "        while (z < 10) z = z + 1;\n"
+        "        System.out.println(new A().g(z, x));\n"
+        "        return z;\n"
+        "    }\n"
+        "}\n";
+
+    // a few classes, so that parseParallel() has groups to share out.
+    const std::string CLASSES =
+        PROGRAM +
+        "class B { int y; public int g(int a, int b) { if (a < b) y = a; else y = b; return y; } }\n"
+        "class C extends B { public int h() { while (true) { y = y + 1; } return y; } }\n"
+        "class D { int[] z; public int k() { z = new int[2]; return z.length; } }\n";
+
+    // the errors and the tree of the source, parsed with or without a pool.
+    std::string parseOutput(const std::string& source, MJava::ThreadPool* pool)
+    {
+        MJava::DiagnosticEngine diagnostics("p.java", MJava::DiagnosticEngine::Options());
+        std::ostringstream out;
+
+        {
+            MJava::DiagnosticScope scope(diagnostics);
+            MJava::Scanner scanner("p.java", source);
+            MJava::TokenBuffer tokens = scanner.tokenizeAll();
+            MJava::Parser parser(tokens);
+
+            if (pool != nullptr)
+            {
+                parser.parseParallel(*pool);
+            }
+            else
+            {
+                parser.parse();
+            }
+
+            parser.writeJSON(out);
+            out << parser.getErrorFlag() << '\n';
+        }
+
+        return diagnostics.format() + out.str();
+    }
+
+    // parse over the scanner and over a token buffer, both must stop.
+    void parse(const std::string& source, bool& scannerError, bool& bufferError)
+    {
+        MJava::DiagnosticEngine diagnostics("p.java", MJava::DiagnosticEngine::Options());
+        MJava::DiagnosticScope scope(diagnostics);
+
+        MJava::Scanner scanner("p.java", source);
+        MJava::Parser parser(scanner);
+        parser.parse();
+        scannerError = parser.getErrorFlag();
+
+        MJava::Scanner bufferScanner("p.java", source);
+        MJava::TokenBuffer tokens = bufferScanner.tokenizeAll();
+        MJava::Parser bufferParser(tokens);
+        bufferParser.parse();
+        bufferError = bufferParser.getErrorFlag();
+    }
+}
+
+TEST(ParserStopsOnBrokenInputs)
+{
+    for (const std::string& source : BROKEN_INPUTS)
+    {
+        bool scannerError = false;
+        bool bufferError = false;
+        parse(source, scannerError, bufferError);
+
+        CHECK(scannerError);
+        CHECK(bufferError);
+    }
+}
+
+TEST(ParserStopsOnEveryPrefix)
+{
+    bool scannerError = false;
+    bool bufferError = false;
+    parse(PROGRAM, scannerError, bufferError);
+    CHECK(!scannerError);
+    CHECK(!bufferError);
+
+    // the end of the file is in every loop of the parser once.
+    for (std::size_t size = 0; size < PROGRAM.size(); size++)
+    {
+        parse(PROGRAM.substr(0, size), scannerError, bufferError);
+        CHECK_EQUAL(scannerError, bufferError);
+    }
+}
+
+TEST(ParserParallelSameAsSerial)
+{
+    MJava::ThreadPool pool(2);
+    std::vector<std::string> sources = BROKEN_INPUTS;
+    sources.push_back(CLASSES);
+    sources.push_back("if " + CLASSES);
+    sources.push_back(CLASSES + "} x = class E { }");
+
+    // a broken class may run into the next one.
+    for (std::size_t i = 0; i < CLASSES.size(); i++)
+    {
+        sources.push_back(CLASSES.substr(0, i) + CLASSES.substr(i + 1));
+        sources.push_back(CLASSES.substr(0, i) + "{" + CLASSES.substr(i));
+        sources.push_back(CLASSES.substr(0, i) + "class" + CLASSES.substr(i));
+    }
+
+    for (const std::string& source : sources)
+    {
+        CHECK_EQUAL(parseOutput(source, nullptr), parseOutput(source, &pool));
+    }
+}
+
+TEST(ParserWritesLongOperatorChains)
+{
+    // every "+" nests the terms before it one level deeper.
+    const std::size_t terms = 300000;
+    std::string source = MAIN_CLASS + "class A { public int f() { int x; x = 1";
+
+    for (std::size_t i = 1; i < terms; i++)
+    {
+        source += " + 1";
+    }
+
+    source += "; return x; } }\n";
+
+    MJava::Scanner scanner("p.java", source);
+    MJava::TokenBuffer tokens = scanner.tokenizeAll();
+    MJava::Parser parser(tokens);
+    MJava::ProgramASTPtr program = parser.parse();
+    CHECK(!parser.getErrorFlag());
+
+    std::ostringstream out;
+    parser.writeJSON(out, false);
+    std::string json = out.str();
+    CHECK_EQUAL(terms - 1, static_cast<std::size_t>(std::count(json.begin(), json.end(), '+')));
+    CHECK_EQUAL(std::count(json.begin(), json.end(), '{'), std::count(json.begin(), json.end(), '}'));
+
+    MJava::FlatAST tree(program);
+    CHECK_EQUAL(MJava::countNodes(program), tree.size());
+}
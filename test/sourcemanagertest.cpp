@@ -0,0 +1,126 @@
+// THIS FILE IS PART OF MJava-Compiler PROJECT
+// sourcemanagertest.cpp - file references and locations after the scanner
+
+// Created by Li Taiji 2026-10-18
+// Copyright (c) 2026 Li Taiji All rights reserved
+
+#include "diagnostic.h"
+#include "parser.h"
+#include "scanner.h"
+#include "sourcemanager.h"
+#include "test.h"
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace
+{
+    const std::string PROGRAM =
+        "class Main {\n"
+        "    public static void main(String[] a) {\n"
+        "        System.out.println(1);\n"
+        "    }\n"
+        "}\n"
+        "class A {\n"
+        "    int x;\n"
+        "}\n";
+}
+
+TEST(SourceManagerLocationsOutliveScanner)
+{
+    std::unique_ptr<MJava::Scanner> scanner(new MJava::Scanner("a.java", PROGRAM));
+    MJava::TokenBuffer tokens = scanner->tokenizeAll();
+    MJava::Parser parser(tokens);
+    parser.parse();
+
+    // "x" of class A.
+    MJava::TokenLocation loc(tokens.getFileID(), static_cast<std::uint32_t>(PROGRAM.find("x;")));
+    CHECK_EQUAL(std::string("a.java:7:9:"), loc.toString());
+
+    scanner.reset();
+    CHECK_EQUAL(std::string("a.java:7:9:"), loc.toString());
+}
+
+TEST(SourceManagerReusesFileIds)
+{
+    MJava::FileID fileId = 0;
+
+    {
+        MJava::Scanner scanner("a.java", PROGRAM);
+        fileId = scanner.getFileID();
+    }
+
+    MJava::Scanner scanner("b.java", PROGRAM);
+    CHECK_EQUAL(fileId, scanner.getFileID());
+    CHECK_EQUAL(std::string("b.java"), MJava::SourceManager::instance().getFileName(fileId));
+}
+
+TEST(SourceManagerEndOfFileInString)
+{
+    // like the first scanner, the end of the file is found at the last char.
+    const std::string source = "a \"bc";
+    MJava::DiagnosticEngine diagnostics("s.java", MJava::DiagnosticEngine::Options());
+    MJava::DiagnosticScope scope(diagnostics);
+    MJava::Scanner scanner("s.java", source);
+    MJava::TokenBuffer tokens = scanner.tokenizeAll();
+
+    CHECK_EQUAL(std::size_t(2), tokens.size());
+    CHECK_EQUAL(std::string("s.java:1:5:"), tokens.at(1).getTokenLocation().toString());
+    CHECK_EQUAL(std::size_t(1), diagnostics.getCount());
+
+    if (diagnostics.getCount() == 1)
+    {
+        CHECK_EQUAL(5, diagnostics.getDiagnostics()[0].column);
+    }
+}
+
+TEST(SourceManagerConcurrentLookups)
+{
+    MJava::SourceManager& manager = MJava::SourceManager::instance();
+    MJava::FileID fileId = manager.addFile("c.java", PROGRAM.data(), PROGRAM.size());
+    // "int x;" is on line 7, 5 chars after the start of the line.
+    const std::uint32_t offset = static_cast<std::uint32_t>(PROGRAM.find("int x"));
+    std::vector<int> wrong(4, 0);
+    std::vector<std::thread> threads;
+
+    // the first lookups race to build the index, the later ones only read it.
+    for (std::size_t i = 0; i < wrong.size(); ++i)
+    {
+        threads.emplace_back([&manager, &wrong, fileId, offset, i]()
+        {
+            for (int n = 0; n < 10000; ++n)
+            {
+                int line = 0;
+                int column = 0;
+                manager.getLineAndColumn(fileId, offset, line, column);
+
+                if (line != 7 || column != 5 || manager.getFileName(fileId) != "c.java")
+                {
+                    ++wrong[i];
+                }
+            }
+        });
+    }
+
+    for (std::thread& thread : threads)
+    {
+        thread.join();
+    }
+
+    for (int count : wrong)
+    {
+        CHECK_EQUAL(0, count);
+    }
+
+    // a changed text is indexed again.
+    const std::string text = "\n\nint x;";
+    manager.updateFile(fileId, text.data(), text.size());
+    int line = 0;
+    int column = 0;
+    manager.getLineAndColumn(fileId, 2, line, column);
+    CHECK_EQUAL(3, line);
+    CHECK_EQUAL(1, column);
+
+    manager.removeFile(fileId);
+}
@@ -0,0 +1,52 @@
+// THIS FILE IS PART OF MJava-Compiler PROJECT
+// test.h - a very small test harness
+
+// Created by Li Taiji 2026-10-18
+// Copyright (c) 2026 Li Taiji All rights reserved
+
+#ifndef TEST_H_
+#define TEST_H_
+
+#include <iostream>
+#include <string>
+
+namespace MJavaTest
+{
+    using TestFunction = void (*)();
+
+    // a test registers itself before main() runs, see TEST.
+    struct TestRegistration
+    {
+        TestRegistration(const char* name, TestFunction function);
+    };
+
+    // report a failed check, the test goes on.
+    void fail(const char* file, int line, const std::string& message);
+} // namespace MJavaTest
+
+#define TEST(name)                                                              \
+    static void name();                                                         \
+    static const MJavaTest::TestRegistration name##Registration(#name, &name);  \
+    static void name()
+
+#define CHECK(condition)                                                        \
+    do                                                                          \
+    {                                                                           \
+        if (!(condition))                                                       \
+        {                                                                       \
+            MJavaTest::fail(__FILE__, __LINE__, #condition);                    \
+        }                                                                       \
+    } while (false)
+
+#define CHECK_EQUAL(expected, actual)                                           \
+    do                                                                          \
+    {                                                                           \
+        const auto& expectedValue = (expected);                                 \
+        const auto& actualValue = (actual);                                     \
+        if (!(expectedValue == actualValue))                                    \
+        {                                                                       \
+            MJavaTest::fail(__FILE__, __LINE__, #actual " is not " #expected);  \
+        }                                                                       \
+    } while (false)
+
+#endif // test.h
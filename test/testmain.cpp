@@ -0,0 +1,68 @@
+// THIS FILE IS PART OF MJava-Compiler PROJECT
+// testmain.cpp - run the tests whose names start with the arguments
+
+// Created by Li Taiji 2026-10-18
+// Copyright (c) 2026 Li Taiji All rights reserved
+
+#include "test.h"
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+namespace MJavaTest
+{
+    namespace
+    {
+        std::vector<std::pair<std::string, TestFunction>>& getTests()
+        {
+            static std::vector<std::pair<std::string, TestFunction>> tests;
+            return tests;
+        }
+
+        std::size_t failures = 0;
+    } // namespace
+
+    TestRegistration::TestRegistration(const char* name, TestFunction function)
+    {
+        getTests().emplace_back(name, function);
+    }
+
+    void fail(const char* file, int line, const std::string& message)
+    {
+        std::cerr << file << ":" << line << ": check failed: " << message << std::endl;
+        ++failures;
+    }
+} // namespace MJavaTest
+
+// CompilerTest [Prefix]...
+// without prefix every test is run. the exit code is 1 if a check has failed.
+int main(int argc, char** argv)
+{
+    std::size_t run = 0;
+
+    for (const auto& test : MJavaTest::getTests())
+    {
+        bool selected = argc < 2;
+
+        for (int i = 1; i < argc && !selected; i++)
+        {
+            selected = test.first.compare(0, std::string(argv[i]).size(), argv[i]) == 0;
+        }
+
+        if (selected)
+        {
+            std::size_t before = MJavaTest::failures;
+            test.second();
+            std::cout << (MJavaTest::failures == before ? "passed: " : "FAILED: ") << test.first << std::endl;
+            ++run;
+        }
+    }
+
+    if (run == 0)
+    {
+        std::cerr << "No test is selected!" << std::endl;
+        return 1;
+    }
+
+    return MJavaTest::failures == 0 ? 0 : 1;
+}